@@ -0,0 +1,173 @@
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+
+#include <getopt.h>
+#include <unistd.h>
+
+#include "amqp/codec/Decoder.h"
+#include "amqp/codec/Payload.h"
+#include "amqp/codec/BlobFile.h"
+
+#include "amqp/SchemaCache.h"
+#include "amqp/columns/Columns.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace columns = amqp::internal::columns;
+
+    void
+    usage (const char * name_) {
+        std::cerr
+            << "usage: " << name_ << " [-c] -o output [file|directory]..." << std::endl
+            << std::endl
+            << "  -c  write CSV rather than the binary column format, output" << std::endl
+            << "      is then a directory holding rows.csv, a row per blob," << std::endl
+            << "      and a file per list named after it" << std::endl
+            << "  -o  where to write the columns" << std::endl
+            << std::endl
+            << "  Reads blobs that all hold the same type into columns, one" << std::endl
+            << "  per field, a row per blob in the order given (directories" << std::endl
+            << "  sorted by name). Blobs that fail to decode, or hold some" << std::endl
+            << "  other type, are reported and left out." << std::endl;
+    }
+
+    /**
+     * The columns are laid out from the first blob's schema, every blob
+     * after it has to hold the same type
+     */
+    void
+    append (
+        const std::string & path_,
+        amqp::internal::SchemaCache & cache_,
+        std::string & type_,
+        std::unique_ptr<columns::Columns> & columns_
+    ) {
+        amqp::codec::BlobFile blob (path_);
+        amqp::codec::Payload payload (blob.data(), blob.size());
+
+        amqp::codec::Decoder decoder (payload.data(), payload.size());
+        amqp::codec::Decoder * d = &decoder;
+
+        std::string descriptor;
+        const auto & entry = cache_.lookup (d, descriptor);
+
+        if (!columns_) {
+            columns_ = std::make_unique<columns::Columns> (entry.schema(), descriptor);
+            type_ = descriptor;
+        } else if (descriptor != type_) {
+            throw std::runtime_error ("Holds " + descriptor + " rather than " + type_);
+        }
+
+        amqp::codec::auto_enter p (d);
+        d->next();
+        amqp::codec::auto_enter p2 (d);
+
+        try {
+            entry.reader (descriptor).visit (d, entry.schema(), *columns_);
+        } catch (...) {
+            columns_->rollback();
+            throw;
+        }
+    }
+
+    std::ofstream
+    open (const std::string & path_) {
+        std::ofstream out (path_, std::ios::binary);
+
+        if (!out) {
+            throw std::runtime_error ("Failed to open " + path_);
+        }
+
+        return out;
+    }
+
+    void
+    csv (const columns::Columns & columns_, const std::string & directory_) {
+        std::filesystem::create_directories (directory_);
+
+        {
+            auto out = open (directory_ + "/rows.csv");
+            columns_.csv (out);
+        }
+
+        const auto & all = columns_.columns();
+        for (size_t i { 0 } ; i < all.size() ; ++i) {
+            if (all[i].m_type == columns::ColumnType::Offsets) {
+                auto out = open (directory_ + "/" + all[i].m_name + ".csv");
+                columns_.csv (out, i);
+            }
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+int
+main (int argc, char **argv) {
+    bool csvOut { false };
+    std::string output;
+
+    int opt;
+    while ((opt = getopt (argc, argv, "co:h")) != -1) {
+        switch (opt) {
+            case 'c' : csvOut = true; break;
+            case 'o' : output = optarg; break;
+            default : {
+                usage (argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    std::vector<std::string> args (argv + optind, argv + argc);
+
+    if (output.empty() || args.empty()) {
+        usage (argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    amqp::internal::SchemaCache cache;
+    std::unique_ptr<columns::Columns> columns;
+    std::string type;
+    bool failed { false };
+
+    try {
+        for (const auto & path : amqp::codec::expand (args)) {
+            try {
+                append (path, cache, type, columns);
+            } catch (const std::exception & e) {
+                std::cerr << path << ": " << e.what() << std::endl;
+                failed = true;
+            }
+        }
+
+        if (!columns) {
+            std::cerr << "No blobs read" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (csvOut) {
+            csv (*columns, output);
+        } else {
+            auto out = open (output);
+            columns->write (out);
+        }
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cerr << columns->rows() << " rows of " << type << ", "
+              << columns->columns().size() << " columns" << std::endl;
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/******************************************************************************/
@@ -0,0 +1,119 @@
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+
+#include <unistd.h>
+
+#include "serialiser/Generator.h"
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    usage (const char * name_) {
+        std::cerr
+            << "usage: " << name_ << " [-f fields] [-d depth] [-n length] [-s percent] [-e percent]" << std::endl
+            << "       [-l length] [-k constants] [-t types] [-r seed] [-c count] [file|directory]" << std::endl
+            << std::endl
+            << "  -f  fields per composite (8)" << std::endl
+            << "  -d  composites nested in each list element (1)" << std::endl
+            << "  -n  elements in the list each blob holds (1000)" << std::endl
+            << "  -s  percentage of fields that are strings (25)" << std::endl
+            << "  -e  percentage of fields that are enums (10)" << std::endl
+            << "  -l  length of each string (16)" << std::endl
+            << "  -k  constants in the enum (8)" << std::endl
+            << "  -t  pad the schema out to this many types (0)" << std::endl
+            << "  -r  seed, the same seed and shape make the same blobs (1)" << std::endl
+            << "  -c  blobs to write (1)" << std::endl
+            << std::endl
+            << "  Writes a single blob to the file given, or stdout if there" << std::endl
+            << "  isn't one. With -c writes that many blobs, all sharing a" << std::endl
+            << "  schema, into the directory given." << std::endl;
+    }
+
+    void
+    save (const std::string & path_, const std::vector<char> & blob_) {
+        std::ofstream out (path_, std::ios::binary);
+
+        if (!out.write (blob_.data(), static_cast<std::streamsize> (blob_.size()))) {
+            throw std::runtime_error ("Failed to write " + path_);
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+int
+main (int argc, char **argv) {
+    amqp::internal::serialiser::Shape shape;
+    size_t count { 1 };
+
+    int opt;
+    while ((opt = getopt (argc, argv, "f:d:n:s:e:l:k:t:r:c:h")) != -1) {
+        switch (opt) {
+            case 'f' : shape.m_fields = std::strtoul (optarg, nullptr, 10); break;
+            case 'd' : shape.m_depth = std::strtoul (optarg, nullptr, 10); break;
+            case 'n' : shape.m_length = std::strtoul (optarg, nullptr, 10); break;
+            case 's' : shape.m_strings = std::strtoul (optarg, nullptr, 10); break;
+            case 'e' : shape.m_enums = std::strtoul (optarg, nullptr, 10); break;
+            case 'l' : shape.m_stringLength = std::strtoul (optarg, nullptr, 10); break;
+            case 'k' : shape.m_constants = std::strtoul (optarg, nullptr, 10); break;
+            case 't' : shape.m_types = std::strtoul (optarg, nullptr, 10); break;
+            case 'r' : shape.m_seed = std::strtoul (optarg, nullptr, 10); break;
+            case 'c' : count = std::strtoul (optarg, nullptr, 10); break;
+            default : {
+                usage (argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    std::vector<std::string> args (argv + optind, argv + argc);
+
+    if (args.size() > 1 || (count != 1 && args.empty())) {
+        usage (argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        amqp::internal::serialiser::Generator generator (shape);
+        std::vector<char> blob;
+
+        if (count == 1) {
+            generator.write (blob);
+
+            if (args.empty()) {
+                std::cout.write (blob.data(), static_cast<std::streamsize> (blob.size()));
+                std::cout.flush();
+            } else {
+                save (args[0], blob);
+            }
+
+            return EXIT_SUCCESS;
+        }
+
+        std::filesystem::create_directories (args[0]);
+
+        for (size_t i { 0 } ; i < count ; ++i) {
+            std::stringstream name;
+            name << "blob-" << std::setw (6) << std::setfill ('0') << i;
+
+            generator.write (blob);
+            save ((std::filesystem::path (args[0]) / name.str()).string(), blob);
+        }
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************/
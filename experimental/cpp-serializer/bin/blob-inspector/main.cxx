@@ -1,114 +1,438 @@
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sstream>
 #include <iostream>
 #include <iomanip>
-#include <fstream>
+#include <memory>
 #include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <algorithm>
+#include <filesystem>
+#include <condition_variable>
 
-#include <assert.h>
-#include <string.h>
-#include <proton/types.h>
-#include <proton/codec.h>
-#include <sys/stat.h>
+#include <getopt.h>
+#include <unistd.h>
 
 #import "debug.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/codec/Payload.h"
+#include "amqp/codec/BlobFile.h"
 
-#include "amqp/AMQPHeader.h"
-#include "amqp/AMQPSectionId.h"
 #include "amqp/descriptors/AMQPDescriptorRegistory.h"
 
-#include "amqp/schema/Envelope.h"
+#include "amqp/SchemaCache.h"
 #include "amqp/CompositeFactory.h"
+#include "amqp/reader/JsonVisitor.h"
+#include "amqp/plan/DecodePlan.h"
+#include "amqp/plan/Projection.h"
+#include "amqp/stats/Stats.h"
 
 /******************************************************************************/
 
+namespace {
+
+    struct Options {
+        unsigned int             m_threads;
+        bool                     m_compiled;
+        bool                     m_reachable;
+        bool                     m_stats;
+        std::vector<std::string> m_fields;
+        std::vector<std::string> m_paths;
+
+        amqp::internal::plan::Projection m_projection;
+    };
+
+    void
+    usage (const char * name_) {
+        std::cerr
+            << "usage: " << name_ << " [-c] [-l] [-p field]... [-j threads] [--stats] [file|directory]..." << std::endl
+            << std::endl
+            << "  -c  decode using a compiled plan rather than the reader graph" << std::endl
+            << "  -l  only decode the parts of each schema a blob uses" << std::endl
+            << "  -p  only decode the given dotted field path, can be repeated," << std::endl
+            << "      implies -c" << std::endl
+            << "  -j  how many blobs to decode at once when there are several," << std::endl
+            << "      defaults to the number of hardware threads. Ignored for a" << std::endl
+            << "      single file, several files are decoded in parallel just" << std::endl
+            << "      as a directory's are" << std::endl
+            << "  --stats  write the time spent in each phase of decoding and" << std::endl
+            << "      how much was decoded to stderr, per blob and in total" << std::endl
+            << std::endl
+            << "  With a single file decodes it and writes it as JSON, with" << std::endl
+            << "  several, or a directory, writes one line per blob in the" << std::endl
+            << "  order given (directories sorted by name). Reads stdin if" << std::endl
+            << "  there are no files." << std::endl;
+    }
+
+    amqp::internal::SchemaCache::Materialise
+    materialise (const Options & options_) {
+        return options_.m_reachable
+            ? amqp::internal::SchemaCache::Materialise::Reachable
+            : amqp::internal::SchemaCache::Materialise::All;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * With [d_] positioned on a blob's envelope decode the object in it into
+ * [visitor_], through [plan_] if we have one or the reader graph if not
+ */
 void
-data_and_stop(std::ifstream & f_, ssize_t sz) {
-    char * blob = new char[sz];
-    memset (blob, 0, sz);
-    f_.read(blob, sz);
+data_and_stop(
+    amqp::codec::Decoder * d_,
+    const amqp::internal::SchemaCache::Entry & entry_,
+    const std::string & descriptor_,
+    const amqp::internal::plan::DecodePlan * plan_,
+    amqp::reader::IVisitor & visitor_
+) {
+    namespace stats = amqp::internal::stats;
 
-    pn_data_t * d = pn_data(sz);
+    const auto & reader = entry_.reader (descriptor_);
 
-    // returns how many bytes we processed which right now we don't care
-    // about but I assume there is a case where it doesn't process the
-    // entire file
-    auto rtn = pn_data_decode (d, blob, sz);
-    assert (rtn == sz);
+    DBG (std::endl << "Types in schema: " << std::endl
+        << entry_.schema() << std::endl); // NOLINT
 
-    std::unique_ptr<amqp::internal::schema::Envelope> envelope;
+    {
+        // move to the actual blob entry in the tree
+        amqp::codec::auto_enter p (d_);
+        d_->next();
+        amqp::codec::is_list (d_);
 
-    if (pn_data_is_described(d)) {
-        proton::auto_enter p (d);
+        // the object, its schema and the transforms schema
+        if (d_->getList() != 3) {
+            throw std::runtime_error (
+                "Malformed envelope, holds " + std::to_string (d_->getList())
+                + " entries rather than 3");
+        }
 
-        auto a = pn_data_get_ulong(d);
+        {
+            amqp::codec::auto_enter p (d_);
 
-        envelope.reset (
-            dynamic_cast<amqp::internal::schema::Envelope *> (
-                amqp::AMQPDescriptorRegistory[a]->build(d).release()));
+            // Values are written as they are decoded rather than
+            // building up the whole tree first
+            stats::Timer timer (stats::Decode);
 
-        DBG (std::endl << "Types in schema: " << std::endl
-            << *envelope << std::endl); // NOLINT
+            if (plan_) {
+                plan_->run (d_, visitor_);
+            } else {
+                reader.visit (d_, entry_.schema(), visitor_);
+            }
+        }
     }
+}
 
-    amqp::internal::CompositeFactory cf;
+/******************************************************************************/
 
-    cf.process (envelope->schema());
+/**
+ * Decode one blob file and write it out as a single line of JSON, when
+ * [named_] is set the file's name is included alongside it. With --stats
+ * what it took is recorded into [stats_]
+ */
+void
+inspect (
+    const std::string & path_,
+    amqp::internal::SchemaCache & cache_,
+    std::ostream & out_,
+    bool named_,
+    const Options & options_,
+    amqp::internal::stats::Stats & stats_
+) {
+    namespace stats = amqp::internal::stats;
 
-    auto reader = cf.byDescriptor (envelope->descriptor());
-    assert (reader);
+    std::optional<stats::Scope> scope;
+    if (options_.m_stats) {
+        scope.emplace (stats_);
+    }
 
-    {
-        // move to the actual blob entry in the tree - ideally we'd have
-        // saved this on the Envelope but that's not easily doable as we
-        // can't grab an actual copy of our data pointer
-        proton::auto_enter p (d);
-        pn_data_next (d);
-        proton::is_list (d);
-        assert (pn_data_get_list (d) == 3);
+    // the whole file, mapped if we can, read in if we're being piped to
+    auto blob = [&]() {
+        stats::Timer timer (stats::Read);
+        return amqp::codec::BlobFile (path_);
+    }();
+
+    // the AMQP data in it, inflated if it was compressed
+    auto payload = [&]() {
+        stats::Timer timer (stats::Inflate);
+        return amqp::codec::Payload (blob.data(), blob.size());
+    }();
+
+    stats_.add (stats::Blobs);
+    stats_.add (stats::Bytes, payload.size());
+
+    // walk the blob in place rather than decoding it into a tree first
+    amqp::codec::Decoder decoder (payload.data(), payload.size());
+
+    // blobs sharing a schema share the readers built for it
+    std::string descriptor;
+    const auto & entry = cache_.lookup (&decoder, descriptor);
+
+    // a projection naming fields the schema doesn't have fails here,
+    // before anything's been written
+    const amqp::internal::plan::DecodePlan * plan { nullptr };
+    if (!options_.m_fields.empty()) {
+        plan = &entry.plan (descriptor, options_.m_projection);
+    } else if (options_.m_compiled) {
+        plan = &entry.plan (descriptor);
+    }
+
+    // We wrap our output like this to make sure it's valid JSON to
+    // facilitate easy pretty printing
+    amqp::internal::reader::JsonVisitor visitor (out_);
+
+    visitor.beginComposite ("");
+    if (named_) {
+        visitor.field ("File");
+        visitor.onString (path_);
+    }
+    visitor.field ("Parsed");
+
+    if (options_.m_stats) {
+        stats::CountingVisitor counting (visitor, stats_);
+        data_and_stop (&decoder, entry, descriptor, plan, counting);
+    } else {
+        data_and_stop (&decoder, entry, descriptor, plan, visitor);
+    }
+
+    visitor.endComposite();
+    visitor.flush();
+
+    out_ << '\n';
+}
+
+/******************************************************************************/
+
+/**
+ * What's written in place of a blob that couldn't be decoded, again a
+ * single line of JSON
+ */
+void
+error (
+    const std::string & path_,
+    const std::string & what_,
+    std::ostream & out_,
+    bool named_
+) {
+    amqp::internal::reader::JsonVisitor visitor (out_);
+
+    visitor.beginComposite ("");
+    if (named_) {
+        visitor.field ("File");
+        visitor.onString (path_);
+    }
+    visitor.field ("Error");
+    visitor.onString (what_);
+    visitor.endComposite();
+    visitor.flush();
+
+    out_ << '\n';
+}
+
+/******************************************************************************/
+
+/**
+ * Decode many files at once on a pool of workers sharing one schema cache.
+ *
+ * Each worker renders its blob to a string of its own and the main thread
+ * writes them out strictly in the order they were given. To stop a slow
+ * blob leaving everything after it sat in memory workers never get more
+ * than a few blobs ahead of what's been written.
+ *
+ * A blob that fails to decode is reported in its place in the output and
+ * doesn't stop the others.
+ */
+int
+batch (const Options & options_, unsigned int threads_) {
+    const auto & paths = options_.m_paths;
+
+    amqp::internal::SchemaCache cache (materialise (options_));
+
+    const size_t window = 4 * threads_;
+
+    std::mutex lock;
+    std::condition_variable cv;
+
+    std::vector<std::string> results (paths.size());
+    std::vector<amqp::internal::stats::Stats> stats (paths.size());
+    amqp::internal::stats::Stats total;
+    std::vector<char> done (paths.size(), false);
+    size_t next { 0 };
+    size_t written { 0 };
+    bool failed { false };
+
+    auto worker = [&]() {
+        for (;;) {
+            size_t i;
+            {
+                std::unique_lock<std::mutex> l (lock);
+                cv.wait (l, [&]() {
+                    return next == paths.size() || next < written + window;
+                });
+
+                if (next == paths.size()) {
+                    return;
+                }
+
+                i = next++;
+            }
+
+            std::stringstream out;
+            bool ok { true };
+
+            try {
+                inspect (paths[i], cache, out, true, options_, stats[i]);
+            } catch (const std::exception & e) {
+                out.str ("");
+                ok = false;
+
+                error (paths[i], e.what(), out, true);
+            }
+
+            {
+                std::lock_guard<std::mutex> l (lock);
+                results[i] = out.str();
+                done[i] = true;
+                failed |= !ok;
+            }
+
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int i { 0 } ; i < threads_ ; ++i) {
+        workers.emplace_back (worker);
+    }
+
+    for (size_t i { 0 } ; i < paths.size() ; ++i) {
+        std::string result;
         {
-            proton::auto_enter p (d);
+            std::unique_lock<std::mutex> l (lock);
+            cv.wait (l, [&]() { return done[i]; });
 
-            // We wrap our output like this to make sure it's valid JSON to
-            // facilitate easy pretty printing
-            std::cout
-                << reader->dump ("{ Parsed", d, envelope->schema())->dump()
-                << " }" << std::endl;
+            result.swap (results[i]);
+            written = i + 1;
         }
+
+        cv.notify_all();
+        std::cout << result;
+
+        if (options_.m_stats) {
+            stats[i].write (std::cerr, paths[i]);
+            total += stats[i];
+        }
+    }
+
+    for (auto & w : workers) {
+        w.join();
     }
+
+    std::cout.flush();
+
+    if (options_.m_stats) {
+        total.write (std::cerr, "total");
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
 /******************************************************************************/
 
 int
 main (int argc, char **argv) {
-    struct stat results { };
+    Options options {
+        std::max (1U, std::thread::hardware_concurrency()),
+        false,
+        false,
+        false,
+        { },
+        { },
+        { }
+    };
 
-    if (stat(argv[1], &results) != 0) {
-        return EXIT_FAILURE;
+    const option longOptions[] = {
+        { "stats", no_argument, nullptr, 's' },
+        { nullptr, 0, nullptr, 0 }
+    };
+
+    int opt;
+    while ((opt = getopt_long (argc, argv, "clp:j:h", longOptions, nullptr)) != -1) {
+        switch (opt) {
+            case 'c' : {
+                options.m_compiled = true;
+                break;
+            }
+            case 'l' : {
+                options.m_reachable = true;
+                break;
+            }
+            case 'p' : {
+                options.m_fields.emplace_back (optarg);
+                break;
+            }
+            case 'j' : {
+                options.m_threads = std::max (1, atoi (optarg));
+                break;
+            }
+            case 's' : {
+                options.m_stats = true;
+                break;
+            }
+            default : {
+                usage (argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
     }
 
-    std::ifstream f (argv[1], std::ios::in | std::ios::binary);
-    std::array<char, 7> header { };
-    f.read(header.data(), 7);
+    std::vector<std::string> args (argv + optind, argv + argc);
+    bool single = args.size() <= 1
+        && (args.empty() || !std::filesystem::is_directory (args[0]));
 
-    if (header != amqp::AMQP_HEADER) {
-        std::cerr << "Bad Header in blob" << std::endl;
+    if (args.empty()) {
+        args.emplace_back ("-");
+    }
+
+    try {
+        options.m_paths = amqp::codec::expand (args);
+        options.m_projection = amqp::internal::plan::Projection (options.m_fields);
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
         return EXIT_FAILURE;
     }
 
-    amqp::amqp_section_id_t encoding;
-    f.read((char *)&encoding, 1);
+    if (!single) {
+        return batch (
+                options,
+                std::min<size_t> (options.m_threads, options.m_paths.size()));
+    }
+
+    amqp::internal::SchemaCache cache (materialise (options));
+    amqp::internal::stats::Stats stats;
 
-    if (encoding == amqp::DATA_AND_STOP) {
-        data_and_stop(f, results.st_size - 8);
-    } else {
-        std::cerr << "BAD ENCODING " << encoding << " != "
-            << amqp::DATA_AND_STOP << std::endl;
+    // rendered in full before any of it's written so a blob that fails
+    // part way through doesn't leave half an object on stdout
+    std::stringstream out;
 
+    try {
+        inspect (options.m_paths[0], cache, out, false, options, stats);
+    } catch (const std::exception & e) {
+        error (options.m_paths[0], e.what(), std::cout, false);
         return EXIT_FAILURE;
     }
 
+    std::cout << out.rdbuf();
+
+    if (options.m_stats) {
+        std::cout.flush();
+        stats.write (std::cerr, options.m_paths[0]);
+    }
+
     return EXIT_SUCCESS;
 }
 
@@ -1,34 +1,37 @@
 #include <iostream>
 #include <iomanip>
-#include <fstream>
+#include <memory>
 #include <cstddef>
+#include <algorithm>
+
+#include <string>
+#include <vector>
+#include <optional>
 
 #include <assert.h>
-#include <string.h>
-#include <proton/types.h>
-#include <proton/codec.h>
-#include <sys/stat.h>
+#include <getopt.h>
 #include <sstream>
 
 #import "debug.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/codec/Payload.h"
+#include "amqp/codec/BlobFile.h"
 
-#include "amqp/AMQPHeader.h"
-#include "amqp/AMQPSectionId.h"
 #include "amqp/descriptors/AMQPDescriptorRegistory.h"
 
 #include "amqp/schema/Envelope.h"
 #include "amqp/CompositeFactory.h"
+#include "amqp/stats/Stats.h"
 
 /******************************************************************************/
 
 void
-printNode (pn_data_t * d_) {
+printNode (amqp::codec::Decoder * d_) {
     std::stringstream ss;
 
-    if (pn_data_is_described (d_)) {
-        amqp::AMQPDescriptorRegistory[22UL]->read (d_, ss);
+    if (d_->isDescribed()) {
+        amqp::describedDescriptor().read (d_, ss);
     }
 
     std::cout << ss.str() << std::endl;
@@ -38,52 +41,101 @@ printNode (pn_data_t * d_) {
 /******************************************************************************/
 
 void
-data_and_stop(std::ifstream & f_, ssize_t sz) {
-    char * blob = new char[sz];
-    memset (blob, 0, sz);
-    f_.read(blob, sz);
+data_and_stop(const char * blob_, size_t sz) {
+    // walk the blob in place rather than decoding it into a tree first
+    amqp::codec::Decoder decoder (blob_, sz);
+    amqp::codec::Decoder * d = &decoder;
 
-    pn_data_t * d = pn_data(sz);
+    printNode (d);
 
-    // returns how many bytes we processed which right now we don't care
-    // about but I assume there is a case where it doesn't process the
-    // entire file
-    auto rtn = pn_data_decode (d, blob, sz);
-    assert (rtn == sz);
+}
 
-    printNode (d);
+/******************************************************************************/
+
+/**
+ * Dump one blob file, with --stats recording what it took into [stats_]
+ */
+void
+dump (const std::string & path_, bool stats_, amqp::internal::stats::Stats & into_) {
+    namespace stats = amqp::internal::stats;
+
+    std::optional<stats::Scope> scope;
+    if (stats_) {
+        scope.emplace (into_);
+    }
+
+    // the whole file, mapped if we can, read in if we're being piped to
+    auto blob = [&]() {
+        stats::Timer timer (stats::Read);
+        return amqp::codec::BlobFile (path_);
+    }();
+
+    // the AMQP data in it, inflated if it was compressed
+    auto payload = [&]() {
+        stats::Timer timer (stats::Inflate);
+        return amqp::codec::Payload (blob.data(), blob.size());
+    }();
+
+    into_.add (stats::Blobs);
+    into_.add (stats::Bytes, payload.size());
 
+    stats::Timer timer (stats::Dump);
+    data_and_stop (payload.data(), payload.size());
 }
 
 /******************************************************************************/
 
+/**
+ *  schema-dumper [--stats] [file]...
+ *
+ * Reads stdin if there are no files
+ */
 int
 main (int argc, char **argv) {
-    struct stat results { };
-
-    if (stat(argv[1], &results) != 0) {
-        return EXIT_FAILURE;
+    const option longOptions[] = {
+        { "stats", no_argument, nullptr, 's' },
+        { nullptr, 0, nullptr, 0 }
+    };
+
+    bool stats { false };
+
+    int opt;
+    while ((opt = getopt_long (argc, argv, "h", longOptions, nullptr)) != -1) {
+        if (opt == 's') {
+            stats = true;
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--stats] [file]..." << std::endl;
+            return EXIT_FAILURE;
+        }
     }
 
-    std::ifstream f (argv[1], std::ios::in | std::ios::binary);
-    std::array<char, 7> header { };
-    f.read(header.data(), 7);
+    std::vector<std::string> paths (argv + optind, argv + argc);
 
-    if (header != amqp::AMQP_HEADER) {
-        std::cerr << "Bad Header in blob" << std::endl;
-        return EXIT_FAILURE;
+    if (paths.empty()) {
+        paths.emplace_back ("-");
     }
 
-    amqp::amqp_section_id_t encoding;
-    f.read((char *)&encoding, 1);
+    amqp::internal::stats::Stats total;
+
+    for (const auto & path : paths) {
+        amqp::internal::stats::Stats blob;
 
-    if (encoding == amqp::DATA_AND_STOP) {
-        data_and_stop(f, results.st_size - 8);
-    } else {
-        std::cerr << "BAD ENCODING " << encoding << " != "
-            << amqp::DATA_AND_STOP << std::endl;
+        try {
+            dump (path, stats, blob);
+        } catch (const std::runtime_error & e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (stats) {
+            std::cout.flush();
+            blob.write (std::cerr, path);
+            total += blob;
+        }
+    }
 
-        return EXIT_FAILURE;
+    if (stats && paths.size() > 1) {
+        total.write (std::cerr, "total");
     }
 
     return EXIT_SUCCESS;
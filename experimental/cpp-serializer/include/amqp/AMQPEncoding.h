@@ -2,18 +2,18 @@
 
 /******************************************************************************/
 
-namespace amqp {
-namespace internal {
-namespace serialiser {
+/*
+ * How everything after an ENCODING section is encoded, given by the
+ * byte that follows the section id
+ */
 
-    template <typename T>
-    class Composite : public ProtonReader<T> {
+namespace amqp {
 
+    enum amqp_encoding_t {
+        DEFLATE = 0,
+        SNAPPY  = 1
     };
 
 }
-}
-}
 
 /******************************************************************************/
-
@@ -23,8 +23,12 @@ namespace amqp {
 
             virtual void process (const SchemaType &) = 0;
 
-            virtual const std::shared_ptr<ReaderType> byType (const std::string &) = 0;
-            virtual const std::shared_ptr<ReaderType> byDescriptor (const std::string &) = 0;
+            /**
+             * Readers belong to the factory, they're valid for as long
+             * as it is
+             */
+            virtual const ReaderType * byType (const std::string &) const = 0;
+            virtual const ReaderType * byDescriptor (const std::string &) const = 0;
     };
 
 }
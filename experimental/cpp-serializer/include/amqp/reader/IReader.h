@@ -5,6 +5,7 @@
 #include <any>
 
 #include "amqp/AMQPDescribed.h"
+#include "amqp/reader/IVisitor.h"
 
 #include "amqp/schema/Schema.h"
 
@@ -14,7 +15,9 @@
  *
  ******************************************************************************/
 
-struct pn_data_t;
+namespace amqp::codec {
+    class Decoder;
+}
 
 /******************************************************************************
  *
@@ -56,18 +59,27 @@ namespace amqp::reader {
             virtual const std::string & name() const = 0;
             virtual const std::string & type() const = 0;
 
-            virtual std::any read (pn_data_t *) const = 0;
-            virtual std::string readString (pn_data_t *) const = 0;
+            virtual std::any read (codec::Decoder *) const = 0;
+            virtual std::string readString (codec::Decoder *) const = 0;
 
             virtual std::unique_ptr<IValue> dump(
                     const std::string &,
-                    pn_data_t *,
+                    codec::Decoder *,
                     const SchemaType &) const = 0;
 
             virtual std::unique_ptr<IValue> dump(
-                    pn_data_t *,
+                    codec::Decoder *,
                     const SchemaType &) const = 0;
 
+            /**
+             * Read the value at the current position, and move past it,
+             * handing it to the visitor as we go rather than building
+             * up an IValue to represent it
+             */
+            virtual void visit (
+                    codec::Decoder *,
+                    const SchemaType &,
+                    IVisitor &) const = 0;
     };
 
 }
@@ -0,0 +1,56 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * class amqp::reader::IVisitor
+ *
+ ******************************************************************************/
+
+/**
+ * The streaming alternative to building an IValue tree with dump. Readers
+ * call back into a visitor as they decode so whatever is consuming the
+ * blob sees each value as it's read and nothing needs to be held onto
+ * once the callback returns.
+ *
+ * Every property of a composite is announced by a call to field followed
+ * by exactly one value, which is either a scalar or a bracketed composite,
+ * list or map. Each entry of a map is its key followed by its value, the
+ * size a map starts with is the number of entries. Views passed to the
+ * callbacks point into the blob itself and are only valid for as long
+ * as it is.
+ */
+namespace amqp::reader {
+
+    class IVisitor {
+        public :
+            virtual ~IVisitor() = default;
+
+            virtual void beginComposite (const std::string & type_) = 0;
+            virtual void endComposite() = 0;
+
+            virtual void beginList (const std::string & type_, size_t size_) = 0;
+            virtual void endList() = 0;
+
+            virtual void beginMap (const std::string & type_, size_t size_) = 0;
+            virtual void endMap() = 0;
+
+            virtual void field (const std::string & name_) = 0;
+
+            virtual void onInt (int32_t) = 0;
+            virtual void onLong (int64_t) = 0;
+            virtual void onDouble (double) = 0;
+            virtual void onBool (bool) = 0;
+            virtual void onString (std::string_view) = 0;
+            virtual void onEnum (std::string_view) = 0;
+    };
+
+}
+
+/******************************************************************************/
@@ -2,14 +2,146 @@
 
 /******************************************************************************/
 
-namespace serialiser {
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "amqp/SchemaCache.h"
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/bind/Binding.h"
+#include "amqp/codec/Encoder.h"
+#include "amqp/descriptors/AMQPDescriptorRegistory.h"
+#include "amqp/schema/Schema.h"
+
+/******************************************************************************/
+
+/**
+ * Writes blobs the JVM can read, the header followed by an envelope
+ * holding the object and the schema describing it.
+ *
+ * The object is encoded straight into a buffer the caller hands us, by a
+ * bound struct, see bind::Binding, or through the visitor API, see
+ * serialiser::EncodingVisitor, nothing is built up in between. The buffer
+ * is cleared before each blob but keeps its capacity, so a producer
+ * reusing one soon stops allocating at all.
+ *
+ * The schema a blob carries only needs the types its object uses, that's
+ * encoded the first time a type is written and kept, keyed by the type's
+ * descriptor, so every blob after that copies it in as it is.
+ *
+ * Blobs can be written from any number of threads at once, each with
+ * its own buffer.
+ */
+namespace amqp::serialiser {
 
     class Serialiser {
+        public :
+            /**
+             * Whether a blob's schema holds just the types its object
+             * uses or every type we were given
+             */
+            enum class Types { Reachable, All };
+
+        private :
+            const internal::schema::Schema & m_schema;
+            const Types                      m_types;
+
+            /**
+             * When we've been built from a lazily materialising cache
+             * entry types are materialised through that before we
+             * encode them
+             */
+            const internal::SchemaCache::Entry * m_entry;
+
+            /**
+             * The encoded schema and transforms schema for blobs holding
+             * each type we've written
+             */
+            mutable std::map<std::string, std::string> m_sections;
+            mutable std::mutex m_lock;
+
+            const std::string & section (const std::string &) const;
+
+        public :
+            explicit Serialiser (
+                const internal::schema::Schema &,
+                Types types_ = Types::Reachable);
+
+            explicit Serialiser (const internal::SchemaCache::Entry &);
+
+            Serialiser (const Serialiser &) = delete;
+            Serialiser & operator = (const Serialiser &) = delete;
+
+            const internal::schema::Schema & schema() const;
+
+            /**
+             * Write a blob holding an object with [descriptor_] into
+             * [blob_], [write_] being handed the encoder to write the
+             * object itself with
+             */
+            template<typename Write>
+            void write (
+                const std::string & descriptor_,
+                std::vector<char> & blob_,
+                Write && write_) const;
 
+            template<typename T>
+            void write (
+                const internal::bind::Binding<T> &,
+                const T &,
+                std::vector<char> & blob_) const;
     };
 
 }
 
 /******************************************************************************/
 
+template<typename Write>
+void
+amqp::serialiser::
+Serialiser::write (
+    const std::string & descriptor_,
+    std::vector<char> & blob_,
+    Write && write_
+) const {
+    const auto & section = this->section (descriptor_);
 
+    blob_.clear();
+    blob_.insert (blob_.end(), AMQP_HEADER.begin(), AMQP_HEADER.end());
+    blob_.push_back (DATA_AND_STOP);
+
+    codec::Encoder encoder (blob_);
+
+    encoder.described();
+    encoder.putULong (internal::DESCRIPTOR_TOP_32BITS | internal::ENVELOPE);
+    encoder.beginList();
+
+    write_ (encoder);
+
+    encoder.putRaw (section, 2);
+    encoder.endList();
+
+    if (encoder.depth() != 0) {
+        throw std::runtime_error ("Object left unfinished writing " + descriptor_);
+    }
+}
+
+/******************************************************************************/
+
+template<typename T>
+void
+amqp::serialiser::
+Serialiser::write (
+    const internal::bind::Binding<T> & binding_,
+    const T & value_,
+    std::vector<char> & blob_
+) const {
+    write (binding_.descriptor(), blob_, [&] (codec::Encoder & encoder_) {
+        binding_.write (encoder_, value_);
+    });
+}
+
+/******************************************************************************/
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <algorithm>
 #include <functional>
+#include <stdexcept>
 
 #include <assert.h>
 
@@ -18,47 +19,11 @@
 #include "reader/RestrictedReader.h"
 #include "reader/restricted-readers/ListReader.h"
 #include "reader/restricted-readers/EnumReader.h"
+#include "reader/restricted-readers/MapReader.h"
 
 #include "schema/restricted-types/List.h"
 #include "schema/restricted-types/Enum.h"
-
-/******************************************************************************/
-
-namespace {
-
-/**
- *
- */
-    template<typename T>
-    std::shared_ptr<T> &
-    computeIfAbsent(
-            spStrMap_t<T> &map_,
-            const std::string &k_,
-            std::function<std::shared_ptr<T>(void)> f_
-    ) {
-        auto it = map_.find(k_);
-
-        if (it == map_.end()) {
-            DBG ("ComputeIfAbsent \"" << k_ << "\" - missing" << std::endl); // NOLINT
-            map_[k_] = std::move(f_());
-            DBG ("                \"" << k_ << "\" - RTN: " << map_[k_]->name() << " : " << map_[k_]->type()
-                                      << std::endl); // NOLINT
-            assert (map_[k_]);
-            assert (map_[k_] != nullptr);
-            assert (k_ == map_[k_]->type());
-
-            return map_[k_];
-        } else {
-            DBG ("ComputeIfAbsent \"" << k_ << "\" - found it" << std::endl); // NOLINT
-            DBG ("                \"" << k_ << "\" - RTN: " << map_[k_]->name() << std::endl); // NOLINT
-
-            assert (it->second != nullptr);
-
-            return it->second;
-        }
-    }
-
-}
+#include "schema/restricted-types/Map.h"
 
 /******************************************************************************
  *
@@ -82,22 +47,57 @@ CompositeFactory::process (const SchemaType & schema_) {
     for (const auto & i : dynamic_cast<const schema::Schema &>(schema_)) {
         for (const auto & j : i) {
             process(*j);
-            m_readersByDescriptor[j->descriptor()] = m_readersByType[j->name()];
+            m_readersByDescriptor[j->descriptorId()] = m_readersByType[j->id()];
         }
     }
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::Reader>
+/**
+ * Find the reader for [type_], building it with [f_] if we haven't yet
+ */
+amqp::internal::reader::Reader *
+amqp::internal::
+CompositeFactory::computeIfAbsent (
+        const schema::Symbol & type_,
+        const std::function<uPtr<reader::Reader>()> & f_
+) {
+    auto it = m_readersByType.find (type_);
+
+    if (it == m_readersByType.end()) {
+        DBG ("ComputeIfAbsent \"" << type_ << "\" - missing" << std::endl); // NOLINT
+
+        auto reader = f_();
+        assert (reader);
+        assert (type_.str() == reader->type());
+
+        m_readers.push_back (std::move (reader));
+        it = m_readersByType.emplace (type_, m_readers.back().get()).first;
+
+        DBG ("                \"" << type_ << "\" - RTN: " << it->second->name()
+                << " : " << it->second->type() << std::endl); // NOLINT
+    } else {
+        DBG ("ComputeIfAbsent \"" << type_ << "\" - found it" << std::endl); // NOLINT
+        DBG ("                \"" << type_ << "\" - RTN: " << it->second->name()
+                << std::endl); // NOLINT
+
+        assert (it->second != nullptr);
+    }
+
+    return it->second;
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::Reader *
 amqp::internal::
 CompositeFactory::process (
         const amqp::internal::schema::AMQPTypeNotation & schema_)
 {
-    return computeIfAbsent<reader::Reader> (
-        m_readersByType,
-        schema_.name(),
-        [& schema_, this] () -> std::shared_ptr<reader::Reader> {
+    return computeIfAbsent (
+        schema_.id(),
+        [& schema_, this] () -> uPtr<reader::Reader> {
             switch (schema_.type()) {
                 case amqp::internal::schema::AMQPTypeNotation::Composite : {
                     return processComposite (schema_);
@@ -106,108 +106,155 @@ CompositeFactory::process (
                     return processRestricted (schema_);
                 }
             }
+
+            throw std::runtime_error ("No reader for type " + schema_.name());
         });
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::Reader>
+uPtr<amqp::internal::reader::Reader>
 amqp::internal::
 CompositeFactory::processComposite (
         const amqp::internal::schema::AMQPTypeNotation & type_
 ) {
-    std::vector<std::weak_ptr<reader::Reader>> readers;
+    sVec<const reader::Reader *> readers;
+    std::vector<std::string> names;
 
     const auto & fields = dynamic_cast<const amqp::internal::schema::Composite &> (
             type_).fields();
 
     readers.reserve(fields.size());
+    names.reserve(fields.size());
 
     for (const auto & field : fields) {
         DBG ("  Field: " << field->name() << ": " << field->type() << std::endl); // NOLINT
 
+        names.push_back (field->name());
+
         switch (field->fieldType()) {
             case schema::FieldType::PrimitiveProperty : {
-                auto reader = computeIfAbsent<reader::Reader>(
-                        m_readersByType,
-                        field->type(),
-                        [&field]() -> std::shared_ptr<reader::PropertyReader> {
+                auto reader = computeIfAbsent (
+                        field->typeId(),
+                        [&field]() -> uPtr<reader::Reader> {
                             return reader::PropertyReader::make(field);
                         });
 
                 assert (reader);
                 readers.emplace_back(reader);
-                assert (readers.back().lock());
+                assert (readers.back());
                 break;
             }
             case amqp::internal::schema::FieldType::CompositeProperty : {
-                auto reader = m_readersByType[field->type()];
-
-                assert (reader);
-                readers.emplace_back(reader);
-                assert (readers.back().lock());
+                readers.emplace_back (built (field->typeId()));
                 break;
             }
             case schema::FieldType::RestrictedProperty :  {
-                auto reader = m_readersByType[field->requires().front()];
-
-                assert (reader);
-                readers.emplace_back(reader);
-                assert (readers.back().lock());
+                readers.emplace_back (built (field->resolvedTypeId()));
                 break;
             }
         }
 
-        assert (readers.back().lock());
+        assert (readers.back());
     }
 
-    return std::make_shared<reader::CompositeReader> (type_.name(), readers);
+    return std::make_unique<reader::CompositeReader> (
+            type_.name(),
+            type_.descriptor(),
+            std::move (names),
+            std::move (readers));
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::Reader>
+uPtr<amqp::internal::reader::Reader>
 amqp::internal::
 CompositeFactory::processEnum (
     const amqp::internal::schema::Enum & enum_
 ) {
     DBG ("Processing Enum - " << enum_.name() << std::endl); // NOLINT
 
-    return std::make_shared<reader::EnumReader> (
+    return std::make_unique<reader::EnumReader> (
             enum_.name(),
             enum_.makeChoices());
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::Reader>
+uPtr<amqp::internal::reader::Reader>
 amqp::internal::
 CompositeFactory::processList (
     const amqp::internal::schema::List & list_
 ) {
     DBG ("Processing List - " << list_.listOf() << std::endl); // NOLINT
 
-    if (schema::Field::typeIsPrimitive (list_.listOf())) {
-        DBG ("  List of Primitives" << std::endl); // NOLINT
-        auto reader = computeIfAbsent<reader::Reader>(
-                m_readersByType,
-                list_.listOf(),
-                [& list_]() -> std::shared_ptr<reader::PropertyReader> {
-                    return reader::PropertyReader::make (list_.listOf());
-                });
+    return std::make_unique<reader::ListReader>(
+            list_.name(),
+            element (list_.listOfId()));
+}
 
-        return std::make_shared<reader::ListReader>(list_.name(), reader);
-    } else {
-        DBG ("  List of Composite - " << list_.listOf() << std::endl); // NOLINT
-        auto reader = m_readersByType[list_.listOf()];
+/******************************************************************************/
+
+uPtr<amqp::internal::reader::Reader>
+amqp::internal::
+CompositeFactory::processMap (
+    const amqp::internal::schema::Map & map_
+) {
+    DBG ("Processing Map - "
+        << map_.keyType() << " -> " << map_.valueType() << std::endl); // NOLINT
+
+    return std::make_unique<reader::MapReader>(
+            map_.name(),
+            element (map_.keyTypeId()),
+            element (map_.valueTypeId()));
+}
+
+/******************************************************************************/
+
+/**
+ * The reader for a type that isn't a primitive. Types are built in the
+ * order they depend on each other, one that hasn't been is either missing
+ * from the schema or refers back to itself, and neither can be read
+ */
+const amqp::internal::reader::Reader *
+amqp::internal::
+CompositeFactory::built (const schema::Symbol & type_) const {
+    auto it = m_readersByType.find (type_);
+
+    if (it == m_readersByType.end() || !it->second) {
+        throw std::runtime_error ("No reader for type " + type_.str()
+            + ", it's either missing from the schema or recursive");
+    }
+
+    return it->second;
+}
+
+/******************************************************************************/
 
-        return std::make_shared<reader::ListReader>(list_.name(), reader);
+/**
+ * The reader for the elements of a list, or the keys or values of a map.
+ * Primitives might not have a reader yet, anything else was built before
+ * the type containing it
+ */
+const amqp::internal::reader::Reader *
+amqp::internal::
+CompositeFactory::element (const schema::Symbol & type_) {
+    if (schema::Field::typeIsPrimitive (type_)) {
+        DBG ("  Primitive - " << type_ << std::endl); // NOLINT
+        return computeIfAbsent (
+                type_,
+                [& type_]() -> uPtr<reader::Reader> {
+                    return reader::PropertyReader::make (type_.str());
+                });
+    } else {
+        DBG ("  Composite - " << type_ << std::endl); // NOLINT
+        return built (type_);
     }
 }
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::Reader>
+uPtr<amqp::internal::reader::Reader>
 amqp::internal::
 CompositeFactory::processRestricted (
         const amqp::internal::schema::AMQPTypeNotation & type_)
@@ -225,8 +272,9 @@ CompositeFactory::processRestricted (
             return processEnum (
                     dynamic_cast<const amqp::internal::schema::Enum &> (restricted));
         }
-        case schema::Restricted::RestrictedTypes::Map :{
-            throw std::runtime_error ("Cannot process maps");
+        case schema::Restricted::RestrictedTypes::Map : {
+            return processMap (
+                    dynamic_cast<const amqp::internal::schema::Map &> (restricted));
         }
     }
 
@@ -237,9 +285,25 @@ CompositeFactory::processRestricted (
 
 /******************************************************************************/
 
-const std::shared_ptr<amqp::internal::reader::IReader>
+const amqp::internal::reader::IReader *
+amqp::internal::
+CompositeFactory::byType (const std::string & type_) const {
+    return byType (schema::Symbol::find (type_));
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::IReader *
+amqp::internal::
+CompositeFactory::byDescriptor (const std::string & descriptor_) const {
+    return byDescriptor (schema::Symbol::find (descriptor_));
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
 amqp::internal::
-CompositeFactory::byType (const std::string & type_) {
+CompositeFactory::byType (const schema::Symbol & type_) const {
     auto it = m_readersByType.find (type_);
 
     return (it == m_readersByType.end()) ? nullptr : it->second;
@@ -247,9 +311,9 @@ CompositeFactory::byType (const std::string & type_) {
 
 /******************************************************************************/
 
-const std::shared_ptr<amqp::internal::reader::IReader>
+const amqp::internal::reader::Reader *
 amqp::internal::
-CompositeFactory::byDescriptor (const std::string & descriptor_) {
+CompositeFactory::byDescriptor (const schema::Symbol & descriptor_) const {
     auto it = m_readersByDescriptor.find (descriptor_);
 
     return (it == m_readersByDescriptor.end()) ? nullptr : it->second;
@@ -2,18 +2,21 @@
 
 /******************************************************************************/
 
-#include <map>
 #include <set>
+#include <unordered_map>
+#include <functional>
 
 #include "types.h"
 
 #include "amqp/ICompositeFactory.h"
 #include "amqp/schema/Schema.h"
+#include "amqp/schema/Symbol.h"
 #include "amqp/schema/Envelope.h"
 #include "amqp/schema/Composite.h"
 #include "amqp/reader/CompositeReader.h"
 #include "amqp/schema/restricted-types/List.h"
 #include "amqp/schema/restricted-types/Enum.h"
+#include "amqp/schema/restricted-types/Map.h"
 
 /******************************************************************************/
 
@@ -26,35 +29,57 @@ namespace amqp::internal {
             using CompositePtr = uPtr<schema::Composite>;
             using EnvelopePtr  = uPtr<schema::Envelope>;
 
-            spStrMap_t<reader::Reader> m_readersByType;
-            spStrMap_t<reader::Reader> m_readersByDescriptor;
+            using ReaderMap = std::unordered_map<schema::Symbol, reader::Reader *>;
+
+            /**
+             * Every reader we build lives here for as long as we do, the
+             * maps, and readers built from other readers, only point into
+             * it. Readers never move once built so those pointers stay good
+             */
+            sVec<uPtr<reader::Reader>> m_readers;
+
+            ReaderMap m_readersByType;
+            ReaderMap m_readersByDescriptor;
 
         public :
             CompositeFactory() = default;
 
+            CompositeFactory (const CompositeFactory &) = delete;
+            CompositeFactory & operator = (const CompositeFactory &) = delete;
+
             void process (const SchemaType &) override;
 
-            const std::shared_ptr<ReaderType> byType (
-                    const std::string &) override;
+            const ReaderType * byType (const std::string &) const override;
+            const ReaderType * byDescriptor (const std::string &) const override;
 
-            const std::shared_ptr<ReaderType> byDescriptor (
-                    const std::string &) override;
+            const reader::Reader * byType (const schema::Symbol &) const;
+            const reader::Reader * byDescriptor (const schema::Symbol &) const;
 
         private :
-            std::shared_ptr<reader::Reader> process (
+            reader::Reader * computeIfAbsent (
+                    const schema::Symbol &,
+                    const std::function<uPtr<reader::Reader>()> &);
+
+            reader::Reader * process (
                     const schema::AMQPTypeNotation &);
 
-            std::shared_ptr<reader::Reader> processComposite (
+            uPtr<reader::Reader> processComposite (
                     const schema::AMQPTypeNotation &);
 
-            std::shared_ptr<reader::Reader> processRestricted (
+            uPtr<reader::Reader> processRestricted (
                     const schema::AMQPTypeNotation &);
 
-            std::shared_ptr<reader::Reader> processList (
+            uPtr<reader::Reader> processList (
                     const schema::List &);
 
-            std::shared_ptr<reader::Reader> processEnum (
+            uPtr<reader::Reader> processEnum (
                     const schema::Enum &);
+
+            uPtr<reader::Reader> processMap (
+                    const schema::Map &);
+
+            const reader::Reader * built (const schema::Symbol &) const;
+            const reader::Reader * element (const schema::Symbol &);
     };
 
 }
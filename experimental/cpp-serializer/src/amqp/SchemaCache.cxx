@@ -0,0 +1,230 @@
+#include "SchemaCache.h"
+
+#include <functional>
+#include <string_view>
+
+#include "debug.h"
+
+#include "amqp/codec/Decoder.h"
+#include "amqp/plan/Compiler.h"
+#include "amqp/stats/Stats.h"
+#include "amqp/descriptors/AMQPDescriptors.h"
+#include "amqp/descriptors/AMQPDescriptorRegistory.h"
+#include "amqp/descriptors/corda-descriptors/SchemaDescriptor.h"
+
+/******************************************************************************
+ *
+ * class SchemaCache::Entry
+ *
+ ******************************************************************************/
+
+const amqp::internal::schema::Schema &
+amqp::internal::
+SchemaCache::Entry::schema() const {
+    return *m_schema;
+}
+
+/******************************************************************************/
+
+amqp::internal::CompositeFactory &
+amqp::internal::
+SchemaCache::Entry::factory() const {
+    return *m_factory;
+}
+
+/******************************************************************************/
+
+/**
+ * Expects the entry to be locked
+ */
+const amqp::internal::reader::Reader &
+amqp::internal::
+SchemaCache::Entry::locate (const std::string & descriptor_) const {
+    auto descriptor = schema::Symbol::find (descriptor_);
+
+    bool materialised;
+    {
+        stats::Timer timer (stats::Schema);
+        materialised = m_schema->materialise (descriptor);
+    }
+
+    if (materialised) {
+        stats::Timer timer (stats::Factory);
+        m_factory->process (*m_schema);
+    }
+
+    auto reader = m_factory->byDescriptor (descriptor);
+
+    if (!reader) {
+        throw std::runtime_error ("No reader for " + descriptor_);
+    }
+
+    return *reader;
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader &
+amqp::internal::
+SchemaCache::Entry::reader (const std::string & descriptor_) const {
+    std::lock_guard<std::mutex> lock (m_lock);
+
+    return locate (descriptor_);
+}
+
+/******************************************************************************/
+
+const amqp::internal::plan::DecodePlan &
+amqp::internal::
+SchemaCache::Entry::plan (const std::string & descriptor_) const {
+    return plan (descriptor_, plan::Projection());
+}
+
+/******************************************************************************/
+
+const amqp::internal::plan::DecodePlan &
+amqp::internal::
+SchemaCache::Entry::plan (
+    const std::string & descriptor_,
+    const plan::Projection & projection_
+) const {
+    std::lock_guard<std::mutex> lock (m_lock);
+
+    auto key = std::make_pair (
+            schema::Symbol::find (descriptor_),
+            projection_.str());
+
+    auto it = m_plans.find (key);
+
+    if (it == m_plans.end()) {
+        stats::Timer timer (stats::Compile);
+
+        it = m_plans.emplace (
+                std::move (key),
+                plan::Compiler::compile (
+                        locate (descriptor_),
+                        *m_schema,
+                        projection_)).first;
+    }
+
+    return it->second;
+}
+
+/******************************************************************************
+ *
+ * class SchemaCache
+ *
+ ******************************************************************************/
+
+amqp::internal::
+SchemaCache::SchemaCache (Materialise materialise_)
+    : m_materialise (materialise_)
+    , m_hits (0)
+    , m_misses (0)
+{
+}
+
+/******************************************************************************/
+
+const amqp::internal::SchemaCache::Entry &
+amqp::internal::
+SchemaCache::lookup (codec::Decoder * data_, std::string & descriptor_) {
+    stats::Timer timer (stats::Lookup);
+
+    codec::is_described (data_);
+    codec::auto_enter ae (data_);
+
+    codec::is_ulong (data_);
+    if (stripCorda (data_->getULong()) != static_cast<uint32_t> (ENVELOPE)) {
+        throw std::runtime_error ("Expected an Envelope");
+    }
+
+    data_->next();
+    codec::is_list (data_);
+    codec::auto_enter ae2 (data_);
+
+    /*
+     * The blob itself, all we want from it here is the type it
+     * contains so we know which reader to use
+     */
+    {
+        codec::is_described (data_);
+        codec::auto_enter ae3 (data_);
+        descriptor_ = codec::get_symbol<std::string> (data_);
+    }
+
+    data_->next();
+
+    /*
+     * The schema, skipping over the encoded bytes is all we need to do
+     * if we've seen it before
+     */
+    auto encoded = data_->raw();
+    auto hash = std::hash<std::string_view>{ } (encoded);
+
+    // a miss builds under the lock, that way two threads seeing a new
+    // schema at the same time don't both build readers for it
+    std::lock_guard<std::mutex> lock (m_lock);
+
+    auto range = m_entries.equal_range (hash);
+    for (auto it = range.first ; it != range.second ; ++it) {
+        if (it->second->m_encoded == encoded) {
+            DBG ("Schema cache hit: " << hash << std::endl); // NOLINT
+            ++m_hits;
+            return *(it->second);
+        }
+    }
+
+    DBG ("Schema cache miss: " << hash << std::endl); // NOLINT
+    ++m_misses;
+
+    auto entry = std::make_unique<Entry>();
+    entry->m_encoded = std::string (encoded);
+    entry->m_factory = std::make_unique<CompositeFactory>();
+
+    if (m_materialise == Materialise::All) {
+        {
+            stats::Timer phase (stats::Schema);
+            entry->m_schema = descriptors::dispatchDescribed<schema::Schema> (data_);
+        }
+
+        stats::Timer phase (stats::Factory);
+        entry->m_factory->process (*entry->m_schema);
+    } else {
+        // the schema points into the bytes so use the copy we're keeping
+        stats::Timer phase (stats::Schema);
+        codec::Decoder decoder (entry->m_encoded.data(), entry->m_encoded.size());
+        entry->m_schema = descriptors::dispatchUnparsed (&decoder);
+    }
+
+    return *(m_entries.emplace (hash, std::move (entry))->second);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+SchemaCache::size() const {
+    std::lock_guard<std::mutex> lock (m_lock);
+    return m_entries.size();
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+SchemaCache::hits() const {
+    std::lock_guard<std::mutex> lock (m_lock);
+    return m_hits;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+SchemaCache::misses() const {
+    std::lock_guard<std::mutex> lock (m_lock);
+    return m_misses;
+}
+
+/******************************************************************************/
@@ -0,0 +1,148 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "types.h"
+
+#include "amqp/schema/Schema.h"
+#include "amqp/CompositeFactory.h"
+#include "amqp/plan/DecodePlan.h"
+#include "amqp/plan/Projection.h"
+
+/******************************************************************************/
+
+namespace amqp::codec {
+    class Decoder;
+}
+
+/******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Blobs written by the same node tend to share a handful of schemas
+     * and decoding one, then building the readers for it, is usually more
+     * work than reading the data it describes. So rather than doing that
+     * for every blob we remember the schema and the factory holding its
+     * readers keyed by a hash of the schema's raw encoding. A blob whose
+     * schema we've already seen skips straight over it.
+     *
+     * Entries live as long as the cache does, as do the readers they
+     * hand out. Lookups are safe to make from many threads at once,
+     * readers don't change once built so they can be shared freely.
+     *
+     * Schemas often describe far more types than any one blob uses. Built
+     * to materialise only what's Reachable a new schema just has the name
+     * and descriptor of each type read, a type is only decoded, and its
+     * readers built, once a blob containing it, or something that refers
+     * to it, asks for it through reader or plan.
+     */
+    class SchemaCache {
+        public :
+            enum class Materialise { All, Reachable };
+
+            class Entry {
+                private :
+                    friend class SchemaCache;
+
+                    /**
+                     * The raw encoded schema, kept so a hash collision
+                     * can't hand back the wrong readers
+                     */
+                    std::string                m_encoded;
+                    uPtr<schema::Schema>       m_schema;
+                    uPtr<CompositeFactory>     m_factory;
+
+                    /**
+                     * Plans are compiled the first time they're asked
+                     * for, keyed by the descriptor of the top level type
+                     * and the fields projected from it
+                     */
+                    mutable std::map<
+                        std::pair<schema::Symbol, std::string>,
+                        plan::DecodePlan> m_plans;
+
+                    /**
+                     * Held while types are materialised and plans
+                     * compiled
+                     */
+                    mutable std::mutex m_lock;
+
+                    const reader::Reader & locate (const std::string &) const;
+
+                public :
+                    /**
+                     * When materialising lazily these only hold what's
+                     * been asked for through reader or plan so far
+                     */
+                    const schema::Schema & schema() const;
+                    CompositeFactory & factory() const;
+
+                    /**
+                     * The reader for the type with [descriptor_],
+                     * materialising it first if need be
+                     */
+                    const reader::Reader & reader (const std::string & descriptor_) const;
+
+                    const plan::DecodePlan & plan (const std::string &) const;
+
+                    const plan::DecodePlan & plan (
+                            const std::string &,
+                            const plan::Projection &) const;
+
+                    /**
+                     * Materialise the type with [descriptor_] and hand
+                     * the schema to [with_], holding the entry's lock
+                     * throughout so nothing is materialised into the
+                     * schema while [with_] is walking it
+                     */
+                    template<typename With>
+                    auto locked (const std::string & descriptor_, With && with_) const {
+                        std::lock_guard<std::mutex> lock (m_lock);
+
+                        locate (descriptor_);
+
+                        return with_ (static_cast<const schema::Schema &> (*m_schema));
+                    }
+            };
+
+        private :
+            std::unordered_multimap<size_t, uPtr<Entry>> m_entries;
+
+            mutable std::mutex m_lock;
+
+            const Materialise m_materialise;
+
+            size_t m_hits;
+            size_t m_misses;
+
+        public :
+            explicit SchemaCache (Materialise materialise_ = Materialise::All);
+
+            SchemaCache (const SchemaCache &) = delete;
+            SchemaCache & operator = (const SchemaCache &) = delete;
+
+            /**
+             * With the decoder positioned on a blob's envelope return
+             * the schema and readers for that blob, building them if
+             * this is the first time we've seen that schema. The type
+             * of the object the blob contains is written to the second
+             * argument.
+             *
+             * The decoder is left where it started.
+             */
+            const Entry & lookup (codec::Decoder *, std::string &);
+
+            size_t size() const;
+            size_t hits() const;
+            size_t misses() const;
+    };
+
+}
+
+/******************************************************************************/
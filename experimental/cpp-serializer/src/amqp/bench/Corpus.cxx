@@ -0,0 +1,200 @@
+#include "Corpus.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#include "amqp/SchemaCache.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/codec/Payload.h"
+#include "amqp/codec/BlobFile.h"
+#include "amqp/value/ValueTree.h"
+#include "serialiser/Serialiser.h"
+#include "serialiser/EncodingVisitor.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    bool
+    hasLists (const value::Value & value_) {
+        if (value_.m_kind == value::Value::Kind::LIST) {
+            return true;
+        }
+
+        for (auto v = value_.m_first ; v ; v = v->m_next) {
+            if (hasLists (*v)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * How many visitor callbacks writing [value_] with its lists [factor_]
+     * times longer would make
+     */
+    size_t
+    callbacks (const value::Value & value_, size_t factor_) {
+        using Kind = value::Value::Kind;
+
+        size_t inner { 0 };
+        for (auto v = value_.m_first ; v ; v = v->m_next) {
+            inner += callbacks (*v, factor_);
+        }
+
+        switch (value_.m_kind) {
+            case Kind::COMPOSITE : return 2 + inner + value_.m_size;
+            case Kind::LIST      : return 2 + factor_ * inner;
+            case Kind::MAP       : return 2 + inner;
+            default              : return 1;
+        }
+    }
+
+    /**
+     * value::accept, but with every list repeating its elements [factor_]
+     * times. Maps aren't scaled, repeating their entries would only
+     * repeat keys
+     */
+    void
+    accept (
+        const value::Value & value_,
+        size_t factor_,
+        amqp::reader::IVisitor & visitor_
+    ) {
+        switch (value_.m_kind) {
+            case value::Value::Kind::COMPOSITE : {
+                visitor_.beginComposite (std::string (value_.m_string));
+
+                for (auto v = value_.m_first ; v ; v = v->m_next) {
+                    visitor_.field (std::string (v->m_name));
+                    accept (*v, factor_, visitor_);
+                }
+
+                visitor_.endComposite();
+                break;
+            }
+            case value::Value::Kind::LIST : {
+                visitor_.beginList (std::string (value_.m_string), value_.m_size * factor_);
+
+                for (size_t i { 0 } ; i < factor_ ; ++i) {
+                    for (auto v = value_.m_first ; v ; v = v->m_next) {
+                        accept (*v, factor_, visitor_);
+                    }
+                }
+
+                visitor_.endList();
+                break;
+            }
+            case value::Value::Kind::MAP : {
+                visitor_.beginMap (std::string (value_.m_string), value_.m_size / 2);
+
+                for (auto v = value_.m_first ; v ; v = v->m_next) {
+                    accept (*v, factor_, visitor_);
+                }
+
+                visitor_.endMap();
+                break;
+            }
+            default : {
+                value::accept (value_, visitor_);
+                break;
+            }
+        }
+    }
+
+    /**
+     * Write [blob_] again for each factor, its lists scaled up by that
+     */
+    void
+    scale (
+        const bench::Blob & blob_,
+        const std::vector<size_t> & factors_,
+        size_t limit_,
+        std::vector<bench::Blob> & scaled_
+    ) {
+        amqp::codec::Payload payload (blob_.m_bytes.data(), blob_.m_bytes.size());
+        amqp::codec::Decoder decoder (payload.data(), payload.size());
+        amqp::codec::Decoder * d = &decoder;
+
+        SchemaCache cache;
+        std::string type;
+        const auto & entry = cache.lookup (d, type);
+
+        value::ValueTree tree;
+        {
+            amqp::codec::auto_enter ae (d);
+            d->next();
+            amqp::codec::auto_enter ae2 (d);
+
+            entry.reader (type).visit (d, entry.schema(), tree);
+        }
+
+        const auto & root = *tree.root();
+
+        if (!hasLists (root)) {
+            return;
+        }
+
+        amqp::serialiser::Serialiser serialiser (entry);
+
+        for (auto factor : factors_) {
+            if (callbacks (root, factor) > limit_) {
+                continue;
+            }
+
+            bench::Blob scaled { blob_.m_name + "*" + std::to_string (factor), { } };
+
+            serialiser.write (type, scaled.m_bytes, [&] (amqp::codec::Encoder & encoder_) {
+                serialiser::EncodingVisitor visitor (serialiser.schema(), encoder_);
+                accept (root, factor, visitor);
+            });
+
+            scaled_.push_back (std::move (scaled));
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+std::vector<amqp::internal::bench::Blob>
+amqp::internal::bench::
+corpus (
+    const std::string & dir_,
+    const std::vector<size_t> & factors_,
+    size_t limit_
+) {
+    namespace fs = std::filesystem;
+
+    std::vector<std::string> paths;
+    for (const auto & file : fs::directory_iterator (dir_)) {
+        if (file.is_regular_file()) {
+            paths.push_back (file.path().string());
+        }
+    }
+
+    std::sort (paths.begin(), paths.end());
+
+    std::vector<Blob> blobs;
+    for (const auto & path : paths) {
+        amqp::codec::BlobFile file (path);
+
+        blobs.push_back (Blob {
+            fs::path (path).filename().string(),
+            std::vector<char> (file.data(), file.data() + file.size()) });
+    }
+
+    std::vector<Blob> scaled;
+    for (const auto & blob : blobs) {
+        scale (blob, factors_, limit_, scaled);
+    }
+
+    std::move (scaled.begin(), scaled.end(), std::back_inserter (blobs));
+
+    return blobs;
+}
+
+/******************************************************************************/
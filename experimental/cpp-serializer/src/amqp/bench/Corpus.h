@@ -0,0 +1,32 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/******************************************************************************/
+
+namespace amqp::internal::bench {
+
+    struct Blob {
+        std::string       m_name;
+        std::vector<char> m_bytes;
+    };
+
+    /**
+     * Every blob in [dir_], by name, and then, for those with lists in,
+     * the same blob with its lists [factors_] times longer, named after
+     * it as "name*factor". A variant that would take more than [limit_]
+     * visitor callbacks to write is left out, lists of lists grow as the
+     * factor does to the power of their depth.
+     */
+    std::vector<Blob> corpus (
+        const std::string & dir_,
+        const std::vector<size_t> & factors_,
+        size_t limit_);
+
+}
+
+/******************************************************************************/
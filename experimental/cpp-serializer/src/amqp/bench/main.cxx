@@ -0,0 +1,308 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <string_view>
+
+#include "Corpus.h"
+
+#include "amqp/SchemaCache.h"
+#include "amqp/CompositeFactory.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/codec/Payload.h"
+#include "amqp/reader/Reader.h"
+#include "amqp/reader/IVisitor.h"
+#include "amqp/descriptors/AMQPDescriptors.h"
+#include "amqp/stats/Stats.h"
+#include "serialiser/Generator.h"
+
+using namespace amqp::internal;
+
+/******************************************************************************/
+
+/**
+ * Three ways of decoding each blob
+ *
+ *  cold  as the first blob with its schema, decoding the schema and building
+ *        its readers before reading the object. The time spent on each of
+ *        those is reported as schema_us, factory_us and payload_us
+ *  warm  with the schema already in a SchemaCache, as every blob after
+ *        the first is, walking the readers
+ *  plan  as warm but running the compiled decode plan
+ *
+ * Blobs are read into a visitor that throws everything away, so what's
+ * measured is the decoding and nothing else.
+ *
+ * Built with AMQP_ALLOC_STATS each also reports the allocations, and
+ * the bytes they asked for, per blob decoded as allocs and alloc_bytes.
+ */
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    const std::vector<size_t> FACTORS { 10, 100, 1000 };
+
+    /**
+     * Don't make anything taking more visitor callbacks than this to read
+     */
+    constexpr size_t LIMIT = 1'000'000;
+
+    /**
+     * Shapes production blobs come in that the test blobs don't
+     */
+    std::vector<bench::Blob>
+    generated() {
+        std::vector<std::pair<std::string, serialiser::Shape>> shapes;
+
+        serialiser::Shape shape;
+
+        shape.m_fields = 64;
+        shape.m_length = 1'000;
+        shapes.emplace_back ("wide", shape);
+
+        shape = serialiser::Shape();
+        shape.m_depth = 16;
+        shape.m_fields = 4;
+        shapes.emplace_back ("deep", shape);
+
+        shape = serialiser::Shape();
+        shape.m_length = 50'000;
+        shapes.emplace_back ("long", shape);
+
+        shape = serialiser::Shape();
+        shape.m_strings = 90;
+        shape.m_enums = 10;
+        shape.m_stringLength = 64;
+        shapes.emplace_back ("strings", shape);
+
+        shape = serialiser::Shape();
+        shape.m_length = 10;
+        shape.m_types = 5'000;
+        shapes.emplace_back ("types", shape);
+
+        std::vector<bench::Blob> blobs;
+
+        for (const auto & s : shapes) {
+            blobs.push_back (bench::Blob { "generated/" + s.first, { } });
+            serialiser::Generator (s.second).write (blobs.back().m_bytes);
+        }
+
+        return blobs;
+    }
+
+    class NullVisitor : public amqp::reader::IVisitor {
+        private :
+            size_t m_values { 0 };
+
+        public :
+            void beginComposite (const std::string &) override { }
+            void endComposite() override { }
+            void beginList (const std::string &, size_t) override { }
+            void endList() override { }
+            void beginMap (const std::string &, size_t) override { }
+            void endMap() override { }
+            void field (const std::string &) override { }
+
+            void onInt (int32_t) override { ++m_values; }
+            void onLong (int64_t) override { ++m_values; }
+            void onDouble (double) override { ++m_values; }
+            void onBool (bool) override { ++m_values; }
+            void onString (std::string_view) override { ++m_values; }
+            void onEnum (std::string_view) override { ++m_values; }
+
+            size_t values() const { return m_values; }
+    };
+
+    double
+    since (Clock::time_point & then_) {
+        auto now = Clock::now();
+        auto elapsed = std::chrono::duration<double, std::micro> (now - then_).count();
+
+        then_ = now;
+
+        return elapsed;
+    }
+
+    /**
+     * Leave [data_] on the object in the envelope
+     */
+    void
+    object (amqp::codec::Decoder * data_) {
+        data_->enter();
+        data_->next();
+        data_->next();
+        data_->enter();
+        data_->next();
+    }
+
+    /**
+     * The encoded schema of the blob in [data_], and the descriptor of
+     * the object it holds, found as SchemaCache::lookup would
+     */
+    std::string_view
+    encodedSchema (amqp::codec::Decoder * data_, std::string & descriptor_) {
+        object (data_);
+
+        {
+            amqp::codec::auto_enter ae (data_);
+            descriptor_ = amqp::codec::get_symbol<std::string> (data_);
+        }
+
+        data_->next();
+
+        return data_->raw();
+    }
+
+    /**
+     * Allocations are only counted inside a scope, without them the
+     * timers shouldn't be running at all
+     */
+#ifdef AMQP_ALLOC_STATS
+    using Allocating = stats::Scope;
+#else
+    struct Allocating {
+        explicit Allocating (stats::Stats &) { }
+    };
+#endif
+
+    void
+    processed (
+        benchmark::State & state_,
+        const bench::Blob & blob_,
+        const stats::Stats & stats_
+    ) {
+        state_.SetItemsProcessed (state_.iterations());
+        state_.SetBytesProcessed (
+                state_.iterations() * static_cast<int64_t> (blob_.m_bytes.size()));
+
+#ifdef AMQP_ALLOC_STATS
+        stats::Allocations total { 0, 0 };
+        for (int i { 0 } ; i <= stats::Phases ; ++i) {
+            total.m_count += stats_.allocations (static_cast<stats::Phase> (i)).m_count;
+            total.m_bytes += stats_.allocations (static_cast<stats::Phase> (i)).m_bytes;
+        }
+
+        state_.counters["allocs"] = benchmark::Counter (
+                static_cast<double> (total.m_count), benchmark::Counter::kAvgIterations);
+        state_.counters["alloc_bytes"] = benchmark::Counter (
+                static_cast<double> (total.m_bytes), benchmark::Counter::kAvgIterations);
+#endif
+    }
+
+    /**************************************************************************/
+
+    void
+    cold (benchmark::State & state_, const bench::Blob * blob_) {
+        double schemaTime { 0 }, factoryTime { 0 }, payloadTime { 0 };
+
+        stats::Stats stats;
+        Allocating allocating (stats);
+
+        for (auto _ : state_) {
+            auto then = Clock::now();
+
+            amqp::codec::Payload payload (blob_->m_bytes.data(), blob_->m_bytes.size());
+            payloadTime += since (then);
+
+            std::string descriptor;
+            amqp::codec::Decoder envelope (payload.data(), payload.size());
+            auto encoded = encodedSchema (&envelope, descriptor);
+
+            amqp::codec::Decoder decoder (encoded.data(), encoded.size());
+            auto types = descriptors::dispatchDescribed<schema::Schema> (&decoder);
+            schemaTime += since (then);
+
+            CompositeFactory factory;
+            factory.process (*types);
+            auto reader = factory.byDescriptor (schema::Symbol::find (descriptor));
+            factoryTime += since (then);
+
+            NullVisitor visitor;
+            amqp::codec::Decoder data (payload.data(), payload.size());
+            object (&data);
+            reader->visit (&data, *types, visitor);
+            benchmark::DoNotOptimize (visitor.values());
+            payloadTime += since (then);
+        }
+
+        processed (state_, *blob_, stats);
+
+        state_.counters["schema_us"] =
+            benchmark::Counter (schemaTime, benchmark::Counter::kAvgIterations);
+        state_.counters["factory_us"] =
+            benchmark::Counter (factoryTime, benchmark::Counter::kAvgIterations);
+        state_.counters["payload_us"] =
+            benchmark::Counter (payloadTime, benchmark::Counter::kAvgIterations);
+    }
+
+    /**************************************************************************/
+
+    template<bool Compiled>
+    void
+    warm (benchmark::State & state_, const bench::Blob * blob_) {
+        SchemaCache cache;
+
+        stats::Stats stats;
+        Allocating allocating (stats);
+
+        for (auto _ : state_) {
+            amqp::codec::Payload payload (blob_->m_bytes.data(), blob_->m_bytes.size());
+            amqp::codec::Decoder decoder (payload.data(), payload.size());
+            amqp::codec::Decoder * d = &decoder;
+
+            std::string descriptor;
+            const auto & entry = cache.lookup (d, descriptor);
+
+            NullVisitor visitor;
+            object (d);
+
+            if (Compiled) {
+                entry.plan (descriptor).run (d, visitor);
+            } else {
+                entry.reader (descriptor).visit (d, entry.schema(), visitor);
+            }
+
+            benchmark::DoNotOptimize (visitor.values());
+        }
+
+        processed (state_, *blob_, stats);
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ *  amqp-bench [benchmark flags] [directory]
+ *
+ * Benchmarks the blobs in [directory], the blob-inspector's test blobs if
+ * there isn't one, along with bigger versions of them and some generated
+ * ones
+ */
+int
+main (int argc, char ** argv) {
+    benchmark::Initialize (&argc, argv);
+
+    auto blobs = bench::corpus (argc > 1 ? argv[1] : FIXTURE_DIR, FACTORS, LIMIT);
+    auto made = generated();
+
+    blobs.insert (blobs.end(),
+            std::make_move_iterator (made.begin()),
+            std::make_move_iterator (made.end()));
+
+    for (const auto & blob : blobs) {
+        benchmark::RegisterBenchmark (("cold/" + blob.m_name).c_str(), cold, &blob);
+        benchmark::RegisterBenchmark (("warm/" + blob.m_name).c_str(), warm<false>, &blob);
+        benchmark::RegisterBenchmark (("plan/" + blob.m_name).c_str(), warm<true>, &blob);
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
+
+/******************************************************************************/
@@ -0,0 +1,228 @@
+#include "Binding.h"
+
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include "amqp/reader/restricted-readers/EnumReader.h"
+#include "amqp/schema/restricted-types/Enum.h"
+#include "serialiser/EnumWriter.h"
+
+/******************************************************************************/
+
+namespace {
+
+    const amqp::internal::schema::AMQPTypeNotation &
+    notation (
+        const amqp::internal::schema::Schema & schema_,
+        const amqp::internal::schema::Symbol & type_
+    ) {
+        auto type = schema_.byType (type_);
+
+        if (!type) {
+            throw std::runtime_error ("No type " + type_.str() + " in the schema");
+        }
+
+        return *type;
+    }
+
+    const amqp::internal::schema::Restricted *
+    restricted (
+        const amqp::internal::schema::Schema & schema_,
+        const amqp::internal::schema::Symbol & type_,
+        amqp::internal::schema::Restricted::RestrictedTypes restrictedType_
+    ) {
+        if (type_.primitive()) {
+            return nullptr;
+        }
+
+        const auto & type = notation (schema_, type_);
+
+        if (type.type() != amqp::internal::schema::AMQPTypeNotation::Restricted) {
+            return nullptr;
+        }
+
+        const auto & r = dynamic_cast<const amqp::internal::schema::Restricted &> (type);
+
+        return r.restrictedType() == restrictedType_ ? &r : nullptr;
+    }
+
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Composite &
+amqp::internal::bind::
+asComposite (const schema::Schema & schema_, const schema::Symbol & type_) {
+    if (type_.primitive()) {
+        mismatch ("a composite", type_);
+    }
+
+    const auto & type = notation (schema_, type_);
+
+    if (type.type() != schema::AMQPTypeNotation::Composite) {
+        mismatch ("a composite", type_);
+    }
+
+    return dynamic_cast<const schema::Composite &> (type);
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::List &
+amqp::internal::bind::
+asList (const schema::Schema & schema_, const schema::Symbol & type_) {
+    auto list = restricted (schema_, type_, schema::Restricted::List);
+
+    if (!list) {
+        mismatch ("a list", type_);
+    }
+
+    return dynamic_cast<const schema::List &> (*list);
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Map &
+amqp::internal::bind::
+asMap (const schema::Schema & schema_, const schema::Symbol & type_) {
+    auto map = restricted (schema_, type_, schema::Restricted::Map);
+
+    if (!map) {
+        mismatch ("a map", type_);
+    }
+
+    return dynamic_cast<const schema::Map &> (*map);
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::bind::
+isEnum (const schema::Schema & schema_, const schema::Symbol & type_) {
+    return restricted (schema_, type_, schema::Restricted::Enum) != nullptr;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::bind::
+fieldIndex (const schema::Composite & composite_, const char * name_) {
+    const auto & fields = composite_.fields();
+
+    for (size_t i { 0 } ; i < fields.size() ; ++i) {
+        if (fields[i]->name() == name_) {
+            return i;
+        }
+    }
+
+    throw std::runtime_error (
+            std::string ("No field ") + name_ + " in " + composite_.name());
+}
+
+/******************************************************************************/
+
+/**
+ * Matches the way the CompositeFactory picks a field's reader
+ */
+const amqp::internal::schema::Symbol &
+amqp::internal::bind::
+fieldType (const schema::Field & field_) {
+    return field_.fieldType() == schema::FieldType::RestrictedProperty
+        ? field_.resolvedTypeId()
+        : field_.typeId();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::bind::
+mismatch (const std::string & expected_, const schema::Symbol & found_) {
+    throw std::runtime_error (
+            "Cannot bind " + found_.str() + ", expected " + expected_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::bind::
+checkDescriptor (codec::Decoder * data_, const std::string & descriptor_) {
+    auto descriptor = codec::get_symbol<std::string_view> (data_);
+
+    if (descriptor != descriptor_) {
+        std::stringstream ss;
+        ss << "Expected an instance of " << descriptor_
+           << " but found " << descriptor;
+        throw std::runtime_error (ss.str());
+    }
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Symbol &
+amqp::internal::bind::
+typeOf (const schema::Schema & schema_, const std::string & descriptor_) {
+    auto type = schema_.byDescriptor (schema::Symbol::find (descriptor_));
+
+    if (!type) {
+        throw std::runtime_error ("No type with descriptor " + descriptor_);
+    }
+
+    return type->id();
+}
+
+/******************************************************************************
+ *
+ * class Bound<std::string>
+ *
+ ******************************************************************************/
+
+amqp::internal::bind::
+Bound<std::string>::Bound (
+    const schema::Schema & schema_,
+    const schema::Symbol & type_
+) : m_enum (false) {
+    if (type_ != schema::Symbol ("string")) {
+        auto enumeration = restricted (schema_, type_, schema::Restricted::Enum);
+
+        if (!enumeration) {
+            mismatch ("a string or an enum", type_);
+        }
+
+        m_enum = true;
+        m_descriptor = enumeration->descriptor();
+        m_choices = dynamic_cast<const schema::Enum &> (*enumeration).makeChoices();
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::bind::
+Bound<std::string>::read (codec::Decoder * data_, std::string & value_) const {
+    value_ = m_enum
+        ? reader::EnumReader::value (data_)
+        : codec::readAndNext<std::string_view> (data_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::bind::
+Bound<std::string>::write (codec::Encoder & data_, const std::string & value_) const {
+    if (!m_enum) {
+        data_.putString (value_);
+        return;
+    }
+
+    auto choice = std::find (m_choices.begin(), m_choices.end(), value_);
+
+    if (choice == m_choices.end()) {
+        throw std::runtime_error (
+                value_ + " is not a constant of enum " + m_descriptor);
+    }
+
+    serialiser::writeEnum (data_, m_descriptor, value_, choice - m_choices.begin());
+}
+
+/******************************************************************************/
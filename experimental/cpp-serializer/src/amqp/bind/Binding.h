@@ -0,0 +1,595 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#include "amqp/SchemaCache.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/codec/Encoder.h"
+#include "amqp/schema/Schema.h"
+#include "amqp/schema/restricted-types/List.h"
+#include "amqp/schema/restricted-types/Map.h"
+#include "amqp/reader/Reader.h"
+
+/******************************************************************************/
+
+/**
+ * Decoding blobs straight into plain C++ structs.
+ *
+ * A struct is bound by listing the fields it wants out of a composite,
+ * by name, along with the members they go into
+ *
+ *     struct Thing { int32_t a; std::string b; std::vector<Other> c; };
+ *
+ *     AMQP_BIND (Thing,
+ *         AMQP_FIELD (Thing, a),
+ *         AMQP_FIELD (Thing, b),
+ *         AMQP_FIELD (Thing, c));
+ *
+ * A Binding checks that against the schema once, members of the wrong
+ * type or fields the composite doesn't have are errors, and from then on
+ * reads each value into the members directly. Nothing is built up in
+ * between and the only work done per value is what its type needs, there
+ * are no lookups by name and no strings other than those being read.
+ *
+ * Members can be int32_t, int64_t, bool, double, std::string, which also
+ * takes enums, bound structs and std::vectors and std::maps of those.
+ * Fields in the schema that aren't bound are stepped over. Types that
+ * contain themselves can't be bound.
+ *
+ * The same binding writes values back out, as the JVM would encode them
+ * against that schema, with null for any field that isn't bound. Objects
+ * are always written in full, never as a reference to an earlier one.
+ */
+namespace amqp::internal::bind {
+
+    template<typename T, typename M>
+    struct Field {
+        using Member = M;
+
+        const char * m_name;
+        M T::*       m_member;
+    };
+
+    template<typename T, typename M>
+    constexpr Field<T, M>
+    field (const char * name_, M T::* member_) {
+        return { name_, member_ };
+    }
+
+    /**
+     * Specialised for each bound struct, see AMQP_BIND, with a
+     * tuple of its fields
+     */
+    template<typename T>
+    struct Fields;
+
+    template<typename T, typename = void>
+    struct isBound : std::false_type { };
+
+    template<typename T>
+    struct isBound<T, std::void_t<decltype (Fields<T>::fields)>> : std::true_type { };
+
+}
+
+/******************************************************************************/
+
+#define AMQP_FIELD(type_, member_) \
+    amqp::internal::bind::field (#member_, &type_::member_)
+
+#define AMQP_BIND(type_, ...)                                           \
+    template<>                                                          \
+    struct amqp::internal::bind::Fields<type_> {                        \
+        static constexpr auto fields = std::make_tuple (__VA_ARGS__);   \
+    }
+
+/******************************************************************************
+ *
+ * Schema helpers, these throw if the schema doesn't have what we want
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::bind {
+
+    const schema::Composite & asComposite (const schema::Schema &, const schema::Symbol &);
+    const schema::List & asList (const schema::Schema &, const schema::Symbol &);
+    const schema::Map & asMap (const schema::Schema &, const schema::Symbol &);
+
+    bool isEnum (const schema::Schema &, const schema::Symbol &);
+
+    /**
+     * Where field [name_] is in [composite_]
+     */
+    size_t fieldIndex (const schema::Composite & composite_, const char * name_);
+
+    /**
+     * The type a field's values are read as
+     */
+    const schema::Symbol & fieldType (const schema::Field &);
+
+    [[noreturn]] void mismatch (const std::string & expected_, const schema::Symbol & found_);
+
+    void checkDescriptor (codec::Decoder *, const std::string &);
+
+}
+
+/******************************************************************************
+ *
+ * Bound
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::bind {
+
+    /**
+     * Checked against a type in the schema reads values of that type
+     * into an M, and writes them back out of one
+     */
+    template<typename M, typename = void>
+    class Bound {
+        static_assert (sizeof (M) == 0, "Can't bind this type, see AMQP_BIND");
+    };
+
+    /**
+     * Read a value where the JVM serialiser could have written a
+     * reference to one it had already written, see reader::visitObject
+     */
+    template<typename M>
+    void object (const Bound<M> &, codec::Decoder *, M &);
+
+    template<typename M, typename Wire>
+    class Primitive {
+        public :
+            Primitive (const char * type_, const schema::Symbol & found_) {
+                if (found_ != schema::Symbol (type_)) {
+                    mismatch (type_, found_);
+                }
+            }
+
+            bool referenceable() const { return false; }
+
+            void read (codec::Decoder * data_, M & value_) const {
+                value_ = static_cast<M> (codec::readAndNext<Wire> (data_));
+            }
+
+            void write (codec::Encoder & data_, const M & value_) const {
+                codec::write<Wire> (data_, static_cast<Wire> (value_));
+            }
+    };
+
+    template<>
+    class Bound<int32_t> : public Primitive<int32_t, int32_t> {
+        public :
+            Bound (const schema::Schema &, const schema::Symbol & type_)
+                : Primitive ("int", type_)
+            { }
+    };
+
+    template<>
+    class Bound<int64_t> : public Primitive<int64_t, long> {
+        public :
+            Bound (const schema::Schema &, const schema::Symbol & type_)
+                : Primitive ("long", type_)
+            { }
+    };
+
+    template<>
+    class Bound<bool> : public Primitive<bool, bool> {
+        public :
+            Bound (const schema::Schema &, const schema::Symbol & type_)
+                : Primitive ("boolean", type_)
+            { }
+    };
+
+    template<>
+    class Bound<double> : public Primitive<double, double> {
+        public :
+            Bound (const schema::Schema &, const schema::Symbol & type_)
+                : Primitive ("double", type_)
+            { }
+    };
+
+    /**
+     * Strings, or the name of an enum's constant
+     */
+    template<>
+    class Bound<std::string> {
+        private :
+            bool m_enum;
+
+            /**
+             * Only set for an enum, what we need to write one
+             */
+            std::string              m_descriptor;
+            std::vector<std::string> m_choices;
+
+        public :
+            Bound (const schema::Schema &, const schema::Symbol &);
+
+            bool referenceable() const { return true; }
+
+            void read (codec::Decoder *, std::string &) const;
+            void write (codec::Encoder &, const std::string &) const;
+    };
+
+    template<typename E>
+    class Bound<std::vector<E>> {
+        private :
+            std::string m_descriptor;
+            Bound<E>    m_element;
+
+            Bound (const schema::Schema & schema_, const schema::List & list_)
+                : m_descriptor (list_.descriptor())
+                , m_element (schema_, list_.listOfId())
+            { }
+
+        public :
+            Bound (const schema::Schema & schema_, const schema::Symbol & type_)
+                : Bound (schema_, asList (schema_, type_))
+            { }
+
+            bool referenceable() const { return true; }
+
+            void read (codec::Decoder * data_, std::vector<E> & value_) const {
+                codec::auto_next an (data_);
+                codec::is_described (data_);
+                codec::auto_enter ae (data_);
+                data_->next();
+
+                codec::auto_list_enter ale (data_, true);
+
+                value_.clear();
+                value_.reserve (ale.elements());
+
+                for (size_t i { 0 } ; i < ale.elements() ; ++i) {
+                    E element { };
+                    object (m_element, data_, element);
+                    value_.push_back (std::move (element));
+                }
+            }
+
+            void write (codec::Encoder & data_, const std::vector<E> & value_) const {
+                data_.described();
+                data_.putSymbol (m_descriptor);
+                data_.beginList();
+
+                for (const auto & element : value_) {
+                    m_element.write (data_, element);
+                }
+
+                data_.endList();
+            }
+    };
+
+    template<typename K, typename V>
+    class Bound<std::map<K, V>> {
+        private :
+            std::string m_descriptor;
+            Bound<K>    m_key;
+            Bound<V>    m_value;
+
+            Bound (const schema::Schema & schema_, const schema::Map & map_)
+                : m_descriptor (map_.descriptor())
+                , m_key (schema_, map_.keyTypeId())
+                , m_value (schema_, map_.valueTypeId())
+            { }
+
+        public :
+            Bound (const schema::Schema & schema_, const schema::Symbol & type_)
+                : Bound (schema_, asMap (schema_, type_))
+            { }
+
+            bool referenceable() const { return true; }
+
+            void read (codec::Decoder * data_, std::map<K, V> & value_) const {
+                codec::auto_next an (data_);
+                codec::is_described (data_);
+                codec::auto_enter ae (data_);
+                data_->next();
+
+                codec::is_map (data_);
+                auto entries = data_->getMap() / 2;
+
+                codec::auto_enter ae2 (data_);
+
+                value_.clear();
+
+                for (size_t i { 0 } ; i < entries ; ++i) {
+                    K key { };
+                    V value { };
+                    object (m_key, data_, key);
+                    object (m_value, data_, value);
+                    value_.insert_or_assign (std::move (key), std::move (value));
+                }
+            }
+
+            void write (codec::Encoder & data_, const std::map<K, V> & value_) const {
+                data_.described();
+                data_.putSymbol (m_descriptor);
+                data_.beginMap();
+
+                for (const auto & entry : value_) {
+                    m_key.write (data_, entry.first);
+                    m_value.write (data_, entry.second);
+                }
+
+                data_.endMap();
+            }
+    };
+
+    /**
+     * A bound struct. Checking it against the composite works out, for
+     * each field in the order they're written, which member it's read
+     * into and written from, if any, as pointers to the functions doing
+     * the reading and writing
+     */
+    template<typename T>
+    class Bound<T, std::enable_if_t<isBound<T>::value>> {
+        private :
+            using Tuple = std::remove_const_t<decltype (Fields<T>::fields)>;
+
+            static constexpr size_t N = std::tuple_size_v<Tuple>;
+
+            template<size_t I>
+            using Member = typename std::tuple_element_t<I, Tuple>::Member;
+
+            template<typename S>
+            struct Members;
+
+            template<size_t... I>
+            struct Members<std::index_sequence<I...>> {
+                using type = std::tuple<Bound<Member<I>>...>;
+            };
+
+            using Read = void (Bound::*) (codec::Decoder *, T &) const;
+            using Write = void (Bound::*) (codec::Encoder &, const T &) const;
+
+            std::string m_descriptor;
+
+            typename Members<std::make_index_sequence<N>>::type m_members;
+
+            /**
+             * One for each field in the schema, null for primitives we
+             * skip
+             */
+            std::vector<Read>  m_fields;
+            std::vector<Write> m_writes;
+
+            template<size_t... I>
+            Bound (
+                const schema::Schema & schema_,
+                const schema::Composite & composite_,
+                std::index_sequence<I...>
+            ) : m_descriptor (composite_.descriptor())
+              , m_members (member<I> (schema_, composite_)...)
+              , m_fields (composite_.fields().size(), nullptr)
+              , m_writes (composite_.fields().size(), nullptr)
+            {
+                (bind<I> (composite_), ...);
+
+                // anything but a primitive can hold objects that later
+                // values refer back to
+                for (size_t i { 0 } ; i < m_fields.size() ; ++i) {
+                    if (!m_fields[i]
+                        && composite_.fields()[i]->fieldType() != schema::FieldType::PrimitiveProperty)
+                    {
+                        m_fields[i] = &Bound::skip;
+                    }
+                }
+            }
+
+            template<size_t I>
+            static Bound<Member<I>>
+            member (const schema::Schema & schema_, const schema::Composite & composite_) {
+                const auto * name = std::get<I> (Fields<T>::fields).m_name;
+
+                try {
+                    return Bound<Member<I>> (
+                            schema_,
+                            fieldType (*composite_.fields()[fieldIndex (composite_, name)]));
+                } catch (const std::runtime_error & e) {
+                    throw std::runtime_error (
+                            composite_.name() + "." + name + ": " + e.what());
+                }
+            }
+
+            template<size_t I>
+            void bind (const schema::Composite & composite_) {
+                const auto * name = std::get<I> (Fields<T>::fields).m_name;
+                auto idx = fieldIndex (composite_, name);
+
+                if (m_fields[idx]) {
+                    throw std::runtime_error (
+                            std::string ("Field ") + name + " is bound twice");
+                }
+
+                // primitive properties can't be references
+                m_fields[idx] =
+                    composite_.fields()[idx]->fieldType() == schema::FieldType::PrimitiveProperty
+                        ? &Bound::template readProperty<I>
+                        : &Bound::template readObject<I>;
+
+                m_writes[idx] = &Bound::template writeMember<I>;
+            }
+
+            template<size_t I>
+            void readProperty (codec::Decoder * data_, T & value_) const {
+                std::get<I> (m_members).read (
+                        data_,
+                        value_.*(std::get<I> (Fields<T>::fields).m_member));
+            }
+
+            template<size_t I>
+            void readObject (codec::Decoder * data_, T & value_) const {
+                object (
+                        std::get<I> (m_members),
+                        data_,
+                        value_.*(std::get<I> (Fields<T>::fields).m_member));
+            }
+
+            /**
+             * The objects in a field we step over aren't counted, so
+             * none read after it can be found by index any more
+             */
+            void skip (codec::Decoder * data_, T &) const {
+                data_->forget();
+                data_->next();
+            }
+
+            template<size_t I>
+            void writeMember (codec::Encoder & data_, const T & value_) const {
+                std::get<I> (m_members).write (
+                        data_,
+                        value_.*(std::get<I> (Fields<T>::fields).m_member));
+            }
+
+        public :
+            Bound (const schema::Schema & schema_, const schema::Symbol & type_)
+                : Bound (schema_, asComposite (schema_, type_), std::make_index_sequence<N>())
+            { }
+
+            bool referenceable() const { return true; }
+
+            const std::string & descriptor() const { return m_descriptor; }
+
+            void read (codec::Decoder * data_, T & value_) const {
+                codec::auto_next an (data_);
+                codec::is_described (data_);
+                codec::auto_enter ae (data_);
+
+                checkDescriptor (data_, m_descriptor);
+
+                data_->next();
+                codec::is_list (data_);
+
+                codec::auto_enter ae2 (data_);
+
+                for (const auto read : m_fields) {
+                    if (read) {
+                        (this->*read) (data_, value_);
+                    } else {
+                        data_->next();
+                    }
+                }
+            }
+
+            void write (codec::Encoder & data_, const T & value_) const {
+                data_.described();
+                data_.putSymbol (m_descriptor);
+                data_.beginList();
+
+                for (const auto write : m_writes) {
+                    if (write) {
+                        (this->*write) (data_, value_);
+                    } else {
+                        data_.putNull();
+                    }
+                }
+
+                data_.endList();
+            }
+    };
+
+}
+
+/******************************************************************************/
+
+template<typename M>
+void
+amqp::internal::bind::
+object (const Bound<M> & bound_, codec::Decoder * data_, M & value_) {
+    auto referenced = reader::referenced (data_);
+
+    if (!referenced.empty()) {
+        codec::Decoder replay (referenced, *data_);
+        codec::auto_next an (data_);
+
+        bound_.read (&replay, value_);
+        return;
+    }
+
+    auto encoded = data_->raw();
+
+    bound_.read (data_, value_);
+
+    if (bound_.referenceable()) {
+        data_->remember (encoded);
+    }
+}
+
+/******************************************************************************
+ *
+ * Binding
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::bind {
+
+    const schema::Symbol & typeOf (const schema::Schema &, const std::string &);
+
+    /**
+     * A struct bound to the type with a given descriptor in a schema. It
+     * can be used to read any blob with that schema, or write one, from
+     * any thread
+     */
+    template<typename T>
+    class Binding {
+        static_assert (isBound<T>::value, "Bind the type with AMQP_BIND first");
+
+        private :
+            Bound<T> m_bound;
+
+        public :
+            Binding (const schema::Schema & schema_, const std::string & descriptor_)
+                : m_bound (schema_, typeOf (schema_, descriptor_))
+            { }
+
+            /**
+             * A lazily materialising cache only has what it's been
+             * asked for, so make sure it has the type first, and that
+             * nothing else is materialised while we're binding
+             */
+            Binding (const SchemaCache::Entry & entry_, const std::string & descriptor_)
+                : m_bound (entry_.locked (descriptor_, [&] (const schema::Schema & schema_) {
+                      return Bound<T> (schema_, typeOf (schema_, descriptor_));
+                  }))
+            { }
+
+            /**
+             * With the decoder positioned on a value of the bound type
+             * read it, and move past it
+             */
+            void read (codec::Decoder * data_, T & value_) const {
+                m_bound.read (data_, value_);
+            }
+
+            T read (codec::Decoder * data_) const {
+                T value { };
+                read (data_, value);
+                return value;
+            }
+
+            /**
+             * Write [value_] as the JVM would have, see serialiser::Serialiser
+             * for wrapping that up as a blob
+             */
+            void write (codec::Encoder & data_, const T & value_) const {
+                m_bound.write (data_, value_);
+            }
+
+            const std::string & descriptor() const {
+                return m_bound.descriptor();
+            }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,88 @@
+#include "AMQPTypes.h"
+
+/******************************************************************************/
+
+amqp::codec::amqp_type_t
+amqp::codec::typeOf (uint8_t formatCode_) {
+    switch (formatCode_) {
+        case FC_DESCRIBED  : return AMQP_DESCRIBED;
+        case FC_NULL       : return AMQP_NULL;
+        case FC_TRUE       :
+        case FC_FALSE      :
+        case FC_BOOLEAN    : return AMQP_BOOL;
+        case FC_UBYTE      : return AMQP_UBYTE;
+        case FC_BYTE       : return AMQP_BYTE;
+        case FC_USHORT     : return AMQP_USHORT;
+        case FC_SHORT      : return AMQP_SHORT;
+        case FC_UINT0      :
+        case FC_SMALLUINT  :
+        case FC_UINT       : return AMQP_UINT;
+        case FC_SMALLINT   :
+        case FC_INT        : return AMQP_INT;
+        case FC_CHAR       : return AMQP_CHAR;
+        case FC_ULONG0     :
+        case FC_SMALLULONG :
+        case FC_ULONG      : return AMQP_ULONG;
+        case FC_SMALLLONG  :
+        case FC_LONG       : return AMQP_LONG;
+        case FC_TIMESTAMP  : return AMQP_TIMESTAMP;
+        case FC_FLOAT      : return AMQP_FLOAT;
+        case FC_DOUBLE     : return AMQP_DOUBLE;
+        case FC_DECIMAL32  : return AMQP_DECIMAL32;
+        case FC_DECIMAL64  : return AMQP_DECIMAL64;
+        case FC_DECIMAL128 : return AMQP_DECIMAL128;
+        case FC_UUID       : return AMQP_UUID;
+        case FC_VBIN8      :
+        case FC_VBIN32     : return AMQP_BINARY;
+        case FC_STR8       :
+        case FC_STR32      : return AMQP_STRING;
+        case FC_SYM8       :
+        case FC_SYM32      : return AMQP_SYMBOL;
+        case FC_LIST0      :
+        case FC_LIST8      :
+        case FC_LIST32     : return AMQP_LIST;
+        case FC_MAP8       :
+        case FC_MAP32      : return AMQP_MAP;
+        case FC_ARRAY8     :
+        case FC_ARRAY32    : return AMQP_ARRAY;
+        default            : return AMQP_INVALID;
+    }
+}
+
+/******************************************************************************/
+
+const char *
+amqp::codec::typeName (amqp_type_t type_) {
+    switch (type_) {
+        case AMQP_NULL       : return "null";
+        case AMQP_BOOL       : return "bool";
+        case AMQP_UBYTE      : return "ubyte";
+        case AMQP_BYTE       : return "byte";
+        case AMQP_USHORT     : return "ushort";
+        case AMQP_SHORT      : return "short";
+        case AMQP_UINT       : return "uint";
+        case AMQP_INT        : return "int";
+        case AMQP_CHAR       : return "char";
+        case AMQP_ULONG      : return "ulong";
+        case AMQP_LONG       : return "long";
+        case AMQP_TIMESTAMP  : return "timestamp";
+        case AMQP_FLOAT      : return "float";
+        case AMQP_DOUBLE     : return "double";
+        case AMQP_DECIMAL32  : return "decimal32";
+        case AMQP_DECIMAL64  : return "decimal64";
+        case AMQP_DECIMAL128 : return "decimal128";
+        case AMQP_UUID       : return "uuid";
+        case AMQP_BINARY     : return "binary";
+        case AMQP_STRING     : return "string";
+        case AMQP_SYMBOL     : return "symbol";
+        case AMQP_DESCRIBED  : return "described";
+        case AMQP_ARRAY      : return "array";
+        case AMQP_LIST       : return "list";
+        case AMQP_MAP        : return "map";
+        case AMQP_INVALID    : break;
+    }
+
+    return "invalid";
+}
+
+/******************************************************************************/
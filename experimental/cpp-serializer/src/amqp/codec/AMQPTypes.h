@@ -0,0 +1,117 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstdint>
+
+/******************************************************************************/
+
+/**
+ * The AMQP 1.0 type system as it appears on the wire, see part 1.6 of the
+ * AMQP 1.0 specification.
+ *
+ * Every value in the stream starts with a one byte constructor (the format
+ * code) that tells us both its type and how wide its encoding is. The
+ * exception being elements of an array which share a single constructor
+ * written once before the first element.
+ */
+namespace amqp::codec {
+
+    enum amqp_format_code_t : uint8_t {
+        FC_DESCRIBED   = 0x00,
+
+        FC_NULL        = 0x40,
+        FC_TRUE        = 0x41,
+        FC_FALSE       = 0x42,
+        FC_UINT0       = 0x43,
+        FC_ULONG0      = 0x44,
+        FC_LIST0       = 0x45,
+
+        FC_UBYTE       = 0x50,
+        FC_BYTE        = 0x51,
+        FC_SMALLUINT   = 0x52,
+        FC_SMALLULONG  = 0x53,
+        FC_SMALLINT    = 0x54,
+        FC_SMALLLONG   = 0x55,
+        FC_BOOLEAN     = 0x56,
+
+        FC_USHORT      = 0x60,
+        FC_SHORT       = 0x61,
+
+        FC_UINT        = 0x70,
+        FC_INT         = 0x71,
+        FC_FLOAT       = 0x72,
+        FC_CHAR        = 0x73,
+        FC_DECIMAL32   = 0x74,
+
+        FC_ULONG       = 0x80,
+        FC_LONG        = 0x81,
+        FC_DOUBLE      = 0x82,
+        FC_TIMESTAMP   = 0x83,
+        FC_DECIMAL64   = 0x84,
+
+        FC_DECIMAL128  = 0x94,
+        FC_UUID        = 0x98,
+
+        FC_VBIN8       = 0xa0,
+        FC_STR8        = 0xa1,
+        FC_SYM8        = 0xa3,
+
+        FC_VBIN32      = 0xb0,
+        FC_STR32       = 0xb1,
+        FC_SYM32       = 0xb3,
+
+        FC_LIST8       = 0xc0,
+        FC_MAP8        = 0xc1,
+
+        FC_LIST32      = 0xd0,
+        FC_MAP32       = 0xd1,
+
+        FC_ARRAY8      = 0xe0,
+        FC_ARRAY32     = 0xf0
+    };
+
+    /**
+     * The logical type of a value, collapsing the various compact encodings
+     * of the same type (smallint / int, list0 / list8 / list32, etc) into
+     * one.
+     *
+     * Values deliberately match proton's pn_type_t as the descriptor
+     * registry has historically been keyed on them.
+     */
+    enum amqp_type_t {
+        AMQP_INVALID = -1,
+        AMQP_NULL = 1,
+        AMQP_BOOL,
+        AMQP_UBYTE,
+        AMQP_BYTE,
+        AMQP_USHORT,
+        AMQP_SHORT,
+        AMQP_UINT,
+        AMQP_INT,
+        AMQP_CHAR,
+        AMQP_ULONG,
+        AMQP_LONG,
+        AMQP_TIMESTAMP,
+        AMQP_FLOAT,
+        AMQP_DOUBLE,
+        AMQP_DECIMAL32,
+        AMQP_DECIMAL64,
+        AMQP_DECIMAL128,
+        AMQP_UUID,
+        AMQP_BINARY,
+        AMQP_STRING,
+        AMQP_SYMBOL,
+        AMQP_DESCRIBED,
+        AMQP_ARRAY,
+        AMQP_LIST,
+        AMQP_MAP
+    };
+
+    amqp_type_t typeOf (uint8_t formatCode_);
+
+    const char * typeName (amqp_type_t);
+
+}
+
+/******************************************************************************/
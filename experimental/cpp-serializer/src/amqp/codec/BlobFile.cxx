@@ -0,0 +1,207 @@
+#include "BlobFile.h"
+
+#include <cerrno>
+#include <algorithm>
+#include <filesystem>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Closes a descriptor we opened on the way out whichever path we
+     * took, a mapping stays valid after its descriptor is closed. One
+     * we were handed, stdin, is left open. Whatever number open gave
+     * us is ours, it's 0 to 2 if those had been closed
+     */
+    class auto_close {
+        private :
+            int  m_fd;
+            bool m_owned;
+
+        public :
+            auto_close (int fd_, bool owned_) : m_fd (fd_), m_owned (owned_) { }
+
+            ~auto_close() {
+                if (m_owned) {
+                    ::close (m_fd);
+                }
+            }
+    };
+
+    std::string
+    error (const std::string & what_, const std::string & path_) {
+        return what_ + " \"" + path_ + "\": " + strerror (errno);
+    }
+
+}
+
+/******************************************************************************
+ *
+ * class BlobFile
+ *
+ ******************************************************************************/
+
+amqp::codec::
+BlobFile::BlobFile (const std::string & path_)
+    : m_data (nullptr)
+    , m_size (0)
+    , m_mapped (nullptr)
+{
+    bool fromStdin = (path_ == "-");
+
+    int fd = fromStdin
+            ? STDIN_FILENO
+            : ::open (path_.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        throw std::runtime_error (error ("Failed to open", path_));
+    }
+
+    auto_close ac (fd, !fromStdin);
+
+    struct stat results { };
+
+    if (::fstat (fd, &results) != 0) {
+        throw std::runtime_error (error ("Failed to stat", path_));
+    }
+
+    if (S_ISREG (results.st_mode) && results.st_size > 0) {
+        void * addr = ::mmap (
+                nullptr, results.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (addr != MAP_FAILED) {
+            // we walk the blob front to back so let the kernel read ahead
+            ::madvise (addr, results.st_size, MADV_SEQUENTIAL);
+
+            m_mapped = addr;
+            m_data = static_cast<const char *> (addr);
+            m_size = results.st_size;
+
+            return;
+        }
+    }
+
+    slurp (fd, path_);
+}
+
+/******************************************************************************/
+
+amqp::codec::
+BlobFile::BlobFile (BlobFile && rhs_) noexcept
+    : m_data (rhs_.m_data)
+    , m_size (rhs_.m_size)
+    , m_mapped (rhs_.m_mapped)
+    , m_buffer (std::move (rhs_.m_buffer))
+{
+    if (!m_mapped) {
+        m_data = m_buffer.data();
+    }
+
+    rhs_.m_data = nullptr;
+    rhs_.m_size = 0;
+    rhs_.m_mapped = nullptr;
+}
+
+/******************************************************************************/
+
+amqp::codec::
+BlobFile::~BlobFile() {
+    if (m_mapped) {
+        ::munmap (m_mapped, m_size);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Fallback for anything we can't map, read until EOF growing the buffer
+ * as we go
+ */
+void
+amqp::codec::
+BlobFile::slurp (int fd_, const std::string & path_) {
+    size_t used { 0 };
+    m_buffer.resize (64 * 1024);
+
+    for (;;) {
+        if (used == m_buffer.size()) {
+            m_buffer.resize (m_buffer.size() * 2);
+        }
+
+        auto rc = ::read (fd_, m_buffer.data() + used, m_buffer.size() - used);
+
+        if (rc == 0) {
+            break;
+        } else if (rc < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error (error ("Failed to read", path_));
+        }
+
+        used += rc;
+    }
+
+    m_buffer.resize (used);
+    m_data = m_buffer.data();
+    m_size = used;
+}
+
+/******************************************************************************/
+
+const char *
+amqp::codec::
+BlobFile::data() const {
+    return m_data;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::codec::
+BlobFile::size() const {
+    return m_size;
+}
+
+/******************************************************************************/
+
+bool
+amqp::codec::
+BlobFile::mapped() const {
+    return m_mapped != nullptr;
+}
+
+/******************************************************************************/
+
+std::vector<std::string>
+amqp::codec::
+expand (const std::vector<std::string> & paths_) {
+    namespace fs = std::filesystem;
+
+    std::vector<std::string> files;
+
+    for (const auto & path : paths_) {
+        if (path != "-" && fs::is_directory (path)) {
+            std::vector<std::string> found;
+            for (const auto & entry : fs::recursive_directory_iterator (path)) {
+                if (entry.is_regular_file()) {
+                    found.emplace_back (entry.path().string());
+                }
+            }
+            std::sort (found.begin(), found.end());
+            files.insert (files.end(), found.begin(), found.end());
+        } else {
+            files.emplace_back (path);
+        }
+    }
+
+    return files;
+}
+
+/******************************************************************************/
@@ -0,0 +1,65 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/******************************************************************************/
+
+/**
+ * Read only access to the bytes of a serialised blob on disk.
+ *
+ * Regular files are mapped straight into memory so the decoder can walk
+ * them in place without us ever copying the blob. Anything that can't be
+ * mapped, pipes and the like, is read into a buffer we own instead. Either
+ * way the memory is released when the BlobFile goes out of scope.
+ *
+ * A path of "-" reads from stdin.
+ */
+namespace amqp::codec {
+
+    class BlobFile {
+        private :
+            const char * m_data;
+            size_t       m_size;
+
+            /**
+             * Set when we managed to mmap the file
+             */
+            void * m_mapped;
+
+            /**
+             * Otherwise this holds the contents
+             */
+            std::vector<char> m_buffer;
+
+            void slurp (int, const std::string &);
+
+        public :
+            explicit BlobFile (const std::string &);
+            ~BlobFile();
+
+            BlobFile (const BlobFile &) = delete;
+            BlobFile & operator = (const BlobFile &) = delete;
+
+            BlobFile (BlobFile &&) noexcept;
+            BlobFile & operator = (BlobFile &&) = delete;
+
+            const char * data() const;
+            size_t size() const;
+
+            bool mapped() const;
+    };
+
+    /**
+     * [paths_] with each directory replaced by every regular file beneath
+     * it, sorted so the order doesn't depend on the filesystem. Anything
+     * else, "-" included, is left as it is
+     */
+    std::vector<std::string> expand (const std::vector<std::string> & paths_);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,973 @@
+#include "Decoder.h"
+
+#include <limits>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <exception>
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+
+}
+
+/******************************************************************************
+ *
+ * amqp::codec::Decoder
+ *
+ ******************************************************************************/
+
+amqp::codec::
+Decoder::Decoder (
+    const char * data_,
+    size_t size_
+) : m_data (data_)
+  , m_size (size_)
+  , m_current { 0, 0, 0, 0 }
+  , m_positioned (false)
+  , m_ownObjects { { }, UNBOUNDED }
+  , m_objects (&m_ownObjects)
+  , m_replaying (false)
+{
+    /*
+     * The top level isn't contained by anything, all we know is
+     * where the buffer ends
+     */
+    m_stack.push_back (Frame { m_current, 0, m_size, UNBOUNDED, 0 });
+
+    next();
+}
+
+/******************************************************************************/
+
+amqp::codec::
+Decoder::Decoder (
+    std::string_view encoded_,
+    Decoder & parent_
+) : Decoder (encoded_.data(), encoded_.size())
+{
+    m_objects = parent_.m_objects;
+    m_replaying = true;
+}
+
+/******************************************************************************/
+
+const unsigned char *
+amqp::codec::
+Decoder::ptr (size_t offset_, size_t len_) const {
+    if (offset_ > m_size || len_ > m_size - offset_) {
+        std::stringstream ss;
+        ss << "Truncated AMQP stream, wanted " << len_ << " bytes at "
+           << offset_ << " of " << m_size;
+        throw std::runtime_error (ss.str());
+    }
+
+    return reinterpret_cast<const unsigned char *>(m_data + offset_);
+}
+
+/******************************************************************************/
+
+uint8_t
+amqp::codec::
+Decoder::byte (size_t offset_) const {
+    return *ptr (offset_, 1);
+}
+
+/******************************************************************************/
+
+uint16_t
+amqp::codec::
+Decoder::u16 (size_t offset_) const {
+    auto p = ptr (offset_, 2);
+    return static_cast<uint16_t>((p[0] << 8U) | p[1]);
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::codec::
+Decoder::u32 (size_t offset_) const {
+    auto p = ptr (offset_, 4);
+    return   (static_cast<uint32_t>(p[0]) << 24U)
+           | (static_cast<uint32_t>(p[1]) << 16U)
+           | (static_cast<uint32_t>(p[2]) << 8U)
+           |  static_cast<uint32_t>(p[3]);
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::codec::
+Decoder::u64 (size_t offset_) const {
+    return (static_cast<uint64_t>(u32 (offset_)) << 32U) | u32 (offset_ + 4);
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::codec::
+Decoder::view (size_t offset_, size_t len_) const {
+    return std::string_view (
+            reinterpret_cast<const char *>(ptr (offset_, len_)),
+            len_);
+}
+
+/******************************************************************************/
+
+/**
+ * Build the node that starts at [offset_]. Inside an array the elements
+ * inherit the array's element constructor, everywhere else the first byte
+ * of the node is its constructor
+ */
+amqp::codec::Decoder::Node
+amqp::codec::
+Decoder::at (size_t offset_, size_t index_) const {
+    const auto element = m_stack.back().m_element;
+
+    if (element) {
+        return Node { offset_, offset_, index_, element };
+    } else {
+        return Node { offset_, offset_ + 1, index_, byte (offset_) };
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Work out where a node finishes using nothing but its constructor and, for
+ * variable width types, the size prefix. The only thing we have to actually
+ * walk is a described type as that's a pair of values with no overall
+ * size of its own.
+ */
+size_t
+amqp::codec::
+Decoder::end (const Node & node_) const {
+    if (node_.m_code == FC_DESCRIBED) {
+        Node descriptor { node_.m_body, node_.m_body + 1, 0, byte (node_.m_body) };
+        auto valueAt = end (descriptor);
+        Node value { valueAt, valueAt + 1, 1, byte (valueAt) };
+
+        return end (value);
+    }
+
+    size_t rtn;
+
+    switch (node_.m_code >> 4U) {
+        case 0x4 : rtn = node_.m_body;      break;
+        case 0x5 : rtn = node_.m_body + 1;  break;
+        case 0x6 : rtn = node_.m_body + 2;  break;
+        case 0x7 : rtn = node_.m_body + 4;  break;
+        case 0x8 : rtn = node_.m_body + 8;  break;
+        case 0x9 : rtn = node_.m_body + 16; break;
+        case 0xa :
+        case 0xc :
+        case 0xe : rtn = node_.m_body + 1 + byte (node_.m_body); break;
+        case 0xb :
+        case 0xd :
+        case 0xf : rtn = node_.m_body + 4 + u32 (node_.m_body); break;
+        default : {
+            std::stringstream ss;
+            ss << "Invalid AMQP format code 0x" << std::hex
+               << static_cast<int>(node_.m_code) << " at " << std::dec
+               << node_.m_offset;
+            throw std::runtime_error (ss.str());
+        }
+    }
+
+    if (rtn > m_size) {
+        throw std::runtime_error ("Truncated AMQP stream");
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+bool
+amqp::codec::
+Decoder::next() {
+    const auto & frame = m_stack.back();
+
+    if (!m_positioned) {
+        if (frame.m_count == 0 || frame.m_first >= frame.m_end) {
+            return false;
+        }
+
+        m_current = at (frame.m_first, 0);
+        m_positioned = true;
+
+        return true;
+    }
+
+    if (m_current.m_index + 1 >= frame.m_count) {
+        return false;
+    }
+
+    auto next = end (m_current);
+
+    if (next > frame.m_end) {
+        throw std::runtime_error ("Malformed AMQP stream, child overruns parent");
+    }
+
+    /*
+     * Only the top level doesn't know how many values it holds
+     */
+    if (frame.m_count == UNBOUNDED && next == frame.m_end) {
+        return false;
+    }
+
+    m_current = at (next, m_current.m_index + 1);
+
+    return true;
+}
+
+/******************************************************************************/
+
+bool
+amqp::codec::
+Decoder::enter() {
+    if (!m_positioned) {
+        return false;
+    }
+
+    const auto body = m_current.m_body;
+
+    Frame frame { m_current, body, body, 0, 0 };
+
+    switch (m_current.m_code) {
+        case FC_DESCRIBED : {
+            frame.m_end = end (m_current);
+            frame.m_count = 2;
+            break;
+        }
+        case FC_LIST8 :
+        case FC_MAP8 : {
+            frame.m_first = body + 2;
+            frame.m_end = body + 1 + byte (body);
+            frame.m_count = byte (body + 1);
+            break;
+        }
+        case FC_LIST32 :
+        case FC_MAP32 : {
+            frame.m_first = body + 8;
+            frame.m_end = body + 4 + u32 (body);
+            frame.m_count = u32 (body + 4);
+            break;
+        }
+        case FC_ARRAY8 : {
+            frame.m_first = body + 3;
+            frame.m_end = body + 1 + byte (body);
+            frame.m_count = byte (body + 1);
+            frame.m_element = byte (body + 2);
+            break;
+        }
+        case FC_ARRAY32 : {
+            frame.m_first = body + 9;
+            frame.m_end = body + 4 + u32 (body);
+            frame.m_count = u32 (body + 4);
+            frame.m_element = byte (body + 8);
+            break;
+        }
+        default : {
+            // scalars, and the empty list, have no children
+            break;
+        }
+    }
+
+    if (frame.m_end > m_size) {
+        throw std::runtime_error ("Truncated AMQP stream");
+    }
+
+    if (frame.m_element == FC_DESCRIBED
+        && (m_current.m_code == FC_ARRAY8 || m_current.m_code == FC_ARRAY32))
+    {
+        throw std::runtime_error ("Arrays of described types are not supported");
+    }
+
+    m_stack.push_back (frame);
+    m_positioned = false;
+
+    return true;
+}
+
+/******************************************************************************/
+
+bool
+amqp::codec::
+Decoder::exit() {
+    if (m_stack.size() == 1) {
+        return false;
+    }
+
+    m_current = m_stack.back().m_parent;
+    m_positioned = true;
+    m_stack.pop_back();
+
+    return true;
+}
+
+/******************************************************************************/
+
+amqp::codec::amqp_type_t
+amqp::codec::
+Decoder::type() const {
+    return m_positioned ? typeOf (m_current.m_code) : AMQP_INVALID;
+}
+
+/******************************************************************************/
+
+uint8_t
+amqp::codec::
+Decoder::formatCode() const {
+    return m_current.m_code;
+}
+
+/******************************************************************************/
+
+bool
+amqp::codec::
+Decoder::isDescribed() const {
+    return m_positioned && m_current.m_code == FC_DESCRIBED;
+}
+
+/******************************************************************************/
+
+bool
+amqp::codec::
+Decoder::getBool() const {
+    switch (m_current.m_code) {
+        case FC_TRUE    : return true;
+        case FC_BOOLEAN : return byte (m_current.m_body) != 0;
+        default         : return false;
+    }
+}
+
+/******************************************************************************/
+
+uint8_t
+amqp::codec::
+Decoder::getUByte() const {
+    return m_current.m_code == FC_UBYTE ? byte (m_current.m_body) : 0;
+}
+
+/******************************************************************************/
+
+int8_t
+amqp::codec::
+Decoder::getByte() const {
+    return m_current.m_code == FC_BYTE
+        ? static_cast<int8_t>(byte (m_current.m_body))
+        : 0;
+}
+
+/******************************************************************************/
+
+uint16_t
+amqp::codec::
+Decoder::getUShort() const {
+    return m_current.m_code == FC_USHORT ? u16 (m_current.m_body) : 0;
+}
+
+/******************************************************************************/
+
+int16_t
+amqp::codec::
+Decoder::getShort() const {
+    return m_current.m_code == FC_SHORT
+        ? static_cast<int16_t>(u16 (m_current.m_body))
+        : 0;
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::codec::
+Decoder::getUInt() const {
+    switch (m_current.m_code) {
+        case FC_SMALLUINT : return byte (m_current.m_body);
+        case FC_UINT      : return u32 (m_current.m_body);
+        default           : return 0;
+    }
+}
+
+/******************************************************************************/
+
+int32_t
+amqp::codec::
+Decoder::getInt() const {
+    switch (m_current.m_code) {
+        case FC_SMALLINT : return static_cast<int8_t>(byte (m_current.m_body));
+        case FC_INT      : return static_cast<int32_t>(u32 (m_current.m_body));
+        default          : return 0;
+    }
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::codec::
+Decoder::getChar() const {
+    return m_current.m_code == FC_CHAR ? u32 (m_current.m_body) : 0;
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::codec::
+Decoder::getULong() const {
+    switch (m_current.m_code) {
+        case FC_SMALLULONG : return byte (m_current.m_body);
+        case FC_ULONG      : return u64 (m_current.m_body);
+        default            : return 0;
+    }
+}
+
+/******************************************************************************/
+
+int64_t
+amqp::codec::
+Decoder::getLong() const {
+    switch (m_current.m_code) {
+        case FC_SMALLLONG : return static_cast<int8_t>(byte (m_current.m_body));
+        case FC_LONG      : return static_cast<int64_t>(u64 (m_current.m_body));
+        default           : return 0;
+    }
+}
+
+/******************************************************************************/
+
+int64_t
+amqp::codec::
+Decoder::getTimestamp() const {
+    return m_current.m_code == FC_TIMESTAMP
+        ? static_cast<int64_t>(u64 (m_current.m_body))
+        : 0;
+}
+
+/******************************************************************************/
+
+float
+amqp::codec::
+Decoder::getFloat() const {
+    float rtn { 0 };
+
+    if (m_current.m_code == FC_FLOAT) {
+        auto bits = u32 (m_current.m_body);
+        std::memcpy (&rtn, &bits, sizeof (rtn));
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+double
+amqp::codec::
+Decoder::getDouble() const {
+    double rtn { 0 };
+
+    if (m_current.m_code == FC_DOUBLE) {
+        auto bits = u64 (m_current.m_body);
+        std::memcpy (&rtn, &bits, sizeof (rtn));
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::codec::
+Decoder::getString() const {
+    const auto body = m_current.m_body;
+
+    switch (m_current.m_code) {
+        case FC_STR8  : return view (body + 1, byte (body));
+        case FC_STR32 : return view (body + 4, u32 (body));
+        default       : return { };
+    }
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::codec::
+Decoder::getSymbol() const {
+    const auto body = m_current.m_body;
+
+    switch (m_current.m_code) {
+        case FC_SYM8  : return view (body + 1, byte (body));
+        case FC_SYM32 : return view (body + 4, u32 (body));
+        default       : return { };
+    }
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::codec::
+Decoder::getBinary() const {
+    const auto body = m_current.m_body;
+
+    switch (m_current.m_code) {
+        case FC_VBIN8  : return view (body + 1, byte (body));
+        case FC_VBIN32 : return view (body + 4, u32 (body));
+        default        : return { };
+    }
+}
+
+/******************************************************************************/
+
+size_t
+amqp::codec::
+Decoder::getList() const {
+    switch (m_current.m_code) {
+        case FC_LIST8  : return byte (m_current.m_body + 1);
+        case FC_LIST32 : return u32 (m_current.m_body + 4);
+        default        : return 0;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Like proton this is the number of elements in the map, that is twice
+ * the number of key / value pairs
+ */
+size_t
+amqp::codec::
+Decoder::getMap() const {
+    switch (m_current.m_code) {
+        case FC_MAP8  : return byte (m_current.m_body + 1);
+        case FC_MAP32 : return u32 (m_current.m_body + 4);
+        default       : return 0;
+    }
+}
+
+/******************************************************************************/
+
+size_t
+amqp::codec::
+Decoder::getArray() const {
+    switch (m_current.m_code) {
+        case FC_ARRAY8  : return byte (m_current.m_body + 1);
+        case FC_ARRAY32 : return u32 (m_current.m_body + 4);
+        default         : return 0;
+    }
+}
+
+/******************************************************************************/
+
+size_t
+amqp::codec::
+Decoder::offset() const {
+    return m_current.m_offset;
+}
+
+/******************************************************************************/
+
+/**
+ * For array elements, which don't carry their own constructor, this is
+ * just the encoded value
+ */
+std::string_view
+amqp::codec::
+Decoder::raw() const {
+    if (!m_positioned) {
+        return { };
+    }
+
+    return view (m_current.m_offset, end (m_current) - m_current.m_offset);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::codec::
+Decoder::depth() const {
+    return m_stack.size() - 1;
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Decoder::remember (std::string_view encoded_) {
+    if (!m_replaying) {
+        m_objects->m_encoded.push_back (encoded_);
+    }
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::codec::
+Decoder::recall (size_t index_) const {
+    if (index_ >= m_objects->m_known) {
+        throw std::runtime_error (
+                "Cannot follow a reference to an object after a value that"
+                " wasn't read, read the blob without a projection");
+    }
+
+    if (index_ >= m_objects->m_encoded.size()) {
+        std::stringstream ss;
+        ss << "Reference to object " << index_ << " but only "
+           << m_objects->m_encoded.size() << " have been read";
+        throw std::runtime_error (ss.str());
+    }
+
+    return m_objects->m_encoded[index_];
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Decoder::forget() {
+    if (!m_replaying) {
+        m_objects->m_known = std::min (m_objects->m_known, m_objects->m_encoded.size());
+    }
+}
+
+/******************************************************************************
+ *
+ * Non member functions
+ *
+ ******************************************************************************/
+
+std::ostream &
+amqp::codec::operator << (std::ostream & stream_, Decoder * data_) {
+    auto type = data_->type();
+
+    stream_ << std::setw (2) << type << " " << typeName (type);
+
+    switch (type) {
+        case AMQP_ULONG : {
+            stream_ << " " << data_->getULong();
+            break;
+        }
+        case AMQP_LIST : {
+            stream_ << " #entries: " << data_->getList();
+            break;
+        }
+        case AMQP_STRING : {
+            stream_ << " " << data_->getString();
+            break;
+        }
+        case AMQP_INT : {
+            stream_ << " " << data_->getInt();
+            break;
+        }
+        case AMQP_BOOL : {
+            stream_ << " " << (data_->getBool() ? "true" : "false");
+            break;
+        }
+        case AMQP_SYMBOL : {
+            stream_ << " " << data_->getSymbol();
+            break;
+        }
+        default : break;
+    }
+
+    return stream_;
+}
+
+/******************************************************************************/
+
+bool
+amqp::codec::enter (Decoder * data_) {
+    data_->enter();
+    return data_->next();
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::is_described (Decoder * data_) {
+    if (data_->type() != AMQP_DESCRIBED) {
+        throw std::runtime_error ("Expected a described type");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::is_ulong (Decoder * data_) {
+    auto t = data_->type();
+    if (t != AMQP_ULONG) {
+        std::stringstream ss;
+        ss << "Expected an unsigned long but received " << typeName (t);
+        throw std::runtime_error (ss.str());
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::is_symbol (Decoder * data_) {
+    if (data_->type() != AMQP_SYMBOL) {
+        throw std::runtime_error ("Expected a symbol");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::is_map (Decoder * data_) {
+    if (data_->type() != AMQP_MAP) {
+        throw std::runtime_error ("Expected a map");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::is_list (Decoder * data_) {
+    if (data_->type() != AMQP_LIST) {
+        throw std::runtime_error ("Expected a list");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::is_string (Decoder * data_, bool allowNull_) {
+    auto t = data_->type();
+    if (t != AMQP_STRING && !(allowNull_ && t == AMQP_NULL)) {
+        throw std::runtime_error ("Expected a String");
+    }
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::codec::get_string (Decoder * data_, bool allowNull_) {
+    auto t = data_->type();
+    if (t == AMQP_STRING) {
+        return data_->getString();
+    } else if (allowNull_ && t == AMQP_NULL) {
+        return { };
+    }
+    throw std::runtime_error ("Expected a String");
+}
+
+/******************************************************************************/
+
+template<>
+std::string
+amqp::codec::get_symbol<std::string> (Decoder * data_) {
+    is_symbol (data_);
+    return std::string { data_->getSymbol() };
+}
+
+template<>
+std::string_view
+amqp::codec::get_symbol<std::string_view> (Decoder * data_) {
+    is_symbol (data_);
+    return data_->getSymbol();
+}
+
+/******************************************************************************/
+
+bool
+amqp::codec::get_boolean (Decoder * data_) {
+    if (data_->type() == AMQP_BOOL) {
+        return data_->getBool();
+    }
+    throw std::runtime_error ("Expected a boolean");
+}
+
+/******************************************************************************
+ *
+ * amqp::codec::auto_enter
+ *
+ ******************************************************************************/
+
+amqp::codec::
+auto_enter::auto_enter (Decoder * data_, bool next_)
+    : m_data (data_)
+{
+    codec::enter (m_data);
+    if (next_) m_data->next();
+}
+
+/******************************************************************************/
+
+amqp::codec::
+auto_enter::~auto_enter() {
+    m_data->exit();
+}
+
+/******************************************************************************
+ *
+ * amqp::codec::auto_next
+ *
+ ******************************************************************************/
+
+amqp::codec::
+auto_next::auto_next (
+    Decoder * data_
+) : m_data (data_)
+  , m_exceptions (std::uncaught_exceptions())
+{
+}
+
+/******************************************************************************/
+
+amqp::codec::
+auto_next::~auto_next() noexcept (false) {
+    if (std::uncaught_exceptions() == m_exceptions) {
+        m_data->next();
+    }
+}
+
+/******************************************************************************
+ *
+ * amqp::codec::auto_list_enter
+ *
+ ******************************************************************************/
+
+amqp::codec::
+auto_list_enter::auto_list_enter (Decoder * data_, bool next_)
+    : m_elements (data_->getList())
+    , m_data (data_)
+{
+    m_data->enter();
+    if (next_) {
+        m_data->next();
+    }
+}
+
+/******************************************************************************/
+
+amqp::codec::
+auto_list_enter::~auto_list_enter() {
+    m_data->exit();
+}
+
+/******************************************************************************/
+
+size_t
+amqp::codec::
+auto_list_enter::elements() const {
+    return m_elements;
+}
+
+/******************************************************************************
+ *
+ *
+ *
+ ******************************************************************************/
+
+template<>
+int32_t
+amqp::codec::
+readAndNext<int32_t> (
+    Decoder * data_,
+    bool tolerateDeviance_
+) {
+    auto rtn = data_->getInt();
+    data_->next();
+    return rtn;
+}
+
+/******************************************************************************/
+
+template<>
+std::string_view
+amqp::codec::
+readAndNext<std::string_view> (
+    Decoder * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+
+    switch (data_->type()) {
+        case AMQP_STRING : return data_->getString();
+        case AMQP_SYMBOL : return data_->getSymbol();
+        case AMQP_NULL   : {
+            if (tolerateDeviance_) return { };
+            break;
+        }
+        default : break;
+    }
+
+    std::stringstream ss;
+    ss << "Expected a String but found [" << data_ << "]";
+    throw std::runtime_error (ss.str());
+}
+
+/******************************************************************************/
+
+template<>
+std::string
+amqp::codec::
+readAndNext<std::string> (
+    Decoder * data_,
+    bool tolerateDeviance_
+) {
+    return std::string { readAndNext<std::string_view> (data_, tolerateDeviance_) };
+}
+
+/******************************************************************************/
+
+template<>
+bool
+amqp::codec::
+readAndNext<bool> (
+    Decoder * data_,
+    bool tolerateDeviance_
+) {
+    auto rtn = data_->getBool();
+    data_->next();
+    return rtn;
+}
+
+/******************************************************************************/
+
+template<>
+double
+amqp::codec::
+readAndNext<double> (
+    Decoder * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+    return data_->getDouble();
+}
+
+/******************************************************************************/
+
+template<>
+long
+amqp::codec::
+readAndNext<long> (
+    Decoder * data_,
+    bool tolerateDeviance_
+) {
+    long rtn = data_->getLong();
+    data_->next();
+    return rtn;
+}
+
+/******************************************************************************/
+
+template<>
+u_long
+amqp::codec::
+readAndNext<u_long> (
+    Decoder * data_,
+    bool tolerateDeviance_
+) {
+    u_long rtn = data_->getULong();
+    data_->next();
+    return rtn;
+}
+
+/******************************************************************************/
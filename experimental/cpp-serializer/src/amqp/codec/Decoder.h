@@ -0,0 +1,298 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <sys/types.h>
+
+#include "AMQPTypes.h"
+
+/******************************************************************************/
+
+/**
+ * A zero copy AMQP 1.0 decoder that walks a raw encoded buffer in place.
+ *
+ * It presents the same navigational model as the proton pn_data_t tree
+ * the rest of the code base was originally written against (next, enter
+ * and exit, where entering a node positions us *before* its first child)
+ * but rather than decoding the whole blob into a tree of nodes up front
+ * the cursor simply tracks byte offsets into the buffer. Moving to the next
+ * sibling uses the encoded size of the current node to jump over it, so
+ * skipping a subtree never visits its children, and strings, symbols and
+ * binaries are handed back as views into the buffer rather than copies.
+ *
+ * The decoder does not own the buffer, it must outlive the decoder.
+ */
+namespace amqp::codec {
+
+    class Decoder {
+        private :
+            /**
+             * A node is where a value starts in the buffer, its (possibly
+             * inherited, for array elements) constructor and where its
+             * encoded body, that is the bit after the constructor, starts
+             */
+            struct Node {
+                size_t  m_offset;
+                size_t  m_body;
+                size_t  m_index;
+                uint8_t m_code;
+            };
+
+            /**
+             * Pushed each time we enter a node, remembers the node we
+             * entered along with the byte range and count of its children.
+             * Elements of an array have no constructor of their own, they
+             * share the one recorded here
+             */
+            struct Frame {
+                Node    m_parent;
+                size_t  m_first;
+                size_t  m_end;
+                size_t  m_count;
+                uint8_t m_element;
+            };
+
+            const char * m_data;
+            size_t       m_size;
+
+            Node m_current;
+            bool m_positioned;
+
+            std::vector<Frame> m_stack;
+
+            /**
+             * See remember, replaying decoders point at the table of the
+             * decoder they're replaying for rather than their own. Only
+             * the first m_known objects are where their index says
+             */
+            struct Objects {
+                std::vector<std::string_view> m_encoded;
+                size_t m_known;
+            };
+
+            Objects   m_ownObjects;
+            Objects * m_objects;
+            bool      m_replaying;
+
+            const unsigned char * ptr (size_t, size_t) const;
+
+            uint8_t byte (size_t) const;
+            uint16_t u16 (size_t) const;
+            uint32_t u32 (size_t) const;
+            uint64_t u64 (size_t) const;
+
+            Node at (size_t offset_, size_t index_) const;
+            size_t end (const Node &) const;
+
+            std::string_view view (size_t, size_t) const;
+
+        public :
+            /**
+             * Starts positioned on the first value in the buffer
+             */
+            Decoder (const char *, size_t);
+
+            /**
+             * Reads [encoded_], a value [parent_] has already been past,
+             * sharing its object table
+             */
+            Decoder (std::string_view encoded_, Decoder & parent_);
+
+            Decoder (const Decoder &) = delete;
+            Decoder & operator = (const Decoder &) = delete;
+
+            /**
+             * Navigation, semantics match their pn_data_t counterparts
+             */
+            bool next();
+            bool enter();
+            bool exit();
+
+            amqp_type_t type() const;
+            uint8_t formatCode() const;
+
+            bool isDescribed() const;
+
+            /**
+             * Accessors for the value at the current position. As with
+             * proton these return a zero value if the current node isn't
+             * of the requested type, use the helpers below if you want
+             * the type checked
+             */
+            bool     getBool() const;
+            uint8_t  getUByte() const;
+            int8_t   getByte() const;
+            uint16_t getUShort() const;
+            int16_t  getShort() const;
+            uint32_t getUInt() const;
+            int32_t  getInt() const;
+            uint32_t getChar() const;
+            uint64_t getULong() const;
+            int64_t  getLong() const;
+            int64_t  getTimestamp() const;
+            float    getFloat() const;
+            double   getDouble() const;
+
+            std::string_view getString() const;
+            std::string_view getSymbol() const;
+            std::string_view getBinary() const;
+
+            size_t getList() const;
+            size_t getMap() const;
+            size_t getArray() const;
+
+            /**
+             * Where we are in the underlying buffer, mostly useful for
+             * diagnostics and for anyone wanting to record the location
+             * of a value to come back to later
+             */
+            size_t offset() const;
+
+            /**
+             * The complete encoding of the current node, constructor
+             * and all
+             */
+            std::string_view raw() const;
+
+            size_t depth() const;
+
+            /**
+             * The serialiser that wrote the blob writes an object it's
+             * already written as a reference to it, an index into the
+             * objects it's written so far in the order it finished
+             * writing them. We keep the same table, the encoding of each
+             * object once it's been read, so a reference can be read
+             * straight from where the object already is.
+             *
+             * A replaying decoder never adds to the table, the object it
+             * replays was counted the first time round.
+             */
+            void remember (std::string_view encoded_);
+            std::string_view recall (size_t index_) const;
+
+            /**
+             * Note we've stepped over a value without counting the objects
+             * inside it, so those read after it can't be found by index
+             */
+            void forget();
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::codec {
+
+    /**
+     * Friendly ostream operator for our current position in a decoder
+     */
+    std::ostream & operator << (std::ostream &, Decoder *);
+
+}
+
+/******************************************************************************
+ *
+ * Helper functions and auto objects that make walking the stream a little
+ * nicer
+ *
+ ******************************************************************************/
+
+namespace amqp::codec {
+
+    /**
+     * Wrap enter so we automatically move to the first child node rather
+     * than starting on an invalid one
+     */
+    bool enter (Decoder *);
+
+    void is_map (Decoder *);
+    void is_list (Decoder *);
+    void is_ulong (Decoder *);
+    void is_symbol (Decoder *);
+    void is_string (Decoder *, bool allowNull = false);
+    void is_described (Decoder *);
+
+    template<typename T>
+    T get_symbol (Decoder *);
+
+    template<> std::string get_symbol<std::string> (Decoder *);
+    template<> std::string_view get_symbol<std::string_view> (Decoder *);
+
+    bool get_boolean (Decoder *);
+    std::string_view get_string (Decoder *, bool allowNull = false);
+
+    class auto_enter {
+        private :
+            Decoder * m_data;
+
+        public :
+            explicit auto_enter (Decoder *, bool next_ = false);
+            ~auto_enter();
+    };
+
+    /**
+     * Moves past the current value when it goes out of scope, unless
+     * that's because an exception is unwinding through it, the stream
+     * is in no state to be read further then and a second throw from
+     * here would terminate
+     */
+    class auto_next {
+        private :
+            Decoder * m_data;
+            int       m_exceptions;
+
+        public :
+            explicit auto_next (Decoder *);
+            auto_next (const auto_next &) = delete;
+
+            explicit operator Decoder *() {
+                return m_data;
+            }
+
+            ~auto_next() noexcept (false);
+    };
+
+    class auto_list_enter {
+        private :
+            size_t    m_elements;
+            Decoder * m_data;
+
+        public :
+            explicit auto_list_enter (Decoder *, bool next_ = false);
+            ~auto_list_enter();
+
+            size_t elements() const;
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::codec {
+
+    /**
+     * Read the current value and move onto the next. Only specialised
+     * for the types we actually need, asking for anything else is a
+     * link time error
+     */
+    template<typename T>
+    T readAndNext (Decoder *, bool tolerateDeviance_ = false);
+
+    template<> int32_t readAndNext<int32_t> (Decoder *, bool);
+    template<> bool readAndNext<bool> (Decoder *, bool);
+    template<> double readAndNext<double> (Decoder *, bool);
+    template<> long readAndNext<long> (Decoder *, bool);
+    template<> u_long readAndNext<u_long> (Decoder *, bool);
+    template<> std::string readAndNext<std::string> (Decoder *, bool);
+    template<> std::string_view readAndNext<std::string_view> (Decoder *, bool);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,415 @@
+#include "Encoder.h"
+
+#include <cstring>
+#include <stdexcept>
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * The constructor of a list or map, followed by its 32 bit size
+     * and count, is what we leave room for when opening one
+     */
+    constexpr size_t WIDE = 9;
+
+    /**
+     * And what it shrinks to when it's small enough for the 8 bit ones
+     */
+    constexpr size_t NARROW = 3;
+
+}
+
+/******************************************************************************
+ *
+ * amqp::codec::Encoder
+ *
+ ******************************************************************************/
+
+amqp::codec::
+Encoder::Encoder (std::vector<char> & buffer_) : m_buffer (buffer_) {
+    m_stack.reserve (16);
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::code (uint8_t code_) {
+    m_buffer.push_back (static_cast<char> (code_));
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::u8 (uint8_t value_) {
+    m_buffer.push_back (static_cast<char> (value_));
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::u32 (uint32_t value_) {
+    char bytes[4];
+
+    for (int i { 3 } ; i >= 0 ; --i) {
+        bytes[i] = static_cast<char> (value_ & 0xffU);
+        value_ >>= 8U;
+    }
+
+    m_buffer.insert (m_buffer.end(), bytes, bytes + 4);
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::u64 (uint64_t value_) {
+    char bytes[8];
+
+    for (int i { 7 } ; i >= 0 ; --i) {
+        bytes[i] = static_cast<char> (value_ & 0xffU);
+        value_ >>= 8U;
+    }
+
+    m_buffer.insert (m_buffer.end(), bytes, bytes + 8);
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::bytes (std::string_view bytes_) {
+    m_buffer.insert (m_buffer.end(), bytes_.begin(), bytes_.end());
+}
+
+/******************************************************************************/
+
+/**
+ * Strings, symbols and binaries, [narrow_] if the length fits in a byte
+ */
+void
+amqp::codec::
+Encoder::variable (uint8_t narrow_, uint8_t wide_, std::string_view value_) {
+    if (value_.size() <= 0xffU) {
+        code (narrow_);
+        u8 (static_cast<uint8_t> (value_.size()));
+    } else {
+        code (wide_);
+        u32 (static_cast<uint32_t> (value_.size()));
+    }
+
+    bytes (value_);
+    value();
+}
+
+/******************************************************************************/
+
+/**
+ * Count a value we've just finished putting in whatever it's inside of. A
+ * described value is finished once both its descriptor and value are,
+ * it's then one value of whatever it's inside of
+ */
+void
+amqp::codec::
+Encoder::value() {
+    while (!m_stack.empty()) {
+        auto & frame = m_stack.back();
+
+        if (++frame.m_count < 2 || frame.m_code != FC_DESCRIBED) {
+            return;
+        }
+
+        m_stack.pop_back();
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::begin (uint8_t code_) {
+    m_stack.push_back (Frame { m_buffer.size(), 0, code_ });
+
+    code (code_);
+    u32 (0);
+    u32 (0);
+}
+
+/******************************************************************************/
+
+/**
+ * Fill in the size and count of the list or map we're closing, or move
+ * its contents down over the space we don't need if it'll fit in the
+ * [narrow_] encoding. An empty one is just the [empty_] constructor,
+ * when there is one, maps pass FC_DESCRIBED as they don't have one
+ */
+void
+amqp::codec::
+Encoder::end (uint8_t narrow_, uint8_t wide_, uint8_t empty_) {
+    if (m_stack.empty() || m_stack.back().m_code != wide_) {
+        throw std::runtime_error ("Closing a list or map that isn't open");
+    }
+
+    auto frame = m_stack.back();
+    m_stack.pop_back();
+
+    auto body = m_buffer.size() - (frame.m_offset + WIDE);
+
+    if (frame.m_count == 0 && empty_ != FC_DESCRIBED) {
+        m_buffer.resize (frame.m_offset);
+        code (empty_);
+    } else if (body < 0xffU && frame.m_count <= 0xffU) {
+        auto * at = m_buffer.data() + frame.m_offset;
+
+        at[0] = static_cast<char> (narrow_);
+        at[1] = static_cast<char> (body + 1);
+        at[2] = static_cast<char> (frame.m_count);
+
+        std::memmove (at + NARROW, at + WIDE, body);
+        m_buffer.resize (frame.m_offset + NARROW + body);
+    } else {
+        if (body + 4 > 0xffffffffU) {
+            throw std::runtime_error ("List or map too large to encode");
+        }
+
+        auto * at = m_buffer.data() + frame.m_offset + 1;
+        auto size = static_cast<uint32_t> (body + 4);
+        auto count = static_cast<uint32_t> (frame.m_count);
+
+        for (int i { 3 } ; i >= 0 ; --i) {
+            at[i] = static_cast<char> (size & 0xffU);
+            at[4 + i] = static_cast<char> (count & 0xffU);
+            size >>= 8U;
+            count >>= 8U;
+        }
+    }
+
+    value();
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::putNull() {
+    code (FC_NULL);
+    value();
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::putBool (bool value_) {
+    code (value_ ? FC_TRUE : FC_FALSE);
+    value();
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::putInt (int32_t value_) {
+    if (value_ >= INT8_MIN && value_ <= INT8_MAX) {
+        code (FC_SMALLINT);
+        u8 (static_cast<uint8_t> (value_));
+    } else {
+        code (FC_INT);
+        u32 (static_cast<uint32_t> (value_));
+    }
+
+    value();
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::putLong (int64_t value_) {
+    if (value_ >= INT8_MIN && value_ <= INT8_MAX) {
+        code (FC_SMALLLONG);
+        u8 (static_cast<uint8_t> (value_));
+    } else {
+        code (FC_LONG);
+        u64 (static_cast<uint64_t> (value_));
+    }
+
+    value();
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::putULong (uint64_t value_) {
+    if (value_ == 0) {
+        code (FC_ULONG0);
+    } else if (value_ <= 0xffU) {
+        code (FC_SMALLULONG);
+        u8 (static_cast<uint8_t> (value_));
+    } else {
+        code (FC_ULONG);
+        u64 (value_);
+    }
+
+    value();
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::putDouble (double value_) {
+    uint64_t bits;
+    std::memcpy (&bits, &value_, sizeof (bits));
+
+    code (FC_DOUBLE);
+    u64 (bits);
+    value();
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::putString (std::string_view value_) {
+    variable (FC_STR8, FC_STR32, value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::putSymbol (std::string_view value_) {
+    variable (FC_SYM8, FC_SYM32, value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::putBinary (std::string_view value_) {
+    variable (FC_VBIN8, FC_VBIN32, value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::putRaw (std::string_view encoded_, size_t values_) {
+    bytes (encoded_);
+
+    for (size_t i { 0 } ; i < values_ ; ++i) {
+        value();
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::described() {
+    m_stack.push_back (Frame { m_buffer.size(), 0, FC_DESCRIBED });
+    code (FC_DESCRIBED);
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::beginList() {
+    begin (FC_LIST32);
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::endList() {
+    end (FC_LIST8, FC_LIST32, FC_LIST0);
+}
+
+/******************************************************************************/
+
+void
+amqp::codec::
+Encoder::beginMap() {
+    begin (FC_MAP32);
+}
+
+/******************************************************************************/
+
+/**
+ * There's no zero width map
+ */
+void
+amqp::codec::
+Encoder::endMap() {
+    end (FC_MAP8, FC_MAP32, FC_DESCRIBED);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::codec::
+Encoder::size() const {
+    return m_buffer.size();
+}
+
+/******************************************************************************/
+
+size_t
+amqp::codec::
+Encoder::depth() const {
+    return m_stack.size();
+}
+
+/******************************************************************************/
+
+template<>
+void
+amqp::codec::
+write<int32_t> (Encoder & encoder_, int32_t value_) {
+    encoder_.putInt (value_);
+}
+
+/******************************************************************************/
+
+template<>
+void
+amqp::codec::
+write<bool> (Encoder & encoder_, bool value_) {
+    encoder_.putBool (value_);
+}
+
+/******************************************************************************/
+
+template<>
+void
+amqp::codec::
+write<double> (Encoder & encoder_, double value_) {
+    encoder_.putDouble (value_);
+}
+
+/******************************************************************************/
+
+template<>
+void
+amqp::codec::
+write<long> (Encoder & encoder_, long value_) {
+    encoder_.putLong (value_);
+}
+
+/******************************************************************************/
+
+template<>
+void
+amqp::codec::
+write<std::string_view> (Encoder & encoder_, std::string_view value_) {
+    encoder_.putString (value_);
+}
+
+/******************************************************************************/
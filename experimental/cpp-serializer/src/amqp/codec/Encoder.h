@@ -0,0 +1,121 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "AMQPTypes.h"
+
+/******************************************************************************/
+
+/**
+ * The other half of the Decoder, writes AMQP 1.0 encoded values straight
+ * onto the end of a buffer the caller owns.
+ *
+ * Nothing is built up first and then written out, each value is encoded
+ * where it's going to stay as it's put. Lists and maps are opened with
+ * room for the widest size and count, those are filled in when they're
+ * closed, at which point anything small enough is shuffled down into the
+ * compact encoding, so what we write is the same size as what the JVM
+ * would. Scalars always get the most compact encoding that holds them.
+ *
+ * A described value is the call to described followed by exactly two
+ * values, its descriptor and then the value itself.
+ *
+ * The buffer is only ever appended to, so the same one can be cleared and
+ * handed to a new encoder blob after blob without giving memory back.
+ */
+namespace amqp::codec {
+
+    class Encoder {
+        private :
+            /**
+             * An open list, map or described value, where it starts and
+             * how many values have been put into it so far
+             */
+            struct Frame {
+                size_t  m_offset;
+                size_t  m_count;
+                uint8_t m_code;
+            };
+
+            std::vector<char> & m_buffer;
+
+            std::vector<Frame> m_stack;
+
+            void code (uint8_t);
+            void u8 (uint8_t);
+            void u32 (uint32_t);
+            void u64 (uint64_t);
+            void bytes (std::string_view);
+            void variable (uint8_t, uint8_t, std::string_view);
+
+            void value();
+
+            void begin (uint8_t);
+            void end (uint8_t, uint8_t, uint8_t);
+
+        public :
+            explicit Encoder (std::vector<char> & buffer_);
+
+            Encoder (const Encoder &) = delete;
+            Encoder & operator = (const Encoder &) = delete;
+
+            void putNull();
+            void putBool (bool);
+            void putInt (int32_t);
+            void putLong (int64_t);
+            void putULong (uint64_t);
+            void putDouble (double);
+
+            void putString (std::string_view);
+            void putSymbol (std::string_view);
+            void putBinary (std::string_view);
+
+            /**
+             * [values_] values someone else has already encoded, copied
+             * in as they are
+             */
+            void putRaw (std::string_view encoded_, size_t values_ = 1);
+
+            void described();
+
+            void beginList();
+            void endList();
+
+            void beginMap();
+            void endMap();
+
+            /**
+             * How much of the buffer we've filled, and how many lists,
+             * maps and described values are still open
+             */
+            size_t size() const;
+            size_t depth() const;
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::codec {
+
+    /**
+     * The counterpart of readAndNext, for the same types
+     */
+    template<typename T>
+    void write (Encoder &, T);
+
+    template<> void write<int32_t> (Encoder &, int32_t);
+    template<> void write<bool> (Encoder &, bool);
+    template<> void write<double> (Encoder &, double);
+    template<> void write<long> (Encoder &, long);
+    template<> void write<std::string_view> (Encoder &, std::string_view);
+
+}
+
+/******************************************************************************/
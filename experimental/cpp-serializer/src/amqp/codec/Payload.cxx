@@ -0,0 +1,182 @@
+#include "Payload.h"
+
+#include <zlib.h>
+
+#include <limits>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPEncoding.h"
+#include "amqp/AMQPSectionId.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * How much compressed input zlib is handed at a time, and the least
+     * we start the output with
+     */
+    constexpr size_t CHUNK = 64 * 1024;
+
+}
+
+/******************************************************************************
+ *
+ * class Payload
+ *
+ ******************************************************************************/
+
+amqp::codec::
+Payload::Payload (
+    const char * blob_,
+    size_t size_
+) : m_data (nullptr)
+  , m_size (0)
+{
+    if (size_ < amqp::AMQP_HEADER.size() + 1
+        || !std::equal (
+                amqp::AMQP_HEADER.begin(),
+                amqp::AMQP_HEADER.end(),
+                blob_))
+    {
+        throw std::runtime_error ("Bad Header in blob");
+    }
+
+    sections (blob_ + amqp::AMQP_HEADER.size(), size_ - amqp::AMQP_HEADER.size());
+}
+
+/******************************************************************************/
+
+/**
+ * With [data_] on a section id work through the sections until we find
+ * the data
+ */
+void
+amqp::codec::
+Payload::sections (const char * data_, size_t size_) {
+    if (!size_) {
+        throw std::runtime_error ("Blob has no data section");
+    }
+
+    auto section = static_cast<amqp::amqp_section_id_t> (data_[0]);
+
+    switch (section) {
+        case amqp::DATA_AND_STOP :
+        case amqp::ALT_DATA_AND_STOP : {
+            m_data = data_ + 1;
+            m_size = size_ - 1;
+            break;
+        }
+        case amqp::ENCODING : {
+            if (size_ < 2) {
+                throw std::runtime_error ("Truncated ENCODING section");
+            }
+
+            if (compressed()) {
+                throw std::runtime_error ("Blob is encoded more than once");
+            }
+
+            auto encoding = static_cast<amqp::amqp_encoding_t> (data_[1]);
+
+            if (encoding != amqp::DEFLATE) {
+                std::stringstream ss;
+                ss << "Unsupported encoding " << encoding;
+                throw std::runtime_error (ss.str());
+            }
+
+            inflate (data_ + 2, size_ - 2);
+            sections (m_inflated.data(), m_inflated.size());
+            break;
+        }
+        default : {
+            std::stringstream ss;
+            ss << "BAD SECTION " << static_cast<int> (section);
+            throw std::runtime_error (ss.str());
+        }
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * The JVM writes DEFLATE encoded sections with a DeflaterOutputStream,
+ * that's zlib's format, header and all. The output buffer starts at a
+ * guess from the compressed size and doubles whenever it's filled
+ */
+void
+amqp::codec::
+Payload::inflate (const char * data_, size_t size_) {
+    z_stream stream { };
+
+    if (inflateInit (&stream) != Z_OK) {
+        throw std::runtime_error ("Failed to initialise zlib");
+    }
+
+    m_inflated.resize (std::max (CHUNK, 4 * size_));
+
+    size_t in { 0 };
+    int rc { Z_OK };
+
+    while (rc != Z_STREAM_END) {
+        if (stream.total_out == m_inflated.size()) {
+            m_inflated.resize (2 * m_inflated.size());
+        }
+
+        if (!stream.avail_in && in < size_) {
+            auto chunk = std::min (CHUNK, size_ - in);
+
+            stream.next_in = reinterpret_cast<Bytef *> (const_cast<char *> (data_ + in));
+            stream.avail_in = static_cast<uInt> (chunk);
+            in += chunk;
+        }
+
+        auto space = std::min<size_t> (
+                m_inflated.size() - stream.total_out,
+                std::numeric_limits<uInt>::max());
+
+        stream.next_out = reinterpret_cast<Bytef *> (m_inflated.data() + stream.total_out);
+        stream.avail_out = static_cast<uInt> (space);
+
+        rc = ::inflate (&stream, Z_NO_FLUSH);
+
+        if (rc != Z_OK && rc != Z_STREAM_END
+            && !(rc == Z_BUF_ERROR && (stream.avail_in || in < size_ || !stream.avail_out)))
+        {
+            std::string error = stream.msg ? stream.msg : "truncated stream";
+            inflateEnd (&stream);
+            throw std::runtime_error ("Failed to inflate blob: " + error);
+        }
+    }
+
+    m_inflated.resize (stream.total_out);
+    inflateEnd (&stream);
+}
+
+/******************************************************************************/
+
+const char *
+amqp::codec::
+Payload::data() const {
+    return m_data;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::codec::
+Payload::size() const {
+    return m_size;
+}
+
+/******************************************************************************/
+
+bool
+amqp::codec::
+Payload::compressed() const {
+    return !m_inflated.empty();
+}
+
+/******************************************************************************/
@@ -0,0 +1,55 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+#include <cstddef>
+
+/******************************************************************************/
+
+/**
+ * The AMQP encoded part of a serialised blob.
+ *
+ * After the header a blob is a series of sections, each starting with its
+ * id. A DATA_AND_STOP, or ALT_DATA_AND_STOP, section is the AMQP data and
+ * runs to the end. An ENCODING section says how everything after it is
+ * encoded and the sections carry on from inside that.
+ *
+ * An uncompressed payload is a view straight into the blob. A DEFLATE one
+ * is inflated a chunk at a time, reading from the blob in place, into the
+ * buffer the decoder will walk, it's never held anywhere else. The whole
+ * payload is inflated before we hand it back as the schema a blob's data
+ * is read against is written after the data.
+ *
+ * The blob must outlive the payload.
+ */
+namespace amqp::codec {
+
+    class Payload {
+        private :
+            const char * m_data;
+            size_t       m_size;
+
+            /**
+             * Holds the inflated payload when the blob is compressed
+             */
+            std::vector<char> m_inflated;
+
+            void sections (const char *, size_t);
+            void inflate (const char *, size_t);
+
+        public :
+            Payload (const char * blob_, size_t size_);
+
+            Payload (const Payload &) = delete;
+            Payload & operator = (const Payload &) = delete;
+
+            const char * data() const;
+            size_t size() const;
+
+            bool compressed() const;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,589 @@
+#include "Columns.h"
+
+#include <limits>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+
+#include "amqp/bind/Binding.h"
+#include "amqp/schema/Field.h"
+#include "amqp/schema/Composite.h"
+#include "amqp/schema/restricted-types/Map.h"
+#include "amqp/schema/restricted-types/List.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    const char * const TYPES[] = {
+        "int", "long", "double", "bool", "string", "offsets"
+    };
+
+    columns::ColumnType
+    primitive (const schema::Symbol & type_) {
+        const auto & name = type_.str();
+
+        if (name == "int") return columns::ColumnType::Int;
+        if (name == "long") return columns::ColumnType::Long;
+        if (name == "double") return columns::ColumnType::Double;
+        if (name == "boolean") return columns::ColumnType::Bool;
+        if (name == "string") return columns::ColumnType::String;
+
+        throw std::runtime_error ("No column type for " + name);
+    }
+
+    template<typename T>
+    void
+    put (std::ostream & out_, T value_) {
+        out_.write (reinterpret_cast<const char *> (&value_), sizeof (T));
+    }
+
+    template<typename T>
+    void
+    put (std::ostream & out_, const std::vector<T> & values_) {
+        out_.write (
+                reinterpret_cast<const char *> (values_.data()),
+                static_cast<std::streamsize> (values_.size() * sizeof (T)));
+    }
+
+    /**
+     * Quoted only if it needs to be
+     */
+    void
+    csvString (std::ostream & out_, std::string_view value_) {
+        if (value_.find_first_of (",\"\r\n") == std::string_view::npos) {
+            out_ << value_;
+            return;
+        }
+
+        out_ << '"';
+        for (auto c : value_) {
+            if (c == '"') {
+                out_ << '"';
+            }
+            out_ << c;
+        }
+        out_ << '"';
+    }
+
+    void
+    csvValue (std::ostream & out_, const columns::Column & column_, size_t i_) {
+        switch (column_.m_type) {
+            case columns::ColumnType::Int : out_ << column_.m_ints[i_]; break;
+            case columns::ColumnType::Long : out_ << column_.m_longs[i_]; break;
+            case columns::ColumnType::Double : out_ << column_.m_doubles[i_]; break;
+            case columns::ColumnType::Bool :
+                out_ << (column_.m_bools[i_] ? "true" : "false");
+                break;
+            case columns::ColumnType::String :
+                csvString (out_, std::string_view (
+                        column_.m_bytes.data() + column_.m_offsets[i_],
+                        column_.m_offsets[i_ + 1] - column_.m_offsets[i_]));
+                break;
+            case columns::ColumnType::Offsets :
+                out_ << column_.m_offsets[i_ + 1] - column_.m_offsets[i_];
+                break;
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+const char *
+amqp::internal::columns::
+name (ColumnType type_) {
+    return TYPES[static_cast<int> (type_)];
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::columns::Column
+ *
+ ******************************************************************************/
+
+size_t
+amqp::internal::columns::
+Column::size() const {
+    switch (m_type) {
+        case ColumnType::Int : return m_ints.size();
+        case ColumnType::Long : return m_longs.size();
+        case ColumnType::Double : return m_doubles.size();
+        case ColumnType::Bool : return m_bools.size();
+        default : return m_offsets.size() - 1;
+    }
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::columns::Columns
+ *
+ ******************************************************************************/
+
+amqp::internal::columns::
+Columns::Columns (
+    const schema::Schema & schema_,
+    const std::string & descriptor_
+) : m_rows (0) {
+    const auto & type = bind::typeOf (schema_, descriptor_);
+
+    // throws if it isn't one
+    bind::asComposite (schema_, type);
+
+    std::vector<schema::Symbol> path;
+    layout (schema_, type, "", NONE, path);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::columns::
+Columns::column (std::string name_, ColumnType type_, size_t table_) {
+    m_columns.push_back (Column { std::move (name_), type_, table_ });
+
+    if (type_ == ColumnType::String || type_ == ColumnType::Offsets) {
+        m_columns.back().m_offsets.push_back (0);
+    }
+
+    return m_columns.size() - 1;
+}
+
+/******************************************************************************/
+
+/**
+ * Nodes are added after their children so the root is the last, a type
+ * that contains itself would need a column per level it could go to so
+ * that's refused
+ */
+size_t
+amqp::internal::columns::
+Columns::layout (
+    const schema::Schema & schema_,
+    const schema::Symbol & type_,
+    const std::string & name_,
+    size_t table_,
+    std::vector<schema::Symbol> & path_
+) {
+    Node node { Node::Leaf, NONE, { } };
+
+    if (type_.primitive()) {
+        node.m_column = column (name_, primitive (type_), table_);
+    } else if (bind::isEnum (schema_, type_)) {
+        node.m_column = column (name_, ColumnType::String, table_);
+    } else {
+        const auto * notation = schema_.byType (type_);
+
+        if (!notation) {
+            throw std::runtime_error ("No type " + type_.str() + " in the schema");
+        }
+
+        if (std::find (path_.begin(), path_.end(), type_) != path_.end()) {
+            throw std::runtime_error (
+                    type_.str() + " contains itself and can't be laid out as columns");
+        }
+
+        path_.push_back (type_);
+
+        if (notation->type() == schema::AMQPTypeNotation::Composite) {
+            node.m_kind = Node::Composite;
+
+            for (const auto & field : bind::asComposite (schema_, type_).fields()) {
+                node.m_children.push_back (layout (
+                        schema_,
+                        bind::fieldType (*field),
+                        name_.empty() ? field->name() : name_ + "." + field->name(),
+                        table_,
+                        path_));
+            }
+        } else {
+            node.m_column = column (name_, ColumnType::Offsets, table_);
+
+            if (dynamic_cast<const schema::Restricted &> (*notation).restrictedType()
+                    == schema::Restricted::Map)
+            {
+                const auto & map = bind::asMap (schema_, type_);
+
+                node.m_kind = Node::Map;
+                node.m_children.push_back (layout (
+                        schema_, map.keyTypeId(), name_ + "[].key", node.m_column, path_));
+                node.m_children.push_back (layout (
+                        schema_, map.valueTypeId(), name_ + "[].value", node.m_column, path_));
+            } else {
+                node.m_kind = Node::List;
+                node.m_children.push_back (layout (
+                        schema_,
+                        bind::asList (schema_, type_).listOfId(),
+                        name_ + "[]",
+                        node.m_column,
+                        path_));
+            }
+        }
+
+        path_.pop_back();
+    }
+
+    m_nodes.push_back (std::move (node));
+
+    return m_nodes.size() - 1;
+}
+
+/******************************************************************************/
+
+const std::vector<amqp::internal::columns::Column> &
+amqp::internal::columns::
+Columns::columns() const {
+    return m_columns;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::columns::
+Columns::rows() const {
+    return m_rows;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::columns::
+Columns::rows (size_t table_) const {
+    return table_ == NONE ? m_rows : m_columns[table_].m_offsets.back();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::rollback() {
+    if (m_marks.empty()) {
+        return;
+    }
+
+    for (size_t i { 0 } ; i < m_columns.size() ; ++i) {
+        auto & column = m_columns[i];
+        auto [ values, bytes ] = m_marks[i];
+
+        switch (column.m_type) {
+            case ColumnType::Int : column.m_ints.resize (values); break;
+            case ColumnType::Long : column.m_longs.resize (values); break;
+            case ColumnType::Double : column.m_doubles.resize (values); break;
+            case ColumnType::Bool : column.m_bools.resize (values); break;
+            default : column.m_offsets.resize (values + 1); break;
+        }
+
+        column.m_bytes.resize (bytes);
+    }
+
+    m_marks.clear();
+    m_stack.clear();
+    --m_rows;
+}
+
+/******************************************************************************/
+
+/**
+ * What the value about to be read should be
+ */
+const amqp::internal::columns::Columns::Node &
+amqp::internal::columns::
+Columns::expected() {
+    if (m_stack.empty()) {
+        return m_nodes.back();
+    }
+
+    auto & frame = m_stack.back();
+    const auto & children = frame.m_node->m_children;
+
+    switch (frame.m_node->m_kind) {
+        case Node::Composite : {
+            if (frame.m_values == 0 || frame.m_values > children.size()) {
+                throw std::runtime_error ("Value read without a field to put it in");
+            }
+
+            return m_nodes[children[frame.m_values - 1]];
+        }
+        case Node::Map : {
+            return m_nodes[children[frame.m_values++ % 2]];
+        }
+        default : {
+            return m_nodes[children[0]];
+        }
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::columns::Column &
+amqp::internal::columns::
+Columns::leaf (ColumnType type_) {
+    const auto & node = expected();
+
+    if (node.m_kind != Node::Leaf || m_columns[node.m_column].m_type != type_) {
+        throw std::runtime_error (
+                std::string ("Read ") + name (type_) + " for "
+                + (node.m_kind == Node::Leaf
+                        ? m_columns[node.m_column].m_name + " which holds "
+                                + name (m_columns[node.m_column].m_type)
+                        : std::string ("something that isn't a value")));
+    }
+
+    return m_columns[node.m_column];
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::beginComposite (const std::string & type_) {
+    const auto & node = expected();
+
+    if (node.m_kind != Node::Composite) {
+        throw std::runtime_error ("Read a composite " + type_ + " where the columns don't have one");
+    }
+
+    if (m_stack.empty()) {
+        m_marks.clear();
+        for (const auto & column : m_columns) {
+            m_marks.emplace_back (column.size(), column.m_bytes.size());
+        }
+
+        ++m_rows;
+    }
+
+    m_stack.push_back (Frame { &node, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::endComposite() {
+    if (m_stack.back().m_values != m_stack.back().m_node->m_children.size()) {
+        throw std::runtime_error ("Composite ended before all of its fields were read");
+    }
+
+    m_stack.pop_back();
+
+    // the blob's done, nothing to roll back
+    if (m_stack.empty()) {
+        m_marks.clear();
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::beginList (const std::string & type_, size_t size_) {
+    const auto & node = expected();
+
+    if (node.m_kind != Node::List) {
+        throw std::runtime_error ("Read a list " + type_ + " where the columns don't have one");
+    }
+
+    auto & offsets = m_columns[node.m_column].m_offsets;
+    offsets.push_back (offsets.back() + size_);
+
+    m_stack.push_back (Frame { &node, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::endList() {
+    m_stack.pop_back();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::beginMap (const std::string & type_, size_t size_) {
+    const auto & node = expected();
+
+    if (node.m_kind != Node::Map) {
+        throw std::runtime_error ("Read a map " + type_ + " where the columns don't have one");
+    }
+
+    auto & offsets = m_columns[node.m_column].m_offsets;
+    offsets.push_back (offsets.back() + size_);
+
+    m_stack.push_back (Frame { &node, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::endMap() {
+    m_stack.pop_back();
+}
+
+/******************************************************************************/
+
+/**
+ * Fields are read in the order the schema has them so which field this
+ * is doesn't need looking up
+ */
+void
+amqp::internal::columns::
+Columns::field (const std::string & name_) {
+    if (m_stack.empty() || m_stack.back().m_node->m_kind != Node::Composite) {
+        throw std::runtime_error ("Field " + name_ + " read outside of a composite");
+    }
+
+    ++m_stack.back().m_values;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::onInt (int32_t value_) {
+    leaf (ColumnType::Int).m_ints.push_back (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::onLong (int64_t value_) {
+    leaf (ColumnType::Long).m_longs.push_back (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::onDouble (double value_) {
+    leaf (ColumnType::Double).m_doubles.push_back (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::onBool (bool value_) {
+    leaf (ColumnType::Bool).m_bools.push_back (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::onString (std::string_view value_) {
+    auto & column = leaf (ColumnType::String);
+
+    column.m_bytes.insert (column.m_bytes.end(), value_.begin(), value_.end());
+    column.m_offsets.push_back (column.m_bytes.size());
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::onEnum (std::string_view value_) {
+    onString (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::write (std::ostream & out_) const {
+    out_.write ("AMQPCOL1", 8);
+    put<uint64_t> (out_, m_rows);
+    put<uint32_t> (out_, static_cast<uint32_t> (m_columns.size()));
+
+    for (const auto & column : m_columns) {
+        put<uint32_t> (out_, static_cast<uint32_t> (column.m_name.size()));
+        out_.write (column.m_name.data(), static_cast<std::streamsize> (column.m_name.size()));
+        put<uint8_t> (out_, static_cast<uint8_t> (column.m_type));
+        put<uint64_t> (out_, column.m_table);
+        put<uint64_t> (out_, column.size());
+    }
+
+    for (const auto & column : m_columns) {
+        switch (column.m_type) {
+            case ColumnType::Int : put (out_, column.m_ints); break;
+            case ColumnType::Long : put (out_, column.m_longs); break;
+            case ColumnType::Double : put (out_, column.m_doubles); break;
+            case ColumnType::Bool : put (out_, column.m_bools); break;
+            case ColumnType::String : {
+                put (out_, column.m_offsets);
+                put<uint64_t> (out_, column.m_bytes.size());
+                put (out_, column.m_bytes);
+                break;
+            }
+            case ColumnType::Offsets : put (out_, column.m_offsets); break;
+        }
+    }
+
+    if (!out_) {
+        throw std::runtime_error ("Failed writing the columns");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columns::
+Columns::csv (std::ostream & out_, size_t table_) const {
+    if (table_ != NONE && m_columns[table_].m_type != ColumnType::Offsets) {
+        throw std::runtime_error (m_columns[table_].m_name + " isn't a list");
+    }
+
+    std::vector<const Column *> columns;
+    for (const auto & column : m_columns) {
+        if (column.m_table == table_) {
+            columns.push_back (&column);
+        }
+    }
+
+    const char * separator = "";
+    if (table_ != NONE) {
+        out_ << "parent";
+        separator = ",";
+    }
+
+    for (const auto * column : columns) {
+        out_ << separator;
+        csvString (out_, column->m_name);
+        separator = ",";
+    }
+    out_ << '\n';
+
+    auto precision = out_.precision (std::numeric_limits<double>::max_digits10);
+
+    size_t parent { 0 };
+    for (size_t row { 0 } ; row < rows (table_) ; ++row) {
+        separator = "";
+
+        if (table_ != NONE) {
+            const auto & offsets = m_columns[table_].m_offsets;
+            while (offsets[parent + 1] <= row) {
+                ++parent;
+            }
+
+            out_ << parent;
+            separator = ",";
+        }
+
+        for (const auto * column : columns) {
+            out_ << separator;
+            csvValue (out_, *column, row);
+            separator = ",";
+        }
+
+        out_ << '\n';
+    }
+
+    out_.precision (precision);
+}
+
+/******************************************************************************/
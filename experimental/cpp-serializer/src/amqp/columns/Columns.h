@@ -0,0 +1,197 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <iosfwd>
+#include <string_view>
+
+#include "types.h"
+#include "amqp/reader/IVisitor.h"
+#include "amqp/schema/Schema.h"
+
+/******************************************************************************/
+
+/**
+ * Many blobs of one type laid out as columns, one per leaf field of the
+ * type, each blob read into them appending a row.
+ *
+ * Nested composites are flattened, a column is named by the dotted path
+ * to its field. A list gets an offsets column named after it, row i's
+ * elements being those between offsets i and i + 1 of the columns laid
+ * out for its element type, named after the list with "[]" appended. A
+ * map is a list of entries, their keys and values under "[].key" and
+ * "[].value". Enums are written as the names of their constants.
+ *
+ *  ListOfComposites { a : List<A>, b : int }, A { x : int, y : string }
+ *
+ *  a        offsets  0 2 3     two blobs, the first with two As
+ *  a[].x    int      1 2 3
+ *  a[].y    string   ...
+ *  b        int      7 8
+ *
+ * Each column lives in the table of the list it's under, the top table
+ * having a row per blob.
+ *
+ * Blobs are read into the columns by visiting them, the Columns being
+ * the visitor, so it works with the readers and the decode plans alike.
+ */
+namespace amqp::internal::columns {
+
+    enum class ColumnType : uint8_t {
+        Int, Long, Double, Bool, String, Offsets
+    };
+
+    const char * name (ColumnType);
+
+    struct Column {
+        std::string m_name;
+        ColumnType  m_type;
+
+        /**
+         * The offsets column of the list this is under, or NONE for
+         * the top table
+         */
+        size_t m_table;
+
+        std::vector<int32_t> m_ints;
+        std::vector<int64_t> m_longs;
+        std::vector<double>  m_doubles;
+        std::vector<uint8_t> m_bools;
+
+        /**
+         * Strings and lists, starting with a 0, strings index into
+         * m_bytes and lists into the columns under them
+         */
+        std::vector<uint64_t> m_offsets;
+        std::vector<char>     m_bytes;
+
+        /**
+         * How many values have been appended
+         */
+        size_t size() const;
+    };
+
+    class Columns : public amqp::reader::IVisitor {
+        public :
+            static constexpr size_t NONE = static_cast<size_t> (-1);
+
+        private :
+            /**
+             * The shape of the type, mirroring the callbacks reading
+             * one makes, each node that holds values having a column
+             */
+            struct Node {
+                enum Kind { Composite, List, Map, Leaf };
+
+                Kind                m_kind;
+                size_t              m_column;
+                std::vector<size_t> m_children;
+            };
+
+            struct Frame {
+                const Node * m_node;
+                size_t       m_values;
+            };
+
+            std::vector<Column> m_columns;
+            std::vector<Node>   m_nodes;
+            std::vector<Frame>  m_stack;
+
+            /**
+             * How many values and bytes each column had before the
+             * blob being read, to undo it if it fails part way
+             */
+            std::vector<std::pair<size_t, size_t>> m_marks;
+
+            size_t m_rows;
+
+            size_t layout (
+                const schema::Schema &,
+                const schema::Symbol &,
+                const std::string & name_,
+                size_t table_,
+                std::vector<schema::Symbol> & path_);
+
+            size_t column (std::string name_, ColumnType, size_t table_);
+
+            Column & leaf (ColumnType);
+            const Node & expected();
+
+        public :
+            /**
+             * Lay out the columns for the type with [descriptor_]
+             */
+            Columns (const schema::Schema &, const std::string & descriptor_);
+
+            Columns (const Columns &) = delete;
+            Columns & operator = (const Columns &) = delete;
+
+            const std::vector<Column> & columns() const;
+
+            /**
+             * The blobs read so far
+             */
+            size_t rows() const;
+
+            /**
+             * Rows in the table of the offsets column [table_], or the
+             * top one for NONE
+             */
+            size_t rows (size_t table_) const;
+
+            /**
+             * Drop whatever a blob that failed to read part way through
+             * appended, leaving the columns as they were before it
+             */
+            void rollback();
+
+            /**
+             * Write every column out in the binary format below
+             *
+             *  "AMQPCOL1"
+             *  u64 rows, u32 columns
+             *  per column
+             *      u32 name length, name, u8 type, u64 table (all ones
+             *      for the top), u64 values
+             *  then per column its data
+             *      int, long, double, bool    values of 4, 8, 8 or 1 bytes
+             *      string                     values + 1 u64 offsets, u64
+             *                                 byte count, bytes
+             *      offsets                    values + 1 u64 offsets
+             *
+             * Numbers are in the byte order of the machine writing them.
+             */
+            void write (std::ostream &) const;
+
+            /**
+             * Write the columns of the table of the offsets column
+             * [table_], or the top one for NONE, as CSV with a header
+             * of their names. The rows of a list's table start with
+             * the row of the table above that they belong to, lists in
+             * a table are written as their lengths
+             */
+            void csv (std::ostream &, size_t table_ = NONE) const;
+
+            void beginComposite (const std::string &) override;
+            void endComposite() override;
+            void beginList (const std::string &, size_t) override;
+            void endList() override;
+            void beginMap (const std::string &, size_t) override;
+            void endMap() override;
+            void field (const std::string &) override;
+
+            void onInt (int32_t) override;
+            void onLong (int64_t) override;
+            void onDouble (double) override;
+            void onBool (bool) override;
+            void onString (std::string_view) override;
+            void onEnum (std::string_view) override;
+    };
+
+}
+
+/******************************************************************************/
@@ -3,7 +3,7 @@
 #include <sstream>
 #include <amqp/descriptors/corda-descriptors/EnvelopeDescriptor.h>
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
 #include "AMQPDescriptorRegistory.h"
 
 /******************************************************************************/
@@ -20,7 +20,7 @@ namespace amqp::internal {
 
 /******************************************************************************/
 
-const std::string &
+std::string_view
 amqp::internal::
 AMQPDescriptor::symbol() const {
     return m_symbol;
@@ -30,7 +30,7 @@ AMQPDescriptor::symbol() const {
 
 std::unique_ptr<amqp::AMQPDescribed>
 amqp::internal::
-AMQPDescriptor::build (pn_data_t *) const {
+AMQPDescriptor::build (codec::Decoder *) const {
     throw std::runtime_error ("Should never be called");
 }
 
@@ -39,7 +39,7 @@ AMQPDescriptor::build (pn_data_t *) const {
 inline void
 amqp::internal::
 AMQPDescriptor::read (
-        pn_data_t * data_,
+        codec::Decoder * data_,
         std::stringstream & ss_
 ) const {
     return read (data_, ss_, AutoIndent());
@@ -50,20 +50,20 @@ AMQPDescriptor::read (
 void
 amqp::internal::
 AMQPDescriptor::read (
-        pn_data_t * data_,
+        codec::Decoder * data_,
         std::stringstream & ss_,
         const AutoIndent & ai_
 ) const {
-    switch (pn_data_type (data_)) {
-        case PN_DESCRIBED : {
+    switch (data_->type()) {
+        case codec::AMQP_DESCRIBED : {
             ss_ << ai_ << "DESCRIBED: " << std::endl;
             {
                 AutoIndent ai { ai_ } ; // NOLINT
-                proton::auto_enter p (data_);
+                codec::auto_enter p (data_);
 
-                switch (pn_data_type (data_)) {
-                    case PN_ULONG : {
-                        auto key = proton::readAndNext<u_long>(data_);
+                switch (data_->type()) {
+                    case codec::AMQP_ULONG : {
+                        auto key = codec::readAndNext<u_long>(data_);
 
                         ss_ << ai << "key  : "
                             << key << " :: " << amqp::stripCorda(key)
@@ -71,17 +71,17 @@ AMQPDescriptor::read (
                             <<  amqp::describedToString ((uint64_t )key)
                             << std::endl;
 
-                        proton::is_list (data_);
+                        codec::is_list (data_);
                         ss_ << ai << "list : entries: "
-                            << pn_data_get_list(data_)
+                            << data_->getList()
                             << std::endl;
 
-                        AMQPDescriptorRegistory[key]->read (data_, ss_, ai);
+                        descriptorFor (key).read (data_, ss_, ai);
                         break;
                     }
-                    case PN_SYMBOL : {
+                    case codec::AMQP_SYMBOL : {
                         ss_ << ai << "blob: bytes: "
-                            << pn_data_get_symbol(data_).size
+                            << data_->getSymbol().size()
                             << std::endl;
                         break;
                     }
@@ -3,8 +3,10 @@
 /******************************************************************************/
 
 #include <map>
+#include <memory>
 #include <string>
 #include <iostream>
+#include <string_view>
 
 #include "amqp/AMQPDescribed.h"
 
@@ -14,7 +16,9 @@
  *
  ******************************************************************************/
 
-struct pn_data_t;
+namespace amqp::codec {
+    class Decoder;
+}
 
 /******************************************************************************
  *
@@ -50,34 +54,38 @@ namespace amqp::internal {
 
     class AMQPDescriptor {
         protected :
-            std::string m_symbol;
+            std::string_view m_symbol;
             int32_t m_val;
 
         public :
-            AMQPDescriptor()
+            /**
+             * Descriptors are literal types, constexpr constructors and
+             * no destructor to run, so the table of them is built at
+             * compile time, see AMQPDescriptorRegistory. Nothing ever
+             * owns one through a pointer to this base
+             */
+            constexpr AMQPDescriptor()
                 : m_symbol ("ERROR")
                 , m_val (-1)
             { }
 
-            AMQPDescriptor (std::string symbol_, int val_)
-                : m_symbol (std::move (symbol_))
+            constexpr AMQPDescriptor (std::string_view symbol_, int val_)
+                : m_symbol (symbol_)
                 , m_val (val_)
             { }
 
-            virtual ~AMQPDescriptor() = default;
-
-            const std::string & symbol() const;
+            std::string_view symbol() const;
 
-            void validateAndNext (pn_data_t *) const;
+            void validateAndNext (codec::Decoder *) const;
 
-            virtual std::unique_ptr<AMQPDescribed> build (pn_data_t *) const;
+            virtual std::unique_ptr<AMQPDescribed> build (codec::Decoder *) const;
 
             virtual void read (
-                pn_data_t *,
+                codec::Decoder *,
                 std::stringstream &) const;
 
             virtual void read (
-                pn_data_t *,
+                codec::Decoder *,
                 std::stringstream &,
                 const AutoIndent &) const;
     };
@@ -11,6 +11,9 @@
 
 #include <limits>
 #include <climits>
+#include <sstream>
+#include <iterator>
+#include <stdexcept>
 
 /******************************************************************************/
 
@@ -26,7 +29,7 @@ namespace amqp::internal {
 
     const int ENVELOPE              =  1;
     const int SCHEMA                =  2;
-    const int OBJECT                =  3;
+    const int OBJECT_DESCRIPTOR     =  3;
     const int FIELD                 =  4;
     const int COMPOSITE_TYPE        =  5;
     const int RESTRICTED_TYPE       =  6;
@@ -40,83 +43,80 @@ namespace amqp::internal {
 
 /******************************************************************************/
 
-/**
- *
- */
-namespace amqp {
-
-    std::map<uint64_t, std::shared_ptr<internal::AMQPDescriptor>>
-    AMQPDescriptorRegistory = {
-        {
-            22UL,
-            std::make_shared<internal::AMQPDescriptor> ("DESCRIBED", -1)
-        },
-        {
-            1UL | internal::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::EnvelopeDescriptor> ("ENVELOPE", internal::ENVELOPE)
-        },
-        {
-            2UL | internal::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::SchemaDescriptor> ("SCHEMA", internal::SCHEMA)
-        },
-        {
-            3UL | internal::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::ObjectDescriptor> ("OBJECT_DESCRIPTOR", internal::OBJECT)
-        },
-        {
-            4UL | internal::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::FieldDescriptor> (
-                    internal::FieldDescriptor (
-                        "FIELD",
-                        internal::FIELD))
-        },
-        {
-            5UL | internal::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::CompositeDescriptor> (
-                    internal::CompositeDescriptor (
-                        "COMPOSITE_TYPE",
-                        internal::COMPOSITE_TYPE))
-        },
-        {
-            6UL | internal::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::RestrictedDescriptor> (
-                    internal::RestrictedDescriptor (
-                        "RESTRICTED_TYPE",
-                        internal::RESTRICTED_TYPE))
-        },
-        {
-            7UL | internal::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::ChoiceDescriptor> ("CHOICE", internal::CHOICE)
-        },
-        {
-            8UL | internal::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::ReferencedObjectDescriptor> (
-                    internal::ReferencedObjectDescriptor (
-                        "REFERENCED_OBJECT",
-                        internal::REFERENCED_OBJECT))
-        },
-        {
-            9UL | internal::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::TransformSchemaDescriptor> (
-                    internal::TransformSchemaDescriptor (
-                        "TRANSFORM_SCHEMA",
-                        internal::TRANSFORM_SCHEMA))
-        },
-        {
-            10UL | internal::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::TransformElementDescriptor> (
-                    internal::TransformElementDescriptor (
-                        "TRANSFORM_ELEMENT",
-                        internal::TRANSFORM_ELEMENT))
-        },
-        {
-            11UL | internal::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::TransformElementKeyDescriptor> (
-                    internal::TransformElementKeyDescriptor (
-                        "TRANSFORM_ELEMENT_KEY",
-                        internal::TRANSFORM_ELEMENT_KEY))
-        }
+namespace {
+
+    using namespace amqp::internal;
+
+    constexpr AMQPDescriptor described ("DESCRIBED", -1);
+
+    constexpr EnvelopeDescriptor envelope ("ENVELOPE", ENVELOPE);
+    constexpr SchemaDescriptor schema ("SCHEMA", SCHEMA);
+    constexpr ObjectDescriptor object ("OBJECT_DESCRIPTOR", OBJECT_DESCRIPTOR);
+    constexpr FieldDescriptor field ("FIELD", FIELD);
+    constexpr CompositeDescriptor composite ("COMPOSITE_TYPE", COMPOSITE_TYPE);
+    constexpr RestrictedDescriptor restricted ("RESTRICTED_TYPE", RESTRICTED_TYPE);
+    constexpr ChoiceDescriptor choice ("CHOICE", CHOICE);
+    constexpr ReferencedObjectDescriptor referencedObject (
+            "REFERENCED_OBJECT", REFERENCED_OBJECT);
+    constexpr TransformSchemaDescriptor transformSchema (
+            "TRANSFORM_SCHEMA", TRANSFORM_SCHEMA);
+    constexpr TransformElementDescriptor transformElement (
+            "TRANSFORM_ELEMENT", TRANSFORM_ELEMENT);
+    constexpr TransformElementKeyDescriptor transformElementKey (
+            "TRANSFORM_ELEMENT_KEY", TRANSFORM_ELEMENT_KEY);
+
+    /**
+     * Indexed by stripCorda (id), nothing is described as 0
+     */
+    constexpr const AMQPDescriptor * table[] = {
+        nullptr,
+        &envelope,
+        &schema,
+        &object,
+        &field,
+        &composite,
+        &restricted,
+        &choice,
+        &referencedObject,
+        &transformSchema,
+        &transformElement,
+        &transformElementKey
     };
+
+}
+
+/******************************************************************************/
+
+const amqp::internal::AMQPDescriptor *
+amqp::findDescriptor (uint64_t id_) {
+    if ((id_ & ~static_cast<uint64_t> (UINT_MAX)) != internal::DESCRIPTOR_TOP_32BITS) {
+        return nullptr;
+    }
+
+    auto idx = stripCorda (id_);
+
+    return (idx < std::size (table)) ? table[idx] : nullptr;
+}
+
+/******************************************************************************/
+
+const amqp::internal::AMQPDescriptor &
+amqp::descriptorFor (uint64_t id_) {
+    if (auto descriptor = findDescriptor (id_)) {
+        return *descriptor;
+    }
+
+    std::stringstream ss;
+    ss << "Unknown described type 0x" << std::hex << id_;
+
+    throw std::runtime_error (ss.str());
+}
+
+/******************************************************************************/
+
+const amqp::internal::AMQPDescriptor &
+amqp::describedDescriptor() {
+    return described;
 }
 
 /******************************************************************************/
@@ -130,20 +130,9 @@ amqp::stripCorda (uint64_t id) {
 
 std::string
 amqp::describedToString (uint64_t val_) {
-      switch (val_) {
-          case (1UL  | internal::DESCRIPTOR_TOP_32BITS) : return "ENVELOPE";
-          case (2UL  | internal::DESCRIPTOR_TOP_32BITS) : return "SCHEMA";
-          case (3UL  | internal::DESCRIPTOR_TOP_32BITS) : return "OBJECT_DESCRIPTOR";
-          case (4UL  | internal::DESCRIPTOR_TOP_32BITS) : return "FIELD";
-          case (5UL  | internal::DESCRIPTOR_TOP_32BITS) : return "COMPOSITE_TYPE";
-          case (6UL  | internal::DESCRIPTOR_TOP_32BITS) : return "RESTRICTED_TYPE";
-          case (7UL  | internal::DESCRIPTOR_TOP_32BITS) : return "CHOICE";
-          case (8UL  | internal::DESCRIPTOR_TOP_32BITS) : return "REFERENCED_OBJECT";
-          case (9UL  | internal::DESCRIPTOR_TOP_32BITS) : return "TRANSFORM_SCHEMA";
-          case (10UL | internal::DESCRIPTOR_TOP_32BITS) : return "TRANSFORM_ELEMENT";
-          case (11UL | internal::DESCRIPTOR_TOP_32BITS) : return "TRANSFORM_ELEMENT_KEY";
-          default : return "UNKNOWN";
-    }
+    auto descriptor = findDescriptor (val_);
+
+    return descriptor ? std::string (descriptor->symbol()) : "UNKNOWN";
 }
 
 /******************************************************************************/
@@ -2,8 +2,8 @@
 
 /******************************************************************************/
 
-#include <map>
-#include <memory>
+#include <string>
+#include <cstdint>
 
 /******************************************************************************/
 
@@ -46,11 +46,30 @@ namespace amqp::internal {
 /******************************************************************************/
 
 /**
- *
+ * The descriptors for the described types Corda writes live in a table
+ * indexed by their id with the Corda prefix stripped. The table and
+ * everything in it is constant initialised, there's nothing to build
+ * at startup and nothing that changes, so looking one up is an array
+ * index that's safe from any number of threads.
  */
 namespace amqp {
 
-    extern std::map<uint64_t, std::shared_ptr<internal::AMQPDescriptor>> AMQPDescriptorRegistory;
+    /**
+     * The descriptor for the Corda described type [id_], or null if it
+     * isn't one we know about
+     */
+    const internal::AMQPDescriptor * findDescriptor (uint64_t id_);
+
+    /**
+     * As above but an unknown id is an error
+     */
+    const internal::AMQPDescriptor & descriptorFor (uint64_t id_);
+
+    /**
+     * Reads any described value, working out which of the above to hand
+     * it to from its id
+     */
+    const internal::AMQPDescriptor & describedDescriptor();
 
 }
 
@@ -3,8 +3,6 @@
 
 #include <string>
 #include <iostream>
-#include <proton/types.h>
-#include <proton/codec.h>
 #include "colours.h"
 
 #include "debug.h"
@@ -16,7 +14,7 @@
 #include "amqp/schema/OrderedTypeNotations.h"
 #include "amqp/AMQPDescribed.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
 #include "AMQPDescriptorRegistory.h"
 
 /******************************************************************************
@@ -27,25 +25,25 @@
 
 void
 amqp::internal::
-AMQPDescriptor::validateAndNext (pn_data_t * const data_) const {
-    if (pn_data_type(data_) != PN_ULONG) {
+AMQPDescriptor::validateAndNext (codec::Decoder * const data_) const {
+    if (data_->type() != codec::AMQP_ULONG) {
         throw std::runtime_error ("Bad type for a descriptor");
     }
 
     if (   (m_val == -1)
-        || (pn_data_get_ulong(data_) != (static_cast<uint32_t>(m_val) | amqp::internal::DESCRIPTOR_TOP_32BITS)))
+        || (data_->getULong() != (static_cast<uint32_t>(m_val) | amqp::internal::DESCRIPTOR_TOP_32BITS)))
     {
         throw std::runtime_error ("Invalid Type");
     }
 
-    pn_data_next (data_);
+    data_->next();
 }
 
 /******************************************************************************/
 
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
-ReferencedObjectDescriptor::build (pn_data_t * data_) const {
+ReferencedObjectDescriptor::build (codec::Decoder * data_) const {
     validateAndNext (data_);
 
     DBG ("REFERENCED OBJECT " << data_ << std::endl); // NOLINT
@@ -57,7 +55,7 @@ ReferencedObjectDescriptor::build (pn_data_t * data_) const {
 
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
-TransformSchemaDescriptor::build (pn_data_t * data_) const {
+TransformSchemaDescriptor::build (codec::Decoder * data_) const {
     validateAndNext (data_);
 
     DBG ("TRANSFORM SCHEMA " << data_ << std::endl); // NOLINT
@@ -69,7 +67,7 @@ TransformSchemaDescriptor::build (pn_data_t * data_) const {
 
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
-TransformElementDescriptor::build (pn_data_t * data_) const {
+TransformElementDescriptor::build (codec::Decoder * data_) const {
     validateAndNext (data_);
 
     DBG ("TRANSFORM ELEMENT " << data_ << std::endl); // NOLINT
@@ -81,7 +79,7 @@ TransformElementDescriptor::build (pn_data_t * data_) const {
 
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
-TransformElementKeyDescriptor::build (pn_data_t * data_) const {
+TransformElementKeyDescriptor::build (codec::Decoder * data_) const {
     validateAndNext (data_);
 
     DBG ("TRANSFORM ELEMENT KEY" << data_ << std::endl); // NOLINT
@@ -12,12 +12,14 @@
 #include "amqp/AMQPDescribed.h"
 #include "AMQPDescriptor.h"
 #include "amqp/schema/Descriptor.h"
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
 #include "AMQPDescriptorRegistory.h"
 
 /******************************************************************************/
 
-struct pn_data_t;
+namespace amqp::codec {
+    class Decoder;
+}
 
 /******************************************************************************/
 
@@ -31,16 +33,16 @@ namespace amqp::internal::descriptors {
      */
     template<class T>
     uPtr <T>
-    dispatchDescribed(pn_data_t *data_) {
-        proton::is_described(data_);
-        proton::auto_enter p(data_);
-        proton::is_ulong(data_);
+    dispatchDescribed(codec::Decoder *data_) {
+        codec::is_described(data_);
+        codec::auto_enter p(data_);
+        codec::is_ulong(data_);
 
-        auto id = pn_data_get_ulong(data_);
+        auto id = data_->getULong();
 
         return uPtr<T>(
             static_cast<T *>(
-                amqp::AMQPDescriptorRegistory[id]->build(data_).release()));
+                amqp::descriptorFor (id).build(data_).release()));
     }
 }
 
@@ -57,15 +59,13 @@ namespace amqp::internal {
 
     class ReferencedObjectDescriptor : public AMQPDescriptor {
         public :
-            ReferencedObjectDescriptor() : AMQPDescriptor() { }
+            constexpr ReferencedObjectDescriptor() : AMQPDescriptor() { }
 
-            ReferencedObjectDescriptor(const std::string & symbol_, int val_)
+            constexpr ReferencedObjectDescriptor (std::string_view symbol_, int val_)
                 : AMQPDescriptor(symbol_, val_)
             { }
 
-            ~ReferencedObjectDescriptor() final = default;
-
-            std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
+            std::unique_ptr<AMQPDescribed> build (codec::Decoder *) const override;
     };
 
 }
@@ -76,15 +76,13 @@ namespace amqp::internal {
 
     class TransformSchemaDescriptor : public AMQPDescriptor {
         public :
-            TransformSchemaDescriptor() : AMQPDescriptor() { }
+            constexpr TransformSchemaDescriptor() : AMQPDescriptor() { }
 
-            TransformSchemaDescriptor(const std::string & symbol_, int val_)
+            constexpr TransformSchemaDescriptor (std::string_view symbol_, int val_)
                 : AMQPDescriptor(symbol_, val_)
             { }
 
-            ~TransformSchemaDescriptor() final = default;
-
-            std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
+            std::unique_ptr<AMQPDescribed> build (codec::Decoder *) const override;
     };
 
 }
@@ -95,15 +93,13 @@ namespace amqp::internal {
 
     class TransformElementDescriptor : public AMQPDescriptor {
         public :
-            TransformElementDescriptor() : AMQPDescriptor() { }
+            constexpr TransformElementDescriptor() : AMQPDescriptor() { }
 
-            TransformElementDescriptor(const std::string & symbol_, int val_)
+            constexpr TransformElementDescriptor (std::string_view symbol_, int val_)
                 : AMQPDescriptor(symbol_, val_)
             { }
 
-            ~TransformElementDescriptor() final = default;
-
-            std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
+            std::unique_ptr<AMQPDescribed> build (codec::Decoder *) const override;
     };
 
 }
@@ -114,15 +110,13 @@ namespace amqp::internal {
 
     class TransformElementKeyDescriptor : public AMQPDescriptor {
         public :
-            TransformElementKeyDescriptor() : AMQPDescriptor() { }
+            constexpr TransformElementKeyDescriptor() : AMQPDescriptor() { }
 
-            TransformElementKeyDescriptor(const std::string & symbol_, int val_)
+            constexpr TransformElementKeyDescriptor (std::string_view symbol_, int val_)
                 : AMQPDescriptor(symbol_, val_)
             { }
 
-            ~TransformElementKeyDescriptor() final = default;
-
-            std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
+            std::unique_ptr<AMQPDescribed> build (codec::Decoder *) const override;
     };
 
 }
@@ -3,26 +3,17 @@
 
 #include "types.h"
 
-#include "proton/proton_wrapper.h"
-
-/******************************************************************************/
-
-amqp::internal::
-ChoiceDescriptor::ChoiceDescriptor (
-    const std::string & symbol_,
-    int val_
-) : AMQPDescriptor (symbol_, val_) {
-}
+#include "amqp/codec/Decoder.h"
 
 /******************************************************************************/
 
 std::unique_ptr<amqp::AMQPDescribed>
 amqp::internal::
-ChoiceDescriptor::build (pn_data_t * data_) const  {
+ChoiceDescriptor::build (codec::Decoder * data_) const  {
     validateAndNext (data_);
-    proton::auto_enter ae (data_);
+    codec::auto_enter ae (data_);
 
-    auto name = proton::get_string (data_);
+    std::string name { codec::get_string (data_) };
 
     return std::make_unique<schema::Choice> (name);
 }
@@ -14,11 +14,11 @@ namespace amqp::internal {
         public :
             ChoiceDescriptor() = delete;
 
-            ChoiceDescriptor (const std::string &, int);
+            constexpr ChoiceDescriptor (std::string_view symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
+            { }
 
-            ~ChoiceDescriptor() final = default;
-
-            std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
+            std::unique_ptr<AMQPDescribed> build (codec::Decoder *) const override;
     };
 
 }
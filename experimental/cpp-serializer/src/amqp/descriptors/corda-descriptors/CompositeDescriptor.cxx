@@ -7,7 +7,7 @@
 #include "types.h"
 #include "debug.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
 
 #include "amqp/descriptors/AMQPDescriptors.h"
 
@@ -21,57 +21,47 @@
  *
  ******************************************************************************/
 
-amqp::internal::
-CompositeDescriptor::CompositeDescriptor (
-    const std::string & symbol_,
-    int val_
-) : AMQPDescriptor (symbol_, val_) {
-
-}
-
-/******************************************************************************/
-
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
-CompositeDescriptor::build (pn_data_t * data_) const {
+CompositeDescriptor::build (codec::Decoder * data_) const {
     DBG ("COMPOSITE" << std::endl); // NOLINT
 
     validateAndNext(data_);
 
-    proton::auto_enter p (data_);
+    codec::auto_enter p (data_);
 
     /* Class Name - String */
-    auto name = proton::get_string(data_);
+    std::string name { codec::get_string (data_) };
 
-    pn_data_next(data_);
+    data_->next();
 
     /* Label Name - Nullable String */
-    auto label = proton::get_string (data_, true);
+    std::string label { codec::get_string (data_, true) };
 
-    pn_data_next(data_);
+    data_->next();
 
     /* provides: List<String> */
     std::list<std::string> provides;
     {
-        proton::auto_list_enter p2 (data_);
-        while (pn_data_next(data_)) {
-            provides.push_back (proton::get_string (data_));
+        codec::auto_list_enter p2 (data_);
+        while (data_->next()) {
+            provides.emplace_back (codec::get_string (data_));
         }
     }
 
-    pn_data_next (data_);
+    data_->next();
 
     /* descriptor: Descriptor */
     auto descriptor = descriptors::dispatchDescribed<schema::Descriptor>(data_);
 
-    pn_data_next (data_);
+    data_->next();
 
     /* fields: List<Described>*/
     std::vector<uPtr<schema::Field>> fields;
-    fields.reserve (pn_data_get_list (data_));
+    fields.reserve (data_->getList());
     {
-        proton::auto_list_enter p2 (data_);
-        while (pn_data_next (data_)) {
+        codec::auto_list_enter p2 (data_);
+        while (data_->next()) {
             fields.emplace_back (descriptors::dispatchDescribed<schema::Field>(data_));
         }
     }
@@ -90,58 +80,58 @@ CompositeDescriptor::build (pn_data_t * data_) const {
 void
 amqp::internal::
 CompositeDescriptor::read (
-        pn_data_t * data_,
+        codec::Decoder * data_,
         std::stringstream & ss_,
         const AutoIndent & ai_
 ) const {
-    proton::is_list(data_);
+    codec::is_list(data_);
 
     {
         AutoIndent ai { ai_ };
-        proton::auto_enter p (data_);
+        codec::auto_enter p (data_);
 
-        proton::is_string (data_);
+        codec::is_string (data_);
         ss_ << ai
             << "1] String: ClassName: "
-            << proton::readAndNext<std::string>(data_)
+            << codec::readAndNext<std::string>(data_)
             << std::endl;
 
-        proton::is_string (data_);
+        codec::is_string (data_, true);
         ss_ << ai
             << "2] String: Label: \""
-            << proton::readAndNext<std::string>(data_, true)
+            << codec::readAndNext<std::string>(data_, true)
             << "\"" << std::endl;
 
-        proton::is_list (data_);
+        codec::is_list (data_);
 
         ss_ << ai << "3] List: Provides: [ ";
         {
-            proton::auto_list_enter ale (data_);
-            while (pn_data_next(data_)) {
-                ss_ << ai << (proton::get_string (data_)) << " ";
+            codec::auto_list_enter ale (data_);
+            while (data_->next()) {
+                ss_ << ai << (codec::get_string (data_)) << " ";
             }
         }
         ss_ << "]" << std::endl;
 
-        pn_data_next (data_);
-        proton::is_described (data_);
+        data_->next();
+        codec::is_described (data_);
 
         ss_ << ai << "4] Descriptor:" << std::endl;
 
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
-            (pn_data_t *)proton::auto_next(data_), ss_, AutoIndent { ai });
+        describedDescriptor().read (
+            (codec::Decoder *)codec::auto_next(data_), ss_, AutoIndent { ai });
 
         ss_ << ai << "5] List: Fields: " << std::endl;
         {
             AutoIndent ai2 { ai };
 
-            proton::auto_list_enter ale (data_);
-            for (int i { 1 } ; pn_data_next (data_) ; ++i) {
+            codec::auto_list_enter ale (data_);
+            for (int i { 1 } ; data_->next() ; ++i) {
                 ss_ << ai2 << i << "/"
                     << ale.elements() << "]"
                     << std::endl;
 
-                AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+                describedDescriptor().read (
                         data_, ss_, AutoIndent { ai2 });
             }
         }
@@ -9,14 +9,14 @@ namespace amqp::internal {
     class CompositeDescriptor : public AMQPDescriptor {
         public :
             CompositeDescriptor() = delete;
-            CompositeDescriptor (const std::string &, int);
+            constexpr CompositeDescriptor (std::string_view symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
+            { }
 
-            ~CompositeDescriptor() final = default;
-
-            std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
+            std::unique_ptr<AMQPDescribed> build (codec::Decoder *) const override;
 
             void read (
-                pn_data_t *,
+                codec::Decoder *,
                 std::stringstream &,
                 const AutoIndent &) const override;
     };
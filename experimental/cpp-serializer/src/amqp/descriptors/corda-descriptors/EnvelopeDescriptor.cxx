@@ -2,7 +2,7 @@
 
 #include "amqp/schema/Schema.h"
 #include "amqp/schema/Envelope.h"
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
 
 #include "types.h"
 #include "debug.h"
@@ -14,10 +14,10 @@
 namespace {
 
     const std::string
-    consumeBlob (pn_data_t * data_) {
-        proton::is_described (data_);
-        proton::auto_enter p (data_);
-        return proton::get_symbol<std::string> (data_);
+    consumeBlob (amqp::codec::Decoder * data_) {
+        amqp::codec::is_described (data_);
+        amqp::codec::auto_enter p (data_);
+        return amqp::codec::get_symbol<std::string> (data_);
     }
 
 }
@@ -37,47 +37,37 @@ namespace {
 void
 amqp::internal::
 EnvelopeDescriptor::read (
-        pn_data_t * data_, std::stringstream & ss_, const AutoIndent & ai_
+        codec::Decoder * data_, std::stringstream & ss_, const AutoIndent & ai_
 ) const {
     // lets just make sure we haven't entered this already
-    proton::is_list (data_);
+    codec::is_list (data_);
 
     {
         AutoIndent ai { ai_ };
-        proton::auto_enter p (data_);
+        codec::auto_enter p (data_);
 
         ss_ << ai << "1]" << std::endl;
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
-                (pn_data_t *)proton::auto_next (data_), ss_, AutoIndent { ai });
+        describedDescriptor().read (
+                (codec::Decoder *)codec::auto_next (data_), ss_, AutoIndent { ai });
 
 
         ss_ << ai << "2]" << std::endl;
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
-                (pn_data_t *)proton::auto_next(data_), ss_, AutoIndent { ai });
+        describedDescriptor().read (
+                (codec::Decoder *)codec::auto_next(data_), ss_, AutoIndent { ai });
 
     }
 }
 
 /******************************************************************************/
 
-amqp::internal::
-EnvelopeDescriptor::EnvelopeDescriptor (
-    const std::string & symbol_,
-    int val_
-) : AMQPDescriptor (symbol_, val_) {
-
-}
-
-/******************************************************************************/
-
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
-EnvelopeDescriptor::build (pn_data_t * data_) const {
+EnvelopeDescriptor::build (codec::Decoder * data_) const {
     DBG ("ENVELOPE" << std::endl); // NOLINT
 
     validateAndNext(data_);
 
-    proton::auto_enter p (data_);
+    codec::auto_enter p (data_);
 
     /*
      * The actual blob... if this was java we would use the type symbols
@@ -87,14 +77,14 @@ EnvelopeDescriptor::build (pn_data_t * data_) const {
      */
     std::string outerType = consumeBlob(data_);
 
-    pn_data_next (data_);
+    data_->next();
 
     /*
      * The schema
      */
     auto schema = descriptors::dispatchDescribed<schema::Schema> (data_);
 
-    pn_data_next(data_);
+    data_->next();
 
     /*
      * The transforms schema
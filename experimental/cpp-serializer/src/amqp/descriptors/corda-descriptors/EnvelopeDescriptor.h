@@ -11,7 +11,9 @@
  *
  ******************************************************************************/
 
-struct pn_data_t;
+namespace amqp::codec {
+    class Decoder;
+}
 
 /******************************************************************************
  *
@@ -24,14 +26,14 @@ namespace amqp::internal {
     class EnvelopeDescriptor : public AMQPDescriptor {
         public :
             EnvelopeDescriptor() = delete;
-            EnvelopeDescriptor (const std::string &, int);
-
-            ~EnvelopeDescriptor() final = default;
+            constexpr EnvelopeDescriptor (std::string_view symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
+            { }
 
-            std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
+            std::unique_ptr<AMQPDescribed> build (codec::Decoder *) const override;
 
             void read (
-                    pn_data_t *,
+                    codec::Decoder *,
                     std::stringstream &,
                     const AutoIndent &) const override;
     };
@@ -3,7 +3,7 @@
 #include "debug.h"
 #include "types.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
 
 #include "amqp/schema/Field.h"
 
@@ -15,64 +15,54 @@
  *
  ******************************************************************************/
 
-amqp::internal::
-FieldDescriptor::FieldDescriptor (
-    const std::string & symbol_,
-    int val_
-) : AMQPDescriptor(symbol_, val_) {
-
-}
-
-/******************************************************************************/
-
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
-FieldDescriptor::build(pn_data_t * data_) const {
+FieldDescriptor::build(codec::Decoder * data_) const {
     DBG ("FIELD" << std::endl); // NOLINT
 
     validateAndNext (data_);
 
-    proton::auto_enter ae (data_);
+    codec::auto_enter ae (data_);
 
     /* name: String */
-    auto name = proton::get_string (data_);
+    std::string name { codec::get_string (data_) };
 
-    pn_data_next (data_);
+    data_->next();
 
     /* type: String */
-    auto type = proton::get_string (data_);
+    std::string type { codec::get_string (data_) };
 
-    pn_data_next (data_);
+    data_->next();
 
     /* requires: List<String> */
     std::list<std::string> requires;
     {
-        proton::auto_list_enter ale (data_);
-        while (pn_data_next(data_)) {
-            requires.push_back (proton::get_string(data_));
+        codec::auto_list_enter ale (data_);
+        while (data_->next()) {
+            requires.emplace_back (codec::get_string (data_));
         }
     }
 
-    pn_data_next (data_);
+    data_->next();
 
     /* default: String? */
-    auto def = proton::get_string (data_, true);
+    std::string def { codec::get_string (data_, true) };
 
-    pn_data_next (data_);
+    data_->next();
 
     /* label: String? */
-    auto label = proton::get_string (data_, true);
+    std::string label { codec::get_string (data_, true) };
 
-    pn_data_next (data_);
+    data_->next();
 
     /* mandatory: Boolean - copes with the Kotlin concept of nullability.
        If something is mandatory then it cannot be null */
-    auto mandatory = proton::get_boolean (data_);
+    auto mandatory = codec::get_boolean (data_);
 
-    pn_data_next (data_);
+    data_->next();
 
     /* multiple: Boolean */
-    auto multiple = proton::get_boolean(data_);
+    auto multiple = codec::get_boolean(data_);
 
     return std::make_unique<schema::Field> (
             name, type, requires, def, label, mandatory, multiple);
@@ -83,50 +73,50 @@ FieldDescriptor::build(pn_data_t * data_) const {
 void
 amqp::internal::
 FieldDescriptor::read (
-        pn_data_t * data_,
+        codec::Decoder * data_,
         std::stringstream & ss_,
         const AutoIndent & ai_
 ) const  {
-    proton::is_list (data_);
+    codec::is_list (data_);
 
-    proton::auto_list_enter ale (data_, true);
+    codec::auto_list_enter ale (data_, true);
     AutoIndent ai { ai_ };
 
     ss_ << ai << "1/7] String: Name: "
-        << proton::get_string ((pn_data_t *)proton::auto_next (data_))
+        << codec::get_string ((codec::Decoder *)codec::auto_next (data_))
         << std::endl;
     ss_ << ai << "2/7] String: Type: "
-        << proton::get_string ((pn_data_t *)proton::auto_next (data_))
+        << codec::get_string ((codec::Decoder *)codec::auto_next (data_))
         << std::endl;
 
     {
-        proton::auto_list_enter ale2 (data_);
+        codec::auto_list_enter ale2 (data_);
 
         ss_ << ai << "3/7] List: Requires: elements " << ale2.elements()
             << std::endl;
 
         AutoIndent ai2 { ai };
 
-        while (pn_data_next(data_)) {
-            ss_ << ai2 << proton::get_string (data_) << std::endl;
+        while (data_->next()) {
+            ss_ << ai2 << codec::get_string (data_) << std::endl;
         }
     }
 
-    pn_data_next (data_);
+    data_->next();
 
-    proton::is_string (data_, true);
+    codec::is_string (data_, true);
 
     ss_ << ai << "4/7] String: Default: "
-        << proton::get_string ((pn_data_t *)proton::auto_next (data_), true)
+        << codec::get_string ((codec::Decoder *)codec::auto_next (data_), true)
         << std::endl;
     ss_ << ai << "5/7] String: Label: "
-        << proton::get_string ((pn_data_t *)proton::auto_next (data_), true)
+        << codec::get_string ((codec::Decoder *)codec::auto_next (data_), true)
         << std::endl;
     ss_ << ai << "6/7] Boolean: Mandatory: "
-        << proton::get_boolean ((pn_data_t *)proton::auto_next (data_))
+        << codec::get_boolean ((codec::Decoder *)codec::auto_next (data_))
         << std::endl;
     ss_ << ai << "7/7] Boolean: Multiple: "
-        << proton::get_boolean ((pn_data_t *)proton::auto_next (data_))
+        << codec::get_boolean ((codec::Decoder *)codec::auto_next (data_))
         << std::endl;
 }
 
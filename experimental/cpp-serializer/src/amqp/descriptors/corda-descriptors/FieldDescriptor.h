@@ -2,7 +2,6 @@
 
 /******************************************************************************/
 
-#include "proton/codec.h"
 #include "amqp/AMQPDescribed.h"
 #include "amqp/descriptors/AMQPDescriptor.h"
 
@@ -13,14 +12,14 @@ namespace amqp::internal {
     class FieldDescriptor : public AMQPDescriptor {
         public :
             FieldDescriptor() = delete;
-            FieldDescriptor (const std::string &, int);
+            constexpr FieldDescriptor (std::string_view symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
+            { }
 
-            ~FieldDescriptor() final = default;
-
-            std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
+            std::unique_ptr<AMQPDescribed> build (codec::Decoder *) const override;
 
             void read (
-                pn_data_t *,
+                codec::Decoder *,
                 std::stringstream &,
                 const AutoIndent &) const override;
     };
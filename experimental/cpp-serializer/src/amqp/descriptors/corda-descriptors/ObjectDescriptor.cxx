@@ -3,7 +3,7 @@
 #include "types.h"
 #include "debug.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
 #include "amqp/schema/Descriptor.h"
 
 #include <sstream>
@@ -14,28 +14,19 @@
  *
  ******************************************************************************/
 
-amqp::internal::
-ObjectDescriptor::ObjectDescriptor (
-    const std::string & symbol_,
-    int val_
-) : AMQPDescriptor (symbol_, val_) {
-}
-
-/******************************************************************************/
-
 /**
  *
  */
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
-ObjectDescriptor::build(pn_data_t * data_) const {
+ObjectDescriptor::build(codec::Decoder * data_) const {
     DBG ("DESCRIPTOR" << std::endl); // NOLINT
 
     validateAndNext (data_);
 
-    proton::auto_enter p (data_);
+    codec::auto_enter p (data_);
 
-    auto symbol = proton::get_symbol<std::string> (data_);
+    auto symbol = codec::get_symbol<std::string> (data_);
 
     return std::make_unique<schema::Descriptor> (symbol);
 }
@@ -45,20 +36,20 @@ ObjectDescriptor::build(pn_data_t * data_) const {
 void
 amqp::internal::
 ObjectDescriptor::read (
-        pn_data_t * data_,
+        codec::Decoder * data_,
         std::stringstream & ss_,
         const AutoIndent & ai_
 ) const  {
-    proton::is_list (data_);
+    codec::is_list (data_);
 
     {
         AutoIndent ai { ai_ };
-        proton::auto_list_enter ale (data_);
-        pn_data_next(data_);
+        codec::auto_list_enter ale (data_);
+        data_->next();
 
         ss_ << ai << "1/2] "
-            << proton::get_symbol<std::string>(
-                          (pn_data_t *)proton::auto_next (data_))
+            << codec::get_symbol<std::string>(
+                          (codec::Decoder *)codec::auto_next (data_))
             << std::endl;
 
         ss_ << ai << "2/2] " << data_ << std::endl;
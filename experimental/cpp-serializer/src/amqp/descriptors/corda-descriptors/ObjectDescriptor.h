@@ -6,7 +6,9 @@
 
 /******************************************************************************/
 
-struct pn_data_t;
+namespace amqp::codec {
+    class Decoder;
+}
 
 /******************************************************************************/
 
@@ -16,14 +18,14 @@ namespace amqp::internal {
     public :
         ObjectDescriptor() = delete;
 
-        ObjectDescriptor(const std::string &, int);
-
-        ~ObjectDescriptor() final = default;
+        constexpr ObjectDescriptor (std::string_view symbol_, int val_)
+            : AMQPDescriptor (symbol_, val_)
+        { }
 
-        std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
+        std::unique_ptr<AMQPDescribed> build (codec::Decoder *) const override;
 
         void read (
-                pn_data_t *,
+                codec::Decoder *,
                 std::stringstream &,
                 const AutoIndent &) const override;
     };
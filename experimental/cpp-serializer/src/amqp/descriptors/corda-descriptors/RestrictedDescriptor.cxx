@@ -28,43 +28,43 @@
 
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
-RestrictedDescriptor::build (pn_data_t * data_) const {
+RestrictedDescriptor::build (codec::Decoder * data_) const {
     DBG ("RESTRICTED" << std::endl); // NOLINT
     validateAndNext(data_);
 
-    proton::auto_enter ae (data_);
+    codec::auto_enter ae (data_);
 
-    auto name  = proton::readAndNext<std::string>(data_);
-    auto label = proton::readAndNext<std::string>(data_, true);
+    auto name  = codec::readAndNext<std::string>(data_);
+    auto label = codec::readAndNext<std::string>(data_, true);
 
     DBG ("  name: " << name << ", label: \"" << label << "\"" << std::endl);
 
     std::vector<std::string> provides;
     {
-        proton::auto_list_enter ae2 (data_);
-        while (pn_data_next(data_)) {
-            provides.push_back (proton::get_string (data_));
+        codec::auto_list_enter ae2 (data_);
+        while (data_->next()) {
+            provides.emplace_back (codec::get_string (data_));
 
             DBG ("  provides: " << provides.back() << std::endl);
         }
     }
 
-    pn_data_next (data_);
+    data_->next();
 
-    auto source = proton::readAndNext<std::string> (data_);
+    auto source = codec::readAndNext<std::string> (data_);
 
     DBG ("source: " << source << std::endl);
 
     auto descriptor = descriptors::dispatchDescribed<schema::Descriptor> (data_);
 
-    pn_data_next (data_);
+    data_->next();
 
     DBG ("choices: " << data_ << std::endl);
 
     std::vector<std::unique_ptr<schema::Choice>> choices;
     {
-        proton::auto_list_enter ae2 (data_);
-        while (pn_data_next (data_)) {
+        codec::auto_list_enter ae2 (data_);
+        while (data_->next()) {
             choices.push_back (
                 descriptors::dispatchDescribed<schema::Choice> (data_));
 
@@ -88,39 +88,39 @@ RestrictedDescriptor::build (pn_data_t * data_) const {
 void
 amqp::internal::
 RestrictedDescriptor::read (
-        pn_data_t * data_,
+        codec::Decoder * data_,
         std::stringstream & ss_,
         const AutoIndent & ai_
 ) const {
-    proton::is_list (data_);
-    proton::auto_enter ae (data_);
+    codec::is_list (data_);
+    codec::auto_enter ae (data_);
     AutoIndent ai { ai_ };
 
     ss_ << ai << "1] String: Name: "
-        << proton::readAndNext<std::string> (data_)
+        << codec::readAndNext<std::string> (data_)
         << std::endl;
     ss_ << ai << "2] String: Label: "
-        << proton::readAndNext<std::string> (data_, true)
+        << codec::readAndNext<std::string> (data_, true)
         << std::endl;
     ss_ << ai << "3] List: Provides: [ ";
 
     {
-        proton::auto_list_enter ae2 (data_);
-        while (pn_data_next(data_)) {
-            ss_ << proton::get_string (data_) << " ";
+        codec::auto_list_enter ae2 (data_);
+        while (data_->next()) {
+            ss_ << codec::get_string (data_) << " ";
         }
         ss_ << "]" << std::endl;
     }
 
-    pn_data_next (data_);
+    data_->next();
     ss_ << ai << "4] String: Source: "
-        << proton::readAndNext<std::string> (data_)
+        << codec::readAndNext<std::string> (data_)
         << std::endl;
 
     ss_ << ai << "5] Descriptor:" << std::endl;
 
-    AMQPDescriptorRegistory[pn_data_type(data_)]->read (
-            (pn_data_t *)proton::auto_next(data_), ss_, AutoIndent { ai });
+    describedDescriptor().read (
+            (codec::Decoder *)codec::auto_next(data_), ss_, AutoIndent { ai });
 }
 
 /******************************************************************************/
@@ -14,16 +14,14 @@ namespace amqp::internal {
     public :
         RestrictedDescriptor() = delete;
 
-        RestrictedDescriptor(const std::string & symbol_, int val_)
+        constexpr RestrictedDescriptor (std::string_view symbol_, int val_)
                 : AMQPDescriptor(symbol_, val_)
         { }
 
-        ~RestrictedDescriptor() final = default;
-
-        std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
+        std::unique_ptr<AMQPDescribed> build (codec::Decoder *) const override;
 
         void read (
-                pn_data_t *,
+                codec::Decoder *,
                 std::stringstream &,
                 const AutoIndent &) const override;
     };
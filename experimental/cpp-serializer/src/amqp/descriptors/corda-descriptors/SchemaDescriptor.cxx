@@ -4,30 +4,22 @@
 #include "debug.h"
 #include "AMQPDescriptor.h"
 
-#include "proton/codec.h"
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
 #include "amqp/AMQPDescribed.h"
 #include "amqp/descriptors/AMQPDescriptors.h"
 #include "amqp/schema/Schema.h"
 #include "amqp/schema/OrderedTypeNotations.h"
 #include "amqp/schema/AMQPTypeNotation.h"
 
+#include <vector>
 #include <sstream>
-
-/******************************************************************************/
-
-amqp::internal::
-SchemaDescriptor::SchemaDescriptor (
-    const std::string & symbol_,
-    int val_
-) : AMQPDescriptor (symbol_, val_) {
-}
+#include <stdexcept>
 
 /******************************************************************************/
 
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
-SchemaDescriptor::build (pn_data_t * data_) const {
+SchemaDescriptor::build (codec::Decoder * data_) const {
     DBG ("SCHEMA" << std::endl); // NOLINT
 
     validateAndNext(data_);
@@ -38,12 +30,12 @@ SchemaDescriptor::build (pn_data_t * data_) const {
      * The Schema is stored as a list of lists of described objects
      */
     {
-        proton::auto_list_enter ale (data_);
+        codec::auto_list_enter ale (data_);
 
-        for (int i { 1 } ; pn_data_next(data_) ; ++i) {
+        for (int i { 1 } ; data_->next() ; ++i) {
             DBG ("  " << i << "/" << ale.elements() <<  std::endl); // NOLINT
-            proton::auto_list_enter ale2 (data_);
-            while (pn_data_next(data_)) {
+            codec::auto_list_enter ale2 (data_);
+            while (data_->next()) {
                 schemas.insert (
                     descriptors::dispatchDescribed<schema::AMQPTypeNotation> (
                         data_));
@@ -60,30 +52,30 @@ SchemaDescriptor::build (pn_data_t * data_) const {
 void
 amqp::internal::
 SchemaDescriptor::read (
-        pn_data_t * data_,
+        codec::Decoder * data_,
         std::stringstream & ss_,
         const AutoIndent & ai_
 ) const {
-    proton::is_list (data_);
+    codec::is_list (data_);
 
     {
         AutoIndent ai { ai_ };
-        proton::auto_list_enter ale (data_);
+        codec::auto_list_enter ale (data_);
 
-        for (int i { 1 } ; pn_data_next (data_) ; ++i) {
-            proton::is_list (data_);
+        for (int i { 1 } ; data_->next() ; ++i) {
+            codec::is_list (data_);
             ss_ << ai << i << "/" << ale.elements() <<"]";
 
             AutoIndent ai2 { ai };
 
-            proton::auto_list_enter ale2 (data_);
+            codec::auto_list_enter ale2 (data_);
             ss_ << " list: entries: " << ale2.elements() << std::endl;
 
-            for (int j { 1 } ; pn_data_next (data_) ; ++j) {
+            for (int j { 1 } ; data_->next() ; ++j) {
                 ss_ << ai2 << i << ":" << j << "/" << ale2.elements()
                         << "] " << std::endl;
 
-                AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+                describedDescriptor().read (
                         data_, ss_,
                         AutoIndent { ai2 });
             }
@@ -92,3 +84,67 @@ SchemaDescriptor::read (
 }
 
 /******************************************************************************/
+
+/**
+ * Both composite and restricted types start with their name and have
+ * their descriptor as the first described value in their list, which is
+ * all we need to know to find them again
+ */
+uPtr<amqp::internal::schema::Schema>
+amqp::internal::descriptors::
+dispatchUnparsed (codec::Decoder * data_) {
+    codec::is_described (data_);
+    codec::auto_enter ae (data_);
+
+    codec::is_ulong (data_);
+    if (stripCorda (data_->getULong()) != static_cast<uint32_t> (SCHEMA)) {
+        throw std::runtime_error ("Expected a Schema");
+    }
+
+    data_->next();
+
+    std::vector<schema::Unparsed> types;
+
+    codec::auto_list_enter ale (data_);
+
+    while (data_->next()) {
+        codec::auto_list_enter ale2 (data_);
+
+        while (data_->next()) {
+            auto encoded = data_->raw();
+
+            codec::is_described (data_);
+            codec::auto_enter ae2 (data_);
+
+            data_->next();
+            codec::auto_enter ae3 (data_);
+
+            schema::Symbol name { codec::get_string (data_) };
+
+            while (!data_->isDescribed()) {
+                if (!data_->next()) {
+                    throw std::runtime_error (
+                            "No descriptor for " + name.str());
+                }
+            }
+
+            schema::Symbol descriptor;
+            {
+                codec::auto_enter ae4 (data_);
+                data_->next();
+                codec::auto_enter ae5 (data_);
+
+                descriptor = schema::Symbol {
+                        codec::get_symbol<std::string_view> (data_) };
+            }
+
+            DBG ("  unparsed: " << name << " " << descriptor << std::endl); // NOLINT
+
+            types.push_back ({ name, descriptor, encoded });
+        }
+    }
+
+    return std::make_unique<schema::Schema> (std::move (types));
+}
+
+/******************************************************************************/
@@ -1,10 +1,18 @@
 #pragma once
 
+#include "types.h"
+
 #include "amqp/descriptors/AMQPDescriptor.h"
 
 /******************************************************************************/
 
-struct pn_data_t;
+namespace amqp::codec {
+    class Decoder;
+}
+
+namespace amqp::internal::schema {
+    class Schema;
+}
 
 /******************************************************************************/
 
@@ -13,13 +21,13 @@ namespace amqp::internal {
     class SchemaDescriptor : public AMQPDescriptor {
     public :
         SchemaDescriptor() = delete;
-        SchemaDescriptor (const std::string &, int);
-        ~SchemaDescriptor() final = default;
-
-        std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
+        constexpr SchemaDescriptor (std::string_view symbol_, int val_)
+            : AMQPDescriptor (symbol_, val_)
+        { }
+        std::unique_ptr<AMQPDescribed> build (codec::Decoder *) const override;
 
         void read (
-                pn_data_t *,
+                codec::Decoder *,
                 std::stringstream &,
                 const AutoIndent &) const override;
     };
@@ -27,3 +35,17 @@ namespace amqp::internal {
 }
 
 /******************************************************************************/
+
+namespace amqp::internal::descriptors {
+
+    /**
+     * Like dispatchDescribed<schema::Schema> but rather than decoding
+     * every type in the schema only reads each one's name and descriptor,
+     * leaving the rest to schema::Schema::materialise. The schema keeps
+     * views into [data_]'s buffer so that has to outlive it
+     */
+    uPtr<schema::Schema> dispatchUnparsed (codec::Decoder * data_);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,226 @@
+#include "Compiler.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "debug.h"
+
+#include "reader/Reader.h"
+
+/******************************************************************************
+ *
+ * class Compiler
+ *
+ ******************************************************************************/
+
+amqp::internal::plan::
+Compiler::Compiler (const Projection & projection_)
+    : m_projection (&projection_)
+{
+}
+
+/******************************************************************************/
+
+amqp::internal::plan::DecodePlan
+amqp::internal::plan::
+Compiler::compile (
+    const reader::Reader & reader_,
+    const schema::ISchemaType & schema_
+) {
+    return compile (reader_, schema_, Projection());
+}
+
+/******************************************************************************/
+
+amqp::internal::plan::DecodePlan
+amqp::internal::plan::
+Compiler::compile (
+    const reader::Reader & reader_,
+    const schema::ISchemaType & schema_,
+    const Projection & projection_
+) {
+    Compiler compiler (projection_);
+
+    reader_.compile (compiler, schema_);
+    compiler.emit (Op::RET);
+
+    while (!compiler.m_pending.empty()) {
+        auto routine = std::move (compiler.m_pending.front());
+        compiler.m_pending.pop_front();
+
+        compiler.m_entries[compiler.m_routines[routine.first]] = compiler.here();
+        compiler.m_projection = routine.first.second;
+        routine.second (compiler);
+        compiler.emit (Op::RET);
+    }
+
+    compiler.check (projection_);
+
+    // calls were emitted with the routine number as we didn't know where
+    // they'd start at the time
+    for (auto & instruction : compiler.m_plan.m_code) {
+        if (instruction.m_op == Op::CALL) {
+            instruction.m_target = compiler.m_entries[instruction.m_arg];
+        }
+    }
+
+    DBG ("Compiled plan for " << reader_.type() << std::endl
+        << compiler.m_plan << std::endl); // NOLINT
+
+    return std::move (compiler.m_plan);
+}
+
+/******************************************************************************/
+
+/**
+ * Every part of the projection that picks fields out should have been
+ * looked at by a composite, if not the path ran into something that
+ * doesn't have any
+ */
+void
+amqp::internal::plan::
+Compiler::check (const Projection & projection_) const {
+    if (projection_.everything()) {
+        return;
+    }
+
+    if (m_resolved.find (&projection_) == m_resolved.end()) {
+        throw std::runtime_error (
+                "Cannot select fields from " + projection_.path());
+    }
+
+    for (const auto & field : projection_.fields()) {
+        check (field.second);
+    }
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::plan::
+Compiler::emit (Op op_, uint32_t arg_, uint32_t target_) {
+    // leaving a composite jumps over whatever's left in it anyway, it
+    // just has to pass on that there might have been objects in there
+    if (op_ == Op::END_COMPOSITE
+        && !m_plan.m_code.empty()
+        && m_plan.m_code.back().m_op == Op::SKIP)
+    {
+        target_ |= m_plan.m_code.back().m_target;
+        m_plan.m_code.pop_back();
+    }
+
+    m_plan.m_code.push_back ({ op_, arg_, target_ });
+    return m_plan.m_code.size() - 1;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::plan::
+Compiler::here() const {
+    return m_plan.m_code.size();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::plan::
+Compiler::patch (size_t at_, uint32_t target_) {
+    m_plan.m_code[at_].m_target = target_;
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::internal::plan::
+Compiler::intern (const std::string & str_) {
+    auto it = m_interned.find (str_);
+
+    if (it != m_interned.end()) {
+        return it->second;
+    }
+
+    auto idx = static_cast<uint32_t> (m_plan.m_strings.size());
+    m_plan.m_strings.push_back (str_);
+    m_interned.emplace (str_, idx);
+
+    return idx;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::plan::
+Compiler::call (const reader::Reader & reader_, const Body & body_) {
+    Routine routine { &reader_, m_projection };
+
+    auto it = m_routines.find (routine);
+
+    if (it == m_routines.end()) {
+        auto id = static_cast<uint32_t> (m_entries.size());
+
+        m_entries.push_back (0);
+        m_pending.emplace_back (routine, body_);
+        it = m_routines.emplace (routine, id).first;
+    }
+
+    emit (Op::CALL, it->second);
+}
+
+/******************************************************************************/
+
+const amqp::internal::plan::Projection &
+amqp::internal::plan::
+Compiler::project (
+    const std::string & type_,
+    const std::vector<std::string> & fields_
+) {
+    for (const auto & field : m_projection->fields()) {
+        if (std::find (fields_.begin(), fields_.end(), field.first) == fields_.end()) {
+            throw std::runtime_error (
+                    "No field " + field.second.path() + " in " + type_);
+        }
+    }
+
+    m_resolved.insert (m_projection);
+
+    return *m_projection;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::plan::
+Compiler::within (
+    const Projection & projection_,
+    const std::function<void()> & body_
+) {
+    auto outer = m_projection;
+
+    m_projection = &projection_;
+    body_();
+    m_projection = outer;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::plan::
+Compiler::skip (bool object_) {
+    if (!m_plan.m_code.empty() && m_plan.m_code.back().m_op == Op::SKIP) {
+        ++m_plan.m_code.back().m_arg;
+        m_plan.m_code.back().m_target |= object_;
+    } else {
+        emit (Op::SKIP, 1, object_);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::plan::
+Compiler::object (const reader::Reader & reader_) {
+    emit (Op::OBJECT, reader_.referenceable());
+}
+
+/******************************************************************************/
@@ -0,0 +1,133 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <set>
+#include <deque>
+#include <string>
+#include <functional>
+
+#include "DecodePlan.h"
+#include "Projection.h"
+
+#include "amqp/schema/Schema.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+    class Reader;
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::plan {
+
+    /**
+     * Builds a DecodePlan by asking each reader, starting with the one for
+     * the top level type, to emit the instructions that read its values.
+     *
+     * Readers for simple values emit their instruction inline, composites
+     * and lists wrap theirs in a routine via call. Routines are compiled
+     * one after the other once the current one is finished, a reader seen
+     * a second time just gets another call to the routine already queued
+     * for it.
+     *
+     * When compiling for a Projection readers are compiled against the part
+     * of it that applies to them, a reader wanted differently in different
+     * places gets a routine for each.
+     */
+    class Compiler {
+        public :
+            using Body = std::function<void (Compiler &)>;
+
+        private :
+            DecodePlan m_plan;
+
+            std::map<std::string, uint32_t> m_interned;
+
+            /**
+             * Routine number for every reader we've been asked to call,
+             * where it starts once compiled, and the routines still to do
+             */
+            using Routine = std::pair<const reader::Reader *, const Projection *>;
+
+            std::map<Routine, uint32_t> m_routines;
+            std::vector<uint32_t> m_entries;
+            std::deque<std::pair<Routine, Body>> m_pending;
+
+            /**
+             * What's wanted from whatever we're compiling now, and the
+             * parts of the projection a composite has looked at
+             */
+            const Projection * m_projection;
+            std::set<const Projection *> m_resolved;
+
+            explicit Compiler (const Projection &);
+
+            void check (const Projection &) const;
+
+        public :
+            /**
+             * Compile a plan reading a single value using [reader_]
+             */
+            static DecodePlan compile (
+                    const reader::Reader &,
+                    const schema::ISchemaType &);
+
+            /**
+             * As above reading only the fields [projection_] wants
+             */
+            static DecodePlan compile (
+                    const reader::Reader &,
+                    const schema::ISchemaType &,
+                    const Projection & projection_);
+
+            size_t emit (Op, uint32_t arg_ = 0, uint32_t target_ = 0);
+
+            /**
+             * Position of the next instruction to be emitted, and a way
+             * to point an earlier one at it
+             */
+            size_t here() const;
+            void patch (size_t, uint32_t);
+
+            uint32_t intern (const std::string &);
+
+            /**
+             * Emit a call to the routine for [reader_], the first time
+             * we see a reader [body_] is queued to compile that routine
+             */
+            void call (const reader::Reader &, const Body &);
+
+            /**
+             * For a composite of [type_] with [fields_] what's wanted
+             * from it, an error if that's a field it doesn't have
+             */
+            const Projection & project (
+                    const std::string & type_,
+                    const std::vector<std::string> & fields_);
+
+            /**
+             * Compile [body_] wanting [projection_] from it
+             */
+            void within (const Projection & projection_, const std::function<void()> & body_);
+
+            /**
+             * Step over a value we don't want, runs of these are
+             * merged and any at the end of a composite dropped. Say if
+             * it's an [object_], and might contain others
+             */
+            void skip (bool object_ = false);
+
+            /**
+             * The value read by what [reader_] emits next is somewhere
+             * the blob could have a reference to an earlier object,
+             * see reader::visitObject
+             */
+            void object (const reader::Reader & reader_);
+    };
+
+}
+
+/******************************************************************************/
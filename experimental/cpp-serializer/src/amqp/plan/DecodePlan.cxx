@@ -0,0 +1,344 @@
+#include "DecodePlan.h"
+
+#include <ostream>
+#include <stdexcept>
+
+#include "amqp/codec/Decoder.h"
+#include "reader/Reader.h"
+#include "reader/restricted-readers/EnumReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Enter a described list, the shape both composites and restricted
+     * types are written as, leaving us on its first element. If given
+     * an expected descriptor check that's what we've found
+     */
+    size_t
+    enterDescribedList (
+        amqp::codec::Decoder * data_,
+        const std::string * descriptor_ = nullptr
+    ) {
+        amqp::codec::is_described (data_);
+        amqp::codec::enter (data_);
+
+        if (descriptor_) {
+            auto found = amqp::codec::get_symbol<std::string_view> (data_);
+            if (found != *descriptor_) {
+                throw std::runtime_error (
+                        "Expected " + *descriptor_ + " but found "
+                        + std::string (found));
+            }
+        }
+
+        data_->next();
+
+        amqp::codec::is_list (data_);
+        auto elements = data_->getList();
+        amqp::codec::enter (data_);
+
+        return elements;
+    }
+
+    /**
+     * As enterDescribedList for the described maps restricted map types
+     * are written as, returning the number of entries rather than the
+     * number of keys and values
+     */
+    size_t
+    enterDescribedMap (amqp::codec::Decoder * data_) {
+        amqp::codec::is_described (data_);
+        amqp::codec::enter (data_);
+
+        data_->next();
+
+        amqp::codec::is_map (data_);
+        auto elements = data_->getMap();
+        amqp::codec::enter (data_);
+
+        return elements / 2;
+    }
+
+    /**
+     * The opposite of enterDescribedList, or enterDescribedMap, also
+     * moving past the value as a whole
+     */
+    void
+    exitDescribedList (amqp::codec::Decoder * data_) {
+        data_->exit();
+        data_->exit();
+        data_->next();
+    }
+
+}
+
+/******************************************************************************/
+
+const char *
+amqp::internal::plan::
+opName (Op op_) {
+    switch (op_) {
+        case Op::CALL            : return "CALL";
+        case Op::RET             : return "RET";
+        case Op::BEGIN_COMPOSITE : return "BEGIN_COMPOSITE";
+        case Op::END_COMPOSITE   : return "END_COMPOSITE";
+        case Op::FIELD           : return "FIELD";
+        case Op::BEGIN_LIST      : return "BEGIN_LIST";
+        case Op::LOOP            : return "LOOP";
+        case Op::END_LIST        : return "END_LIST";
+        case Op::BEGIN_MAP       : return "BEGIN_MAP";
+        case Op::END_MAP         : return "END_MAP";
+        case Op::INT             : return "INT";
+        case Op::LONG            : return "LONG";
+        case Op::BOOL            : return "BOOL";
+        case Op::DOUBLE          : return "DOUBLE";
+        case Op::STRING          : return "STRING";
+        case Op::ENUM            : return "ENUM";
+        case Op::SKIP            : return "SKIP";
+        case Op::OBJECT          : return "OBJECT";
+    }
+
+    return "?";
+}
+
+/******************************************************************************
+ *
+ * class DecodePlan
+ *
+ ******************************************************************************/
+
+void
+amqp::internal::plan::
+DecodePlan::run (
+    codec::Decoder * data_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    Stacks stacks;
+
+    execute (0, false, data_, visitor_, stacks);
+}
+
+/******************************************************************************/
+
+/**
+ * Run from [pc_] until we return from the routine we started in or, if
+ * [one_] is set, once the instruction at [pc_] and anything it calls is
+ * done. Returns where we stopped
+ */
+size_t
+amqp::internal::plan::
+DecodePlan::execute (
+    size_t pc_,
+    bool one_,
+    codec::Decoder * data_,
+    amqp::reader::IVisitor & visitor_,
+    Stacks & stacks_
+) const {
+    auto & returns = stacks_.m_returns;
+    auto & remaining = stacks_.m_remaining;
+
+    const Instruction * code = m_code.data();
+    const size_t depth = returns.size();
+    size_t pc { pc_ };
+
+    for (;;) {
+        const Instruction & i = code[pc++];
+
+        switch (i.m_op) {
+            case Op::CALL : {
+                returns.push_back (pc);
+                pc = i.m_target;
+                break;
+            }
+            case Op::RET : {
+                if (returns.size() == depth) {
+                    return pc;
+                }
+                pc = returns.back();
+                returns.pop_back();
+                break;
+            }
+            case Op::OBJECT : {
+                auto referenced = reader::referenced (data_);
+
+                if (!referenced.empty()) {
+                    codec::Decoder replay (referenced, *data_);
+                    execute (pc++, true, &replay, visitor_, stacks_);
+                    data_->next();
+                } else {
+                    auto encoded = data_->raw();
+                    pc = execute (pc, true, data_, visitor_, stacks_);
+
+                    if (i.m_arg) {
+                        data_->remember (encoded);
+                    }
+                }
+                break;
+            }
+            case Op::BEGIN_COMPOSITE : {
+                enterDescribedList (data_, &m_strings[i.m_target]);
+                visitor_.beginComposite (m_strings[i.m_arg]);
+                break;
+            }
+            case Op::END_COMPOSITE : {
+                if (i.m_target) {
+                    data_->forget();
+                }
+                exitDescribedList (data_);
+                visitor_.endComposite();
+                break;
+            }
+            case Op::FIELD : {
+                visitor_.field (m_strings[i.m_arg]);
+                break;
+            }
+            case Op::BEGIN_LIST : {
+                auto elements = enterDescribedList (data_);
+                visitor_.beginList (m_strings[i.m_arg], elements);
+
+                remaining.push_back (elements);
+                if (!elements) {
+                    pc = i.m_target;
+                }
+                break;
+            }
+            case Op::LOOP : {
+                if (--remaining.back()) {
+                    pc = i.m_target;
+                }
+                break;
+            }
+            case Op::END_LIST : {
+                remaining.pop_back();
+                exitDescribedList (data_);
+                visitor_.endList();
+                break;
+            }
+            case Op::BEGIN_MAP : {
+                auto entries = enterDescribedMap (data_);
+                visitor_.beginMap (m_strings[i.m_arg], entries);
+
+                remaining.push_back (entries);
+                if (!entries) {
+                    pc = i.m_target;
+                }
+                break;
+            }
+            case Op::END_MAP : {
+                remaining.pop_back();
+                exitDescribedList (data_);
+                visitor_.endMap();
+                break;
+            }
+            case Op::INT : {
+                visitor_.onInt (codec::readAndNext<int32_t> (data_));
+                break;
+            }
+            case Op::LONG : {
+                visitor_.onLong (codec::readAndNext<long> (data_));
+                break;
+            }
+            case Op::BOOL : {
+                visitor_.onBool (codec::readAndNext<bool> (data_));
+                break;
+            }
+            case Op::DOUBLE : {
+                visitor_.onDouble (codec::readAndNext<double> (data_));
+                break;
+            }
+            case Op::STRING : {
+                visitor_.onString (codec::readAndNext<std::string_view> (data_));
+                break;
+            }
+            case Op::ENUM : {
+                visitor_.onEnum (reader::EnumReader::value (data_));
+                break;
+            }
+            case Op::SKIP : {
+                if (i.m_target) {
+                    data_->forget();
+                }
+                for (uint32_t n { 0 } ; n < i.m_arg ; ++n) {
+                    data_->next();
+                }
+                break;
+            }
+        }
+
+        if (one_ && returns.size() == depth) {
+            return pc;
+        }
+    }
+}
+
+/******************************************************************************/
+
+const std::vector<amqp::internal::plan::Instruction> &
+amqp::internal::plan::
+DecodePlan::code() const {
+    return m_code;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::plan::
+DecodePlan::string (uint32_t idx_) const {
+    return m_strings[idx_];
+}
+
+/******************************************************************************/
+
+std::ostream &
+amqp::internal::plan::
+operator << (std::ostream & stream_, const DecodePlan & plan_) {
+    size_t pc { 0 };
+
+    for (const auto & i : plan_.code()) {
+        stream_ << pc++ << ": " << opName (i.m_op);
+
+        switch (i.m_op) {
+            case Op::CALL :
+            case Op::LOOP :
+                stream_ << " -> " << i.m_target;
+                break;
+            case Op::BEGIN_LIST :
+            case Op::BEGIN_MAP :
+                stream_ << " " << plan_.string (i.m_arg) << " -> " << i.m_target;
+                break;
+            case Op::BEGIN_COMPOSITE :
+                stream_ << " " << plan_.string (i.m_arg)
+                        << " " << plan_.string (i.m_target);
+                break;
+            case Op::FIELD :
+                stream_ << " " << plan_.string (i.m_arg);
+                break;
+            case Op::SKIP :
+                stream_ << " " << i.m_arg;
+                if (i.m_target) {
+                    stream_ << " objects";
+                }
+                break;
+            case Op::END_COMPOSITE :
+                if (i.m_target) {
+                    stream_ << " objects";
+                }
+                break;
+            case Op::OBJECT :
+                if (!i.m_arg) {
+                    stream_ << " uncounted";
+                }
+                break;
+            default :
+                break;
+        }
+
+        stream_ << std::endl;
+    }
+
+    return stream_;
+}
+
+/******************************************************************************/
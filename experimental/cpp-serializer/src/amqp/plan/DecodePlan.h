@@ -0,0 +1,114 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iosfwd>
+
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace amqp::codec {
+    class Decoder;
+}
+
+/******************************************************************************/
+
+/**
+ * A reader graph lowered into a flat array of instructions.
+ *
+ * Walking the graph costs a virtual call and a chase to another heap
+ * object for every value in the blob. A plan does the same work as a
+ * single loop over a contiguous array. Each composite and list type is
+ * compiled once into a routine that's called wherever that type appears,
+ * which keeps plans small.
+ *
+ * A plan compiled with a Projection only reads the fields asked for, the
+ * others are stepped over whole using their encoded sizes, and any after
+ * the last one wanted aren't looked at at all.
+ *
+ * Every reader compiles to a single instruction, a read or a call, so an
+ * OBJECT instruction finding a reference runs just the one after it
+ * against the object referred to.
+ */
+namespace amqp::internal::plan {
+
+    enum class Op : uint8_t {
+        CALL,             // push the return address, jump to m_target
+        RET,              // pop the return address, or stop if there isn't one
+        BEGIN_COMPOSITE,  // enter a composite, m_arg is its type, m_target its descriptor
+        END_COMPOSITE,    // m_target set if we left objects unread
+        FIELD,            // m_arg is the field name
+        BEGIN_LIST,       // enter a list, m_arg is its type, jump to m_target if empty
+        LOOP,             // jump back to m_target until the list or map is done
+        END_LIST,
+        BEGIN_MAP,        // enter a map, m_arg is its type, jump to m_target if empty
+        END_MAP,
+        INT,
+        LONG,
+        BOOL,
+        DOUBLE,
+        STRING,
+        ENUM,
+        SKIP,             // step over m_arg values without looking inside them, m_target
+                          // set if they might contain objects
+        OBJECT            // the next instruction reads an object, which may be a reference
+                          // to an earlier one, m_arg set if it's added to the object table
+    };
+
+    const char * opName (Op);
+
+    struct Instruction {
+        Op       m_op;
+        uint32_t m_arg;
+        uint32_t m_target;
+    };
+
+    class DecodePlan {
+        private :
+            friend class Compiler;
+
+            std::vector<Instruction> m_code;
+
+            /**
+             * Type and field names referenced by the instructions
+             */
+            std::vector<std::string> m_strings;
+
+            struct Stacks {
+                std::vector<size_t> m_returns;
+                std::vector<size_t> m_remaining;
+            };
+
+            size_t execute (
+                size_t,
+                bool,
+                codec::Decoder *,
+                amqp::reader::IVisitor &,
+                Stacks &) const;
+
+        public :
+            DecodePlan() = default;
+
+            DecodePlan (DecodePlan &&) = default;
+            DecodePlan & operator = (DecodePlan &&) = default;
+
+            /**
+             * With the decoder positioned on a value of the type the plan
+             * was compiled for read it, and move past it, passing what's
+             * read to the visitor
+             */
+            void run (codec::Decoder *, amqp::reader::IVisitor &) const;
+
+            const std::vector<Instruction> & code() const;
+            const std::string & string (uint32_t) const;
+    };
+
+    std::ostream & operator << (std::ostream &, const DecodePlan &);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,124 @@
+#include "Projection.h"
+
+#include <stdexcept>
+
+/******************************************************************************
+ *
+ * class Projection
+ *
+ ******************************************************************************/
+
+amqp::internal::plan::
+Projection::Projection()
+    : m_everything (true)
+{
+}
+
+/******************************************************************************/
+
+amqp::internal::plan::
+Projection::Projection (const std::vector<std::string> & paths_)
+    : m_everything (paths_.empty())
+{
+    for (const auto & path : paths_) {
+        add (path, 0);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Add what's left of [path_] from [from_] beneath us
+ */
+void
+amqp::internal::plan::
+Projection::add (const std::string & path_, size_t from_) {
+    if (m_everything) {
+        return;
+    }
+
+    if (from_ > path_.size()) {
+        m_everything = true;
+        m_fields.clear();
+        return;
+    }
+
+    auto dot = path_.find ('.', from_);
+    auto end = (dot == std::string::npos) ? path_.size() : dot;
+
+    if (end == from_) {
+        throw std::runtime_error ("Bad field path \"" + path_ + "\"");
+    }
+
+    auto name = path_.substr (from_, end - from_);
+
+    auto it = m_fields.find (name);
+    if (it == m_fields.end()) {
+        it = m_fields.emplace (name, Projection()).first;
+        it->second.m_path = path_.substr (0, end);
+        it->second.m_everything = false;
+    }
+
+    it->second.add (path_, end + 1);
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::plan::
+Projection::everything() const {
+    return m_everything;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::plan::
+Projection::path() const {
+    return m_path;
+}
+
+/******************************************************************************/
+
+const amqp::internal::plan::Projection *
+amqp::internal::plan::
+Projection::field (const std::string & name_) const {
+    if (m_everything) {
+        return this;
+    }
+
+    auto it = m_fields.find (name_);
+
+    return (it == m_fields.end()) ? nullptr : &it->second;
+}
+
+/******************************************************************************/
+
+const std::map<std::string, amqp::internal::plan::Projection> &
+amqp::internal::plan::
+Projection::fields() const {
+    return m_fields;
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::plan::
+Projection::str() const {
+    if (m_everything) {
+        return m_path;
+    }
+
+    std::string str;
+
+    for (const auto & field : m_fields) {
+        if (!str.empty()) {
+            str += ",";
+        }
+        str += field.second.str();
+    }
+
+    return str;
+}
+
+/******************************************************************************/
@@ -0,0 +1,62 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <vector>
+
+/******************************************************************************/
+
+/**
+ * The fields we want out of a blob, as a tree of the dotted paths to
+ * them, so "state.owner.name" and "state.amount" share a "state".
+ *
+ * A node a path ends at wants everything below it, as does a projection
+ * built from no paths at all. Lists are looked through, a path carries
+ * on into the elements of any list it passes.
+ */
+namespace amqp::internal::plan {
+
+    class Projection {
+        private :
+            std::string m_path;
+            bool        m_everything;
+
+            std::map<std::string, Projection> m_fields;
+
+            void add (const std::string &, size_t);
+
+        public :
+            /**
+             * Wants everything
+             */
+            Projection();
+
+            explicit Projection (const std::vector<std::string> & paths_);
+
+            bool everything() const;
+
+            /**
+             * The dotted path to this node from the top level type
+             */
+            const std::string & path() const;
+
+            /**
+             * What we want from field [name_], null if we don't want
+             * it at all
+             */
+            const Projection * field (const std::string & name_) const;
+
+            const std::map<std::string, Projection> & fields() const;
+
+            /**
+             * The paths the projection was built from, tidied up and
+             * sorted, so equal projections give equal strings
+             */
+            std::string str() const;
+    };
+
+}
+
+/******************************************************************************/
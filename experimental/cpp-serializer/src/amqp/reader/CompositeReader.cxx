@@ -4,12 +4,14 @@
 #include <iostream>
 #include <assert.h>
 
-#include <proton/codec.h>
 #include <sstream>
 #include "debug.h"
 #include "Reader.h"
+#include "PropertyReader.h"
 #include "amqp/reader/IReader.h"
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/plan/Compiler.h"
+#include "amqp/stats/Stats.h"
 
 /******************************************************************************/
 
@@ -27,16 +29,24 @@ CompositeReader::m_name { // NOLINT
 amqp::internal::reader::
 CompositeReader::CompositeReader (
         std::string type_,
-        sVec<std::weak_ptr<Reader>> & readers_
-) : m_readers (readers_)
+        std::string descriptor_,
+        sVec<std::string> fields_,
+        sVec<const Reader *> readers_
+) : m_readers (std::move (readers_))
   , m_type (std::move (type_))
+  , m_descriptor (std::move (descriptor_))
+  , m_fields (std::move (fields_))
 {
     DBG ("MAKE CompositeReader: " << m_type << ": " << m_readers.size() << std::endl); // NOLINT
+    assert (m_fields.size() == m_readers.size());
+
+    m_objects.reserve (m_readers.size());
+
     for (auto const reader : m_readers) {
-        assert (reader.lock());
-        if (auto r = reader.lock()) {
-            DBG ("  prop: " << r->name() << " " << r->type() << std::endl); // NOLINT
-        }
+        assert (reader);
+        DBG ("  prop: " << reader->name() << " " << reader->type() << std::endl); // NOLINT
+
+        m_objects.push_back (dynamic_cast<const PropertyReader *> (reader) == nullptr);
     }
 }
 
@@ -58,9 +68,53 @@ CompositeReader::type() const  {
 
 /******************************************************************************/
 
+bool
+amqp::internal::reader::
+CompositeReader::referenceable() const {
+    return true;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+CompositeReader::descriptor() const  {
+    return m_descriptor;
+}
+
+/******************************************************************************/
+
+const std::vector<std::string> &
+amqp::internal::reader::
+CompositeReader::fields() const  {
+    return m_fields;
+}
+
+/******************************************************************************/
+
+/**
+ * With the decoder on the descriptor of an instance make sure it's the
+ * type we were built to read. This is just a comparison against the
+ * symbol in the blob, no copying or looking anything up
+ */
+void
+amqp::internal::reader::
+CompositeReader::checkDescriptor (codec::Decoder * data_) const {
+    auto descriptor = codec::get_symbol<std::string_view> (data_);
+
+    if (descriptor != m_descriptor) {
+        std::stringstream ss;
+        ss << "Expected an instance of " << m_type << " (" << m_descriptor
+           << ") but found " << descriptor;
+        throw std::runtime_error (ss.str());
+    }
+}
+
+/******************************************************************************/
+
 std::any
 amqp::internal::reader::
-CompositeReader::read (pn_data_t * data_) const {
+CompositeReader::read (codec::Decoder * data_) const {
     return std::any(1);
 }
 
@@ -68,9 +122,9 @@ CompositeReader::read (pn_data_t * data_) const {
 
 std::string
 amqp::internal::reader::
-CompositeReader::readString (pn_data_t * data_) const {
-    pn_data_next (data_);
-    proton::auto_enter ae (data_);
+CompositeReader::readString (codec::Decoder * data_) const {
+    data_->next();
+    codec::auto_enter ae (data_);
 
     return "Composite";
 }
@@ -81,35 +135,34 @@ CompositeReader::readString (pn_data_t * data_) const {
 sVec<uPtr<amqp::reader::IValue>>
 amqp::internal::reader::
 CompositeReader::_dump (
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_
 ) const {
     DBG ("Read Composite: " << m_name << " : " << type() << std::endl); // NOLINT
-    proton::is_described (data_);
-    proton::auto_enter ae (data_);
-
-    const auto & it = schema_.fromDescriptor (proton::get_symbol<std::string>(data_));
-    auto & fields = dynamic_cast<schema::Composite &>(*(it->second.get())).fields();
+    codec::is_described (data_);
+    codec::auto_enter ae (data_);
 
-    assert (fields.size() == m_readers.size());
+    checkDescriptor (data_);
 
-    pn_data_next (data_);
+    data_->next();
 
     sVec<uPtr<amqp::reader::IValue>> read;
-    read.reserve (fields.size());
+    read.reserve (m_fields.size());
 
-    proton::is_list (data_);
+    codec::is_list (data_);
     {
-        proton::auto_enter ae (data_);
+        codec::auto_enter ae (data_);
 
         for (int i (0) ; i < m_readers.size() ; ++i) {
-            if (auto l =  m_readers[i].lock()) {
-                DBG (fields[i]->name() << " " << (l ? "true" : "false") << std::endl); // NOLINT
+            if (auto l = m_readers[i]) {
+                DBG (m_fields[i] << " " << (l ? "true" : "false") << std::endl); // NOLINT
 
-                read.emplace_back(l->dump(fields[i]->name(), data_, schema_));
+                read.emplace_back (m_objects[i]
+                    ? dumpObject (m_fields[i], *l, data_, schema_)
+                    : l->dump (m_fields[i], data_, schema_));
             } else {
                 std::stringstream s;
-                s << "null field reader: " << fields[i]->name();
+                s << "null field reader: " << m_fields[i];
                 throw std::runtime_error(s.str());
             }
         }
@@ -124,9 +177,13 @@ uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 CompositeReader::dump (
     const std::string & name_,
-    pn_data_t * data_,
+    codec::Decoder * data_,
     const SchemaType & schema_) const
 {
+    AMQP_ALLOC_READER (stats::Composite);
+
+    codec::auto_next an (data_);
+
     return std::make_unique<TypedPair<sVec<uPtr<amqp::reader::IValue>>>> (
         name_,
         _dump(data_, schema_));
@@ -140,12 +197,99 @@ CompositeReader::dump (
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 CompositeReader::dump (
-    pn_data_t * data_,
+    codec::Decoder * data_,
     const SchemaType & schema_) const
 {
+    AMQP_ALLOC_READER (stats::Composite);
+
+    codec::auto_next an (data_);
+
     return std::make_unique<TypedSingle<sVec<uPtr<amqp::reader::IValue>>>> (
         _dump (data_, schema_));
 }
 
 /******************************************************************************/
 
+void
+amqp::internal::reader::
+CompositeReader::visit (
+    codec::Decoder * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    AMQP_ALLOC_READER (stats::Composite);
+
+    codec::auto_next an (data_);
+    codec::is_described (data_);
+    codec::auto_enter ae (data_);
+
+    checkDescriptor (data_);
+
+    data_->next();
+
+    codec::is_list (data_);
+
+    visitor_.beginComposite (m_type);
+    {
+        codec::auto_enter ae (data_);
+
+        for (size_t i (0) ; i < m_readers.size() ; ++i) {
+            if (auto l = m_readers[i]) {
+                visitor_.field (m_fields[i]);
+
+                if (m_objects[i]) {
+                    visitObject (*l, data_, schema_, visitor_);
+                } else {
+                    l->visit (data_, schema_, visitor_);
+                }
+            } else {
+                std::stringstream s;
+                s << "null field reader: " << m_fields[i];
+                throw std::runtime_error(s.str());
+            }
+        }
+    }
+    visitor_.endComposite();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CompositeReader::compile (
+    plan::Compiler & compiler_,
+    const SchemaType & schema_) const
+{
+    compiler_.call (*this, [this, &schema_](plan::Compiler & c) {
+        c.emit (
+            plan::Op::BEGIN_COMPOSITE,
+            c.intern (m_type),
+            c.intern (m_descriptor));
+
+        const auto & projection = c.project (m_type, m_fields);
+
+        for (size_t i (0) ; i < m_readers.size() ; ++i) {
+            auto wanted = projection.field (m_fields[i]);
+
+            if (!wanted) {
+                c.skip (m_objects[i]);
+            } else if (auto l = m_readers[i]) {
+                c.emit (plan::Op::FIELD, c.intern (m_fields[i]));
+
+                if (m_objects[i]) {
+                    c.object (*l);
+                }
+
+                c.within (*wanted, [&]() { l->compile (c, schema_); });
+            } else {
+                std::stringstream s;
+                s << "null field reader: " << m_fields[i];
+                throw std::runtime_error(s.str());
+            }
+        }
+
+        c.emit (plan::Op::END_COMPOSITE);
+    });
+}
+
+/******************************************************************************/
@@ -15,38 +15,71 @@ namespace amqp::internal::reader {
 
     class CompositeReader : public Reader {
         private :
-            std::vector<std::weak_ptr<Reader>> m_readers;
+            // owned by the factory that built us
+            std::vector<const Reader *> m_readers;
 
             static const std::string m_name;
 
             std::string m_type;
 
+            /**
+             * Everything we need from the schema to read an instance is
+             * captured when we're built so reading one only has to check
+             * it's been handed what it expects
+             */
+            std::string m_descriptor;
+            std::vector<std::string> m_fields;
+
+            /**
+             * Which fields are read as objects rather than primitive
+             * properties, see visitObject
+             */
+            std::vector<bool> m_objects;
+
+            void checkDescriptor (codec::Decoder *) const;
+
         public :
             CompositeReader (
                 std::string,
-                std::vector<std::weak_ptr<Reader>> &);
+                std::string,
+                std::vector<std::string>,
+                std::vector<const Reader *>);
 
             ~CompositeReader() override = default;
 
-            std::any read (pn_data_t *) const override;
+            std::any read (codec::Decoder *) const override;
 
-            std::string readString (pn_data_t *) const override;
+            std::string readString (codec::Decoder *) const override;
 
             std::unique_ptr<amqp::reader::IValue> dump(
                 const std::string &,
-                pn_data_t *,
+                codec::Decoder *,
                 const SchemaType &) const override;
 
             std::unique_ptr<amqp::reader::IValue> dump(
-                pn_data_t *,
+                codec::Decoder *,
+                const SchemaType &) const override;
+
+            void visit (
+                codec::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            void compile (
+                plan::Compiler &,
                 const SchemaType &) const override;
 
             const std::string & name() const override;
             const std::string & type() const override;
 
+            bool referenceable() const override;
+
+            const std::string & descriptor() const;
+            const std::vector<std::string> & fields() const;
+
         private :
             std::vector<std::unique_ptr<amqp::reader::IValue>> _dump (
-                pn_data_t *,
+                codec::Decoder *,
                 const SchemaType &) const;
     };
 
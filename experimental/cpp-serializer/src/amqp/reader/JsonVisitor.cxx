@@ -0,0 +1,375 @@
+#include "JsonVisitor.h"
+
+#include <cmath>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    inline bool
+    needsEscape (unsigned char c_) {
+        return c_ < 0x20 || c_ == '"' || c_ == '\\';
+    }
+
+    /**
+     * Offset of the first character in the range that has to be escaped,
+     * or the length of the range if there isn't one. Almost every string
+     * we see needs no escaping at all so this is the hot path, with SSE2
+     * we can check sixteen bytes at a time
+     */
+    size_t
+    firstEscape (const char * data_, size_t len_) {
+        size_t i { 0 };
+
+#if defined(__SSE2__)
+        const __m128i quote     = _mm_set1_epi8 ('"');
+        const __m128i backslash = _mm_set1_epi8 ('\\');
+        const __m128i control   = _mm_set1_epi8 (0x1f);
+
+        for ( ; i + 16 <= len_ ; i += 16) {
+            __m128i chunk = _mm_loadu_si128 (
+                    reinterpret_cast<const __m128i *> (data_ + i));
+
+            // unsigned c <= 0x1f iff max (c, 0x1f) == 0x1f
+            __m128i hits = _mm_or_si128 (
+                    _mm_or_si128 (
+                            _mm_cmpeq_epi8 (chunk, quote),
+                            _mm_cmpeq_epi8 (chunk, backslash)),
+                    _mm_cmpeq_epi8 (_mm_max_epu8 (chunk, control), control));
+
+            int mask = _mm_movemask_epi8 (hits);
+
+            if (mask) {
+                return i + __builtin_ctz (mask);
+            }
+        }
+#endif
+
+        for ( ; i < len_ ; ++i) {
+            if (needsEscape (static_cast<unsigned char> (data_[i]))) {
+                return i;
+            }
+        }
+
+        return len_;
+    }
+
+    const char HEX[] = "0123456789abcdef";
+
+}
+
+/******************************************************************************
+ *
+ * class JsonVisitor
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+JsonVisitor::JsonVisitor (std::ostream & out_, size_t size_)
+    : m_out (out_)
+    , m_buffer (std::max (size_, size_t { 64 }))
+    , m_used (0)
+    , m_named (false)
+{
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::
+JsonVisitor::~JsonVisitor() {
+    flush();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::flush() {
+    if (m_used) {
+        m_out.write (m_buffer.data(), m_used);
+        m_used = 0;
+    }
+    m_out.flush();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::put (char c_) {
+    if (m_used == m_buffer.size()) {
+        m_out.write (m_buffer.data(), m_used);
+        m_used = 0;
+    }
+
+    m_buffer[m_used++] = c_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::put (const char * data_, size_t len_) {
+    if (m_used + len_ > m_buffer.size()) {
+        m_out.write (m_buffer.data(), m_used);
+        m_used = 0;
+
+        // anything that wouldn't fit in an empty buffer goes straight out
+        if (len_ > m_buffer.size()) {
+            m_out.write (data_, len_);
+            return;
+        }
+    }
+
+    memcpy (m_buffer.data() + m_used, data_, len_);
+    m_used += len_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::quoted (std::string_view value_) {
+    put ('"');
+
+    const char * data = value_.data();
+    size_t len = value_.size();
+
+    while (len) {
+        auto clean = firstEscape (data, len);
+        put (data, clean);
+
+        if (clean == len) {
+            break;
+        }
+
+        auto c = static_cast<unsigned char> (data[clean]);
+        switch (c) {
+            case '"'  : put ("\\\"", 2); break;
+            case '\\' : put ("\\\\", 2); break;
+            case '\b' : put ("\\b", 2); break;
+            case '\f' : put ("\\f", 2); break;
+            case '\n' : put ("\\n", 2); break;
+            case '\r' : put ("\\r", 2); break;
+            case '\t' : put ("\\t", 2); break;
+            default : {
+                char esc[] = { '\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xf] };
+                put (esc, sizeof (esc));
+            }
+        }
+
+        data += clean + 1;
+        len  -= clean + 1;
+    }
+
+    put ('"');
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::separate() {
+    if (m_named) {
+        m_named = false;
+    } else if (!m_first.empty()) {
+        if (!m_first.back()) {
+            put (',');
+        }
+        m_first.back() = false;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Is the next value the key of a map entry
+ */
+bool
+amqp::internal::reader::
+JsonVisitor::key() const {
+    return !m_named && !m_maps.empty() && m_maps.back();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::open (char bracket_, bool map_) {
+    if (key()) {
+        throw std::runtime_error ("JSON map keys must be simple values");
+    }
+
+    separate();
+    put (bracket_);
+    m_first.push_back (true);
+    m_maps.push_back (map_);
+}
+
+/******************************************************************************/
+
+/**
+ * Write a value that doesn't need quoting unless it's a map key
+ */
+void
+amqp::internal::reader::
+JsonVisitor::scalar (const char * data_, size_t len_) {
+    if (key()) {
+        separate();
+        put ('"');
+        put (data_, len_);
+        put ("\":", 2);
+        m_named = true;
+    } else {
+        separate();
+        put (data_, len_);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::beginComposite (const std::string &) {
+    open ('{', false);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::endComposite() {
+    m_first.pop_back();
+    m_maps.pop_back();
+    put ('}');
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::beginList (const std::string &, size_t) {
+    open ('[', false);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::endList() {
+    m_first.pop_back();
+    m_maps.pop_back();
+    put (']');
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::beginMap (const std::string &, size_t) {
+    open ('{', true);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::endMap() {
+    m_first.pop_back();
+    m_maps.pop_back();
+    put ('}');
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::field (const std::string & name_) {
+    separate();
+    quoted (name_);
+    put (':');
+    m_named = true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onInt (int32_t value_) {
+    char buf[16];
+    auto res = std::to_chars (buf, buf + sizeof (buf), value_);
+    scalar (buf, res.ptr - buf);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onLong (int64_t value_) {
+    char buf[24];
+    auto res = std::to_chars (buf, buf + sizeof (buf), value_);
+    scalar (buf, res.ptr - buf);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onDouble (double value_) {
+    if (!std::isfinite (value_)) {
+        scalar ("null", 4);
+        return;
+    }
+
+    // shortest representation that round trips
+    char buf[32];
+    auto res = std::to_chars (buf, buf + sizeof (buf), value_);
+    scalar (buf, res.ptr - buf);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onBool (bool value_) {
+    if (value_) {
+        scalar ("true", 4);
+    } else {
+        scalar ("false", 5);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onString (std::string_view value_) {
+    bool named = key();
+
+    separate();
+    quoted (value_);
+
+    if (named) {
+        put (':');
+        m_named = true;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onEnum (std::string_view value_) {
+    onString (value_);
+}
+
+/******************************************************************************/
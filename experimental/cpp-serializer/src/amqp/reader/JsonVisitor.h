@@ -0,0 +1,90 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+#include <iosfwd>
+
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Writes visited values out as compact, valid JSON. Keys and strings
+     * are quoted and escaped, enums are written as strings and non finite
+     * doubles, which JSON can't represent, as null. Maps become objects
+     * with their keys written as strings, which means only maps keyed by
+     * simple values can be written.
+     *
+     * Output is accumulated in a fixed size buffer that's handed to the
+     * stream in large blocks, call flush (or let the visitor go out of
+     * scope) once done.
+     */
+    class JsonVisitor : public amqp::reader::IVisitor {
+        private :
+            std::ostream & m_out;
+
+            std::vector<char> m_buffer;
+            size_t            m_used;
+
+            /**
+             * One entry per open object or array, true until we've
+             * written its first element so we know when to add a comma
+             */
+            std::vector<bool> m_first;
+
+            /**
+             * Alongside m_first, true for maps
+             */
+            std::vector<bool> m_maps;
+
+            /**
+             * Set after writing a key, the value that follows it shouldn't
+             * be separated from it
+             */
+            bool m_named;
+
+            void put (char);
+            void put (const char *, size_t);
+            void quoted (std::string_view);
+            void separate();
+
+            bool key() const;
+            void open (char, bool);
+            void scalar (const char *, size_t);
+
+        public :
+            static constexpr size_t DEFAULT_BUFFER = 64 * 1024;
+
+            explicit JsonVisitor (std::ostream &, size_t = DEFAULT_BUFFER);
+            ~JsonVisitor() override;
+
+            JsonVisitor (const JsonVisitor &) = delete;
+            JsonVisitor & operator = (const JsonVisitor &) = delete;
+
+            void flush();
+
+            void beginComposite (const std::string &) override;
+            void endComposite() override;
+
+            void beginList (const std::string &, size_t) override;
+            void endList() override;
+
+            void beginMap (const std::string &, size_t) override;
+            void endMap() override;
+
+            void field (const std::string &) override;
+
+            void onInt (int32_t) override;
+            void onLong (int64_t) override;
+            void onDouble (double) override;
+            void onBool (bool) override;
+            void onString (std::string_view) override;
+            void onEnum (std::string_view) override;
+    };
+
+}
+
+/******************************************************************************/
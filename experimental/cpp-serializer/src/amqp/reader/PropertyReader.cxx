@@ -11,9 +11,8 @@
 #include <iostream>
 #include <functional>
 
-#include <proton/codec.h>
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
 
 /******************************************************************************/
 
@@ -23,31 +22,31 @@ namespace {
 
     std::map<
             std::string,
-            std::shared_ptr<amqp::internal::reader::PropertyReader>(*)()
+            uPtr<amqp::internal::reader::PropertyReader>(*)()
     > propertyMap = { // NOLINT
         {
-            "int", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<IntPropertyReader> ();
+            "int", []() -> uPtr<PropertyReader> {
+                return std::make_unique<IntPropertyReader> ();
             }
         },
         {
-            "string", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<StringPropertyReader> ();
+            "string", []() -> uPtr<PropertyReader> {
+                return std::make_unique<StringPropertyReader> ();
             }
         },
         {
-            "boolean", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<BoolPropertyReader> ();
+            "boolean", []() -> uPtr<PropertyReader> {
+                return std::make_unique<BoolPropertyReader> ();
             }
         },
         {
-            "long", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<LongPropertyReader> ();
+            "long", []() -> uPtr<PropertyReader> {
+                return std::make_unique<LongPropertyReader> ();
             }
         },
         {
-            "double", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<DoublePropertyReader> ();
+            "double", []() -> uPtr<PropertyReader> {
+                return std::make_unique<DoublePropertyReader> ();
             }
         }
     };
@@ -59,7 +58,7 @@ namespace {
 /**
  * Static factory method
  */
-std::shared_ptr<amqp::internal::reader::PropertyReader>
+uPtr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
 PropertyReader::make (const FieldPtr & field_) {
     return propertyMap[field_->type()]();
@@ -67,7 +66,7 @@ PropertyReader::make (const FieldPtr & field_) {
 
 /******************************************************************************/
 
-std::shared_ptr<amqp::internal::reader::PropertyReader>
+uPtr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
 PropertyReader::make (const std::string & type_) {
     return propertyMap[type_]();
@@ -76,3 +75,11 @@ PropertyReader::make (const std::string & type_) {
 /******************************************************************************/
 
 
+
+bool
+amqp::internal::reader::
+PropertyReader::referenceable() const {
+    return false;
+}
+
+/******************************************************************************/
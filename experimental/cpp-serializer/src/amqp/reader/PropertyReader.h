@@ -18,29 +18,43 @@ namespace amqp::internal::reader {
             /**
              * Static Factory method for creating appropriate derived types
              */
-            static std::shared_ptr<PropertyReader> make (const FieldPtr &);
-            static std::shared_ptr<PropertyReader> make (const std::string &);
+            static uPtr<PropertyReader> make (const FieldPtr &);
+            static uPtr<PropertyReader> make (const std::string &);
 
             PropertyReader() = default;
             ~PropertyReader() override = default;
 
-            std::string readString(pn_data_t *) const override = 0;
+            std::string readString(codec::Decoder *) const override = 0;
 
-            std::any read (pn_data_t *) const override = 0;
+            std::any read (codec::Decoder *) const override = 0;
 
             std::unique_ptr<amqp::reader::IValue> dump(
                 const std::string &,
-                pn_data_t *,
+                codec::Decoder *,
                 const SchemaType &
             ) const override = 0;
 
             std::unique_ptr<amqp::reader::IValue> dump(
-                pn_data_t *,
+                codec::Decoder *,
                 const SchemaType &
             ) const override = 0;
 
+            void visit (
+                codec::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override = 0;
+
+            void compile (
+                plan::Compiler &,
+                const SchemaType &) const override = 0;
+
             const std::string & name() const override = 0;
             const std::string & type() const override = 0;
+
+            /**
+             * Boxed primitives aren't counted, strings are
+             */
+            bool referenceable() const override;
     };
 
 }
@@ -3,6 +3,9 @@
 #include <memory>
 #include <sstream>
 
+#include "amqp/codec/Decoder.h"
+#include "amqp/descriptors/AMQPDescriptorRegistory.h"
+
 /******************************************************************************/
 
 namespace {
@@ -65,6 +68,22 @@ namespace {
         return rtn.str();
     }
 
+    /**
+     * Map entries are written as key : value
+     */
+    void
+    dumpEntries (
+        std::stringstream & stream_,
+        const amqp::internal::reader::MapEntries & entries_
+    ) {
+        for (auto it (entries_.begin()) ; it != entries_.end() ; ++it) {
+            if (it != entries_.begin()) {
+                stream_ << ", ";
+            }
+            stream_ << it->first->dump() << " : " << it->second->dump();
+        }
+    }
+
     template<class Auto, class T>
     std::string
     dumpSingle (const T & begin_, const T & end_) {
@@ -117,6 +136,19 @@ TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump() const {
     return ::dumpPair<AutoList> (m_property, m_value.begin(), m_value.end());
 }
 
+template<>
+std::string
+amqp::internal::reader::
+TypedPair<amqp::internal::reader::MapEntries>::dump() const {
+    std::stringstream rtn;
+    {
+        AutoMap am (m_property, rtn);
+        dumpEntries (rtn, m_value);
+    }
+
+    return rtn.str();
+}
+
 /******************************************************************************
  *
  *
@@ -151,4 +183,134 @@ TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dump() const {
     return ::dumpSingle<AutoMap> (m_value.begin(), m_value.end());
 }
 
+template<>
+std::string
+amqp::internal::reader::
+TypedSingle<amqp::internal::reader::MapEntries>::dump() const {
+    std::stringstream rtn;
+    {
+        AutoMap am (rtn);
+        dumpEntries (rtn, m_value);
+    }
+
+    return rtn.str();
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * Referenced objects
+ *
+ ******************************************************************************/
+
+namespace {
+
+    template<typename Read>
+    void
+    readObject (
+        const amqp::internal::reader::Reader & reader_,
+        amqp::codec::Decoder * data_,
+        Read read_
+    ) {
+        auto referenced = amqp::internal::reader::referenced (data_);
+
+        if (!referenced.empty()) {
+            amqp::codec::Decoder replay (referenced, *data_);
+            amqp::codec::auto_next an (data_);
+
+            read_ (&replay);
+            return;
+        }
+
+        auto encoded = data_->raw();
+
+        read_ (data_);
+
+        if (reader_.referenceable()) {
+            data_->remember (encoded);
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+visitObject (
+    const Reader & reader_,
+    codec::Decoder * data_,
+    const Reader::SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) {
+    readObject (reader_, data_, [&](codec::Decoder * d_) {
+        reader_.visit (d_, schema_, visitor_);
+    });
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+dumpObject (
+    const Reader & reader_,
+    codec::Decoder * data_,
+    const Reader::SchemaType & schema_
+) {
+    uPtr<amqp::reader::IValue> rtn;
+
+    readObject (reader_, data_, [&](codec::Decoder * d_) {
+        rtn = reader_.dump (d_, schema_);
+    });
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+dumpObject (
+    const std::string & name_,
+    const Reader & reader_,
+    codec::Decoder * data_,
+    const Reader::SchemaType & schema_
+) {
+    uPtr<amqp::reader::IValue> rtn;
+
+    readObject (reader_, data_, [&](codec::Decoder * d_) {
+        rtn = reader_.dump (name_, d_, schema_);
+    });
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * A reference is described by the Corda REFERENCED_OBJECT descriptor
+ * with the object's index as an unsigned int
+ */
+std::string_view
+amqp::internal::reader::
+referenced (codec::Decoder * data_) {
+    if (data_->type() != codec::AMQP_DESCRIBED) {
+        return { };
+    }
+
+    codec::auto_enter ae (data_);
+
+    if (data_->type() != codec::AMQP_ULONG
+        || data_->getULong() != (static_cast<uint32_t> (REFERENCED_OBJECT)
+                                    | DESCRIPTOR_TOP_32BITS))
+    {
+        return { };
+    }
+
+    data_->next();
+
+    return data_->recall (data_->getUInt());
+}
+
 /******************************************************************************/
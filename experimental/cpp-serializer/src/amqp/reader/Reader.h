@@ -106,6 +106,18 @@ namespace amqp::internal::reader {
 
 }
 
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A dumped map, its entries in the order they were read held in a
+     * single array
+     */
+    using MapEntries = sVec<std::pair<uPtr<amqp::reader::IValue>, uPtr<amqp::reader::IValue>>>;
+
+}
+
 /******************************************************************************
  *
  * amqp::internal::reader::TypedSingle
@@ -146,6 +158,11 @@ std::string
 amqp::internal::reader::
 TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump() const;
 
+template<>
+std::string
+amqp::internal::reader::
+TypedSingle<amqp::internal::reader::MapEntries>::dump() const;
+
 /******************************************************************************
  *
  * amqp::internal::reader::TypedPair
@@ -187,6 +204,11 @@ std::string
 amqp::internal::reader::
 TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump() const;
 
+template<>
+std::string
+amqp::internal::reader::
+TypedPair<amqp::internal::reader::MapEntries>::dump() const;
+
 /******************************************************************************
  *
  *
@@ -194,6 +216,12 @@ TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump() const;
  *
  ******************************************************************************/
 
+namespace amqp::internal::plan {
+    class Compiler;
+}
+
+/******************************************************************************/
+
 namespace amqp::internal::reader  {
 
     using IReader = amqp::reader::IReader<schema::SchemaMap::const_iterator>;
@@ -205,20 +233,81 @@ namespace amqp::internal::reader  {
             const std::string & name() const override = 0;
             const std::string & type() const override = 0;
 
-            std::any read (struct pn_data_t *) const override = 0;
-            std::string readString (struct pn_data_t *) const override = 0;
+            std::any read (codec::Decoder *) const override = 0;
+            std::string readString (codec::Decoder *) const override = 0;
 
             uPtr<amqp::reader::IValue> dump(
                 const std::string &,
-                pn_data_t *,
+                codec::Decoder *,
                 const SchemaType &) const override = 0;
 
             uPtr<amqp::reader::IValue> dump(
-                pn_data_t *,
+                codec::Decoder *,
                 const SchemaType &) const override = 0;
+
+            void visit (
+                codec::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override = 0;
+
+            /**
+             * Emit the instructions that read one of our values into a
+             * flat decode plan, see plan::Compiler
+             */
+            virtual void compile (
+                plan::Compiler &,
+                const SchemaType &) const = 0;
+
+            /**
+             * Whether the JVM serialiser counts our values as objects
+             * it can refer back to, everything but the boxed primitives
+             */
+            virtual bool referenceable() const = 0;
     };
 
 }
 
+/******************************************************************************
+ *
+ * Referenced objects
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Where the JVM serialiser reads an object, rather than a primitive
+     * property, it may instead find a reference to one it's already read.
+     * That's list elements, map keys and values and composite fields of
+     * a type that isn't primitive. These read the value at such a position
+     * with [reader_], replaying the object a reference points at, and add
+     * what they read to the blob's object table if it could be referred
+     * back to later. See codec::Decoder::remember
+     */
+    void visitObject (
+            const Reader & reader_,
+            codec::Decoder *,
+            const Reader::SchemaType &,
+            amqp::reader::IVisitor &);
+
+    uPtr<amqp::reader::IValue> dumpObject (
+            const Reader & reader_,
+            codec::Decoder *,
+            const Reader::SchemaType &);
+
+    uPtr<amqp::reader::IValue> dumpObject (
+            const std::string &,
+            const Reader & reader_,
+            codec::Decoder *,
+            const Reader::SchemaType &);
+
+    /**
+     * If the decoder is on a reference to an object the encoding of that
+     * object, otherwise an empty view. Either way we don't move
+     */
+    std::string_view referenced (codec::Decoder *);
+
+}
+
 /******************************************************************************/
 
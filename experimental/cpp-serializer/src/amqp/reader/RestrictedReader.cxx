@@ -2,7 +2,7 @@
 
 #include <iostream>
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
 
 #include "amqp/reader/IReader.h"
 #include "amqp/reader/Reader.h"
@@ -26,7 +26,7 @@ RestrictedReader::m_name { // NOLINT
 
 std::any
 amqp::internal::reader::
-RestrictedReader::read (pn_data_t *) const {
+RestrictedReader::read (codec::Decoder *) const {
     return std::any(1);
 }
 
@@ -34,7 +34,7 @@ RestrictedReader::read (pn_data_t *) const {
 
 std::string
 amqp::internal::reader::
-RestrictedReader::readString (pn_data_t * data_) const {
+RestrictedReader::readString (codec::Decoder * data_) const {
     return "hello";
 }
 
@@ -55,3 +55,11 @@ RestrictedReader::type() const {
 }
 
 /******************************************************************************/
+
+bool
+amqp::internal::reader::
+RestrictedReader::referenceable() const {
+    return true;
+}
+
+/******************************************************************************/
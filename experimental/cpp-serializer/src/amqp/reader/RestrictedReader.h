@@ -11,7 +11,9 @@
 
 /******************************************************************************/
 
-struct pn_data_t;
+namespace amqp::codec {
+    class Decoder;
+}
 
 /******************************************************************************/
 
@@ -26,17 +28,19 @@ namespace amqp::internal::reader {
             explicit RestrictedReader (std::string);
             ~RestrictedReader() override = default;
 
-            std::any read (pn_data_t *) const override ;
+            std::any read (codec::Decoder *) const override ;
 
-            std::string readString (pn_data_t *) const override;
+            std::string readString (codec::Decoder *) const override;
 
             std::unique_ptr<amqp::reader::IValue> dump(
                 const std::string &,
-                pn_data_t *,
+                codec::Decoder *,
                 const SchemaType &) const override = 0;
 
             const std::string & name() const override;
             const std::string & type() const override;
+
+            bool referenceable() const override;
     };
 
 }
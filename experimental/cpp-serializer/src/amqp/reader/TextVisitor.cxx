@@ -0,0 +1,210 @@
+#include "TextVisitor.h"
+
+#include <string>
+#include <ostream>
+
+/******************************************************************************
+ *
+ * class TextVisitor
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+TextVisitor::TextVisitor (std::ostream & out_)
+    : m_out (out_)
+    , m_named (false)
+{
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::separate() {
+    if (m_named) {
+        m_named = false;
+    } else if (!m_first.empty()) {
+        if (!m_first.back()) {
+            m_out << ", ";
+        }
+        m_first.back() = false;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Is the next value the key of a map entry
+ */
+bool
+amqp::internal::reader::
+TextVisitor::key() const {
+    return !m_named && !m_maps.empty() && m_maps.back();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::open (const char * bracket_, bool map_) {
+    m_keys.push_back (key());
+
+    separate();
+    m_out << bracket_;
+    m_first.push_back (true);
+    m_maps.push_back (map_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::close (const char * bracket_) {
+    m_first.pop_back();
+    m_maps.pop_back();
+    m_out << bracket_;
+
+    // a composite or list used as a key still needs its value
+    if (m_keys.back()) {
+        m_out << " : ";
+        m_named = true;
+    }
+
+    m_keys.pop_back();
+}
+
+/******************************************************************************/
+
+/**
+ * Map keys are followed by the same separator as field names
+ */
+template<typename T>
+void
+amqp::internal::reader::
+TextVisitor::scalar (const T & value_) {
+    bool named = key();
+
+    separate();
+    m_out << value_;
+
+    if (named) {
+        m_out << " : ";
+        m_named = true;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::beginComposite (const std::string &) {
+    open ("{ ", false);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::endComposite() {
+    close (" }");
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::beginList (const std::string &, size_t) {
+    open ("[ ", false);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::endList() {
+    close (" ]");
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::beginMap (const std::string &, size_t) {
+    open ("{ ", true);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::endMap() {
+    close (" }");
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::field (const std::string & name_) {
+    separate();
+    m_out << name_ << " : ";
+    m_named = true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::onInt (int32_t value_) {
+    scalar (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::onLong (int64_t value_) {
+    scalar (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::onDouble (double value_) {
+    scalar (std::to_string (value_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::onBool (bool value_) {
+    scalar (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::onString (std::string_view value_) {
+    bool named = key();
+
+    separate();
+    m_out << '"' << value_ << '"';
+
+    if (named) {
+        m_out << " : ";
+        m_named = true;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TextVisitor::onEnum (std::string_view value_) {
+    scalar (value_);
+}
+
+/******************************************************************************/
@@ -0,0 +1,75 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+#include <iosfwd>
+
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Writes values out as they're visited in the same format as dumping
+     * the IValue tree would have produced, just without ever building
+     * the tree
+     */
+    class TextVisitor : public amqp::reader::IVisitor {
+        private :
+            std::ostream & m_out;
+
+            /**
+             * One entry per open composite or list, true until we've
+             * written its first element so we know when to add a comma
+             */
+            std::vector<bool> m_first;
+
+            /**
+             * Alongside m_first, true for maps, and whether what's open
+             * is itself a map's key
+             */
+            std::vector<bool> m_maps;
+            std::vector<bool> m_keys;
+
+            /**
+             * Set after writing a field name, the value that follows it
+             * shouldn't be separated from it
+             */
+            bool m_named;
+
+            void separate();
+
+            bool key() const;
+            void open (const char *, bool);
+            void close (const char *);
+
+            template<typename T>
+            void scalar (const T &);
+
+        public :
+            explicit TextVisitor (std::ostream &);
+
+            void beginComposite (const std::string &) override;
+            void endComposite() override;
+
+            void beginList (const std::string &, size_t) override;
+            void endList() override;
+
+            void beginMap (const std::string &, size_t) override;
+            void endMap() override;
+
+            void field (const std::string &) override;
+
+            void onInt (int32_t) override;
+            void onLong (int64_t) override;
+            void onDouble (double) override;
+            void onBool (bool) override;
+            void onString (std::string_view) override;
+            void onEnum (std::string_view) override;
+    };
+
+}
+
+/******************************************************************************/
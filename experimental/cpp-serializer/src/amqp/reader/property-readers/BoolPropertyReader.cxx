@@ -1,6 +1,8 @@
 #include "BoolPropertyReader.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/plan/Compiler.h"
+#include "amqp/stats/Stats.h"
 
 /******************************************************************************
  *
@@ -19,7 +21,7 @@ BoolPropertyReader::m_name { // NOLINT
 const std::string
 amqp::internal::reader::
 BoolPropertyReader::m_type { // NOLINT
-        "bool"
+        "boolean"
 };
 
 /******************************************************************************
@@ -30,16 +32,16 @@ BoolPropertyReader::m_type { // NOLINT
 
 std::any
 amqp::internal::reader::
-BoolPropertyReader::read (pn_data_t * data_) const {
-    return std::any (true);
+BoolPropertyReader::read (codec::Decoder * data_) const {
+    return std::any (codec::readAndNext<bool> (data_));
 }
 
 /******************************************************************************/
 
 std::string
 amqp::internal::reader::
-BoolPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<bool> (data_));
+BoolPropertyReader::readString (codec::Decoder * data_) const {
+    return std::to_string (codec::readAndNext<bool> (data_));
 }
 
 /******************************************************************************/
@@ -48,12 +50,14 @@ uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 BoolPropertyReader::dump (
         const std::string & name_,
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_) const
 {
+    AMQP_ALLOC_READER (stats::Bool);
+
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            std::to_string (proton::readAndNext<bool> (data_)));
+            std::to_string (codec::readAndNext<bool> (data_)));
 }
 
 /******************************************************************************/
@@ -61,11 +65,38 @@ BoolPropertyReader::dump (
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 BoolPropertyReader::dump (
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_) const
 {
+    AMQP_ALLOC_READER (stats::Bool);
+
     return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<bool> (data_)));
+            std::to_string (codec::readAndNext<bool> (data_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+BoolPropertyReader::visit (
+        codec::Decoder * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_) const
+{
+    AMQP_ALLOC_READER (stats::Bool);
+
+    visitor_.onBool (codec::readAndNext<bool> (data_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+BoolPropertyReader::compile (
+        plan::Compiler & compiler_,
+        const SchemaType & schema_) const
+{
+    compiler_.emit (plan::Op::BOOL);
 }
 
 /******************************************************************************/
@@ -1,6 +1,8 @@
 #include "DoublePropertyReader.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/plan/Compiler.h"
+#include "amqp/stats/Stats.h"
 
 /******************************************************************************
  *
@@ -28,7 +30,7 @@ DoublePropertyReader::m_type { // NOLINT
 
 std::any
 amqp::internal::reader::
-DoublePropertyReader::read (pn_data_t * data_) const {
+DoublePropertyReader::read (codec::Decoder * data_) const {
     return std::any (10.0);
 }
 
@@ -36,8 +38,8 @@ DoublePropertyReader::read (pn_data_t * data_) const {
 
 std::string
 amqp::internal::reader::
-DoublePropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<double> (data_));
+DoublePropertyReader::readString (codec::Decoder * data_) const {
+    return std::to_string (codec::readAndNext<double> (data_));
 }
 
 /******************************************************************************/
@@ -46,12 +48,14 @@ uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 DoublePropertyReader::dump (
         const std::string & name_,
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_) const
 {
+    AMQP_ALLOC_READER (stats::Double);
+
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            std::to_string (proton::readAndNext<double> (data_)));
+            std::to_string (codec::readAndNext<double> (data_)));
 }
 
 /******************************************************************************/
@@ -59,11 +63,38 @@ DoublePropertyReader::dump (
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 DoublePropertyReader::dump (
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_) const
 {
+    AMQP_ALLOC_READER (stats::Double);
+
     return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<double> (data_)));
+            std::to_string (codec::readAndNext<double> (data_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+DoublePropertyReader::visit (
+        codec::Decoder * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_) const
+{
+    AMQP_ALLOC_READER (stats::Double);
+
+    visitor_.onDouble (codec::readAndNext<double> (data_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+DoublePropertyReader::compile (
+        plan::Compiler & compiler_,
+        const SchemaType & schema_) const
+{
+    compiler_.emit (plan::Op::DOUBLE);
 }
 
 /******************************************************************************/
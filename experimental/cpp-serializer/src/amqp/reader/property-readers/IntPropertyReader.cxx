@@ -3,10 +3,11 @@
 
 #include <any>
 #include <string>
-#include <proton/codec.h>
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/plan/Compiler.h"
 #include "amqp/reader/IReader.h"
+#include "amqp/stats/Stats.h"
 
 /******************************************************************************
  *
@@ -36,7 +37,7 @@ IntPropertyReader::m_type { // NOLINT
 
 std::any
 amqp::internal::reader::
-IntPropertyReader::read (pn_data_t * data_) const {
+IntPropertyReader::read (codec::Decoder * data_) const {
     return std::any (1);
 }
 
@@ -44,8 +45,8 @@ IntPropertyReader::read (pn_data_t * data_) const {
 
 std::string
 amqp::internal::reader::
-IntPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<int> (data_));
+IntPropertyReader::readString (codec::Decoder * data_) const {
+    return std::to_string (codec::readAndNext<int> (data_));
 }
 
 /******************************************************************************/
@@ -54,12 +55,14 @@ uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 IntPropertyReader::dump (
         const std::string & name_,
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_) const
 {
+    AMQP_ALLOC_READER (stats::Int);
+
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            std::to_string (proton::readAndNext<int> (data_)));
+            std::to_string (codec::readAndNext<int> (data_)));
 }
 
 /******************************************************************************/
@@ -67,11 +70,38 @@ IntPropertyReader::dump (
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 IntPropertyReader::dump (
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_) const
 {
+    AMQP_ALLOC_READER (stats::Int);
+
     return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<int> (data_)));
+            std::to_string (codec::readAndNext<int> (data_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+IntPropertyReader::visit (
+        codec::Decoder * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_) const
+{
+    AMQP_ALLOC_READER (stats::Int);
+
+    visitor_.onInt (codec::readAndNext<int> (data_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+IntPropertyReader::compile (
+        plan::Compiler & compiler_,
+        const SchemaType & schema_) const
+{
+    compiler_.emit (plan::Op::INT);
 }
 
 /******************************************************************************/
@@ -1,6 +1,8 @@
 #include "LongPropertyReader.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/plan/Compiler.h"
+#include "amqp/stats/Stats.h"
 
 /******************************************************************************
  *
@@ -30,7 +32,7 @@ LongPropertyReader::m_type { // NOLINT
 
 std::any
 amqp::internal::reader::
-LongPropertyReader::read (pn_data_t * data_) const {
+LongPropertyReader::read (codec::Decoder * data_) const {
     return std::any (10L);
 }
 
@@ -38,8 +40,8 @@ LongPropertyReader::read (pn_data_t * data_) const {
 
 std::string
 amqp::internal::reader::
-LongPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<long> (data_));
+LongPropertyReader::readString (codec::Decoder * data_) const {
+    return std::to_string (codec::readAndNext<long> (data_));
 }
 
 /******************************************************************************/
@@ -48,12 +50,14 @@ uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 LongPropertyReader::dump (
         const std::string & name_,
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_) const
 {
+    AMQP_ALLOC_READER (stats::Long);
+
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            std::to_string (proton::readAndNext<long> (data_)));
+            std::to_string (codec::readAndNext<long> (data_)));
 }
 
 /******************************************************************************/
@@ -61,11 +65,38 @@ LongPropertyReader::dump (
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 LongPropertyReader::dump (
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_) const
 {
+    AMQP_ALLOC_READER (stats::Long);
+
     return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<long> (data_)));
+            std::to_string (codec::readAndNext<long> (data_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+LongPropertyReader::visit (
+        codec::Decoder * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_) const
+{
+    AMQP_ALLOC_READER (stats::Long);
+
+    visitor_.onLong (codec::readAndNext<long> (data_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+LongPropertyReader::compile (
+        plan::Compiler & compiler_,
+        const SchemaType & schema_) const
+{
+    compiler_.emit (plan::Op::LONG);
 }
 
 /******************************************************************************/
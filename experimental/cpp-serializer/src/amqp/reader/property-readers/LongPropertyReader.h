@@ -14,21 +14,30 @@ namespace amqp::internal::reader {
             static const std::string m_type;
 
         public :
-            std::string readString (pn_data_t *) const override;
+            std::string readString (codec::Decoder *) const override;
 
-            std::any read (pn_data_t *) const override;
+            std::any read (codec::Decoder *) const override;
 
             uPtr<amqp::reader::IValue> dump(
                 const std::string &,
-                pn_data_t *,
+                codec::Decoder *,
                 const SchemaType &
             ) const override;
 
             uPtr<amqp::reader::IValue> dump(
-                pn_data_t *,
+                codec::Decoder *,
                 const SchemaType &
             ) const override;
 
+            void visit (
+                codec::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            void compile (
+                plan::Compiler &,
+                const SchemaType &) const override;
+
             const std::string & name() const override;
             const std::string & type() const override;
     };
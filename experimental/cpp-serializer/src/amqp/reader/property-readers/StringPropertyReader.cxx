@@ -1,8 +1,9 @@
 #include "StringPropertyReader.h"
 
-#include <proton/codec.h>
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/plan/Compiler.h"
+#include "amqp/stats/Stats.h"
 
 /******************************************************************************
  *
@@ -32,7 +33,7 @@ StringPropertyReader::m_name { // NOLINT
 
 std::any
 amqp::internal::reader::
-StringPropertyReader::read (pn_data_t * data_) const {
+StringPropertyReader::read (codec::Decoder * data_) const {
     return std::any ("hello");
 }
 
@@ -40,8 +41,8 @@ StringPropertyReader::read (pn_data_t * data_) const {
 
 std::string
 amqp::internal::reader::
-StringPropertyReader::readString (pn_data_t * data_) const {
-    return proton::readAndNext<std::string> (data_);
+StringPropertyReader::readString (codec::Decoder * data_) const {
+    return codec::readAndNext<std::string> (data_);
 }
 
 /******************************************************************************/
@@ -50,12 +51,14 @@ uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 StringPropertyReader::dump (
         const std::string & name_,
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_) const
 {
+    AMQP_ALLOC_READER (stats::String);
+
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            "\"" + proton::readAndNext<std::string> (data_) + "\"");
+            "\"" + codec::readAndNext<std::string> (data_) + "\"");
 }
 
 /******************************************************************************/
@@ -63,11 +66,38 @@ StringPropertyReader::dump (
 uPtr<amqp::reader::IValue>
 amqp::internal::reader::
 StringPropertyReader::dump (
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_) const
 {
+    AMQP_ALLOC_READER (stats::String);
+
     return std::make_unique<TypedSingle<std::string>> (
-            "\"" + proton::readAndNext<std::string> (data_) + "\"");
+            "\"" + codec::readAndNext<std::string> (data_) + "\"");
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StringPropertyReader::visit (
+        codec::Decoder * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_) const
+{
+    AMQP_ALLOC_READER (stats::String);
+
+    visitor_.onString (codec::readAndNext<std::string_view> (data_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StringPropertyReader::compile (
+        plan::Compiler & compiler_,
+        const SchemaType & schema_) const
+{
+    compiler_.emit (plan::Op::STRING);
 }
 
 /******************************************************************************/
@@ -87,3 +117,11 @@ StringPropertyReader::type() const {
 }
 
 /******************************************************************************/
+
+bool
+amqp::internal::reader::
+StringPropertyReader::referenceable() const {
+    return true;
+}
+
+/******************************************************************************/
@@ -2,7 +2,9 @@
 
 #include "amqp/reader/IReader.h"
 #include "amqp/descriptors/AMQPDescriptorRegistory.h"
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/plan/Compiler.h"
+#include "amqp/stats/Stats.h"
 
 /******************************************************************************/
 
@@ -19,33 +21,22 @@ EnumReader::EnumReader (
 /******************************************************************************/
 
 namespace {
-    std::string
-    getValue (pn_data_t * data_) {
-        proton::is_described (data_);
+    std::string_view
+    getValue (amqp::codec::Decoder * data_) {
+        amqp::codec::is_described (data_);
 
         {
-            proton::auto_enter ae (data_);
-
             /*
-             * Referenced objects are added to a stream when the serialiser
-             * notices it's writing a value it's already written, so to save
-             * space it will just link back to that. Currently we have
-             * no mechanism for decoding that so just throw an error
+             * A reference to an enum written earlier in the stream is
+             * resolved before we get here, see visitObject
              */
-            if (pn_data_type (data_) == PN_ULONG) {
-                if (amqp::stripCorda(pn_data_get_ulong(data_)) ==
-                amqp::internal::REFERENCED_OBJECT
-            ) {
-                    throw std::runtime_error (
-                            "Currently don't support referenced objects");
-                }
-            }
+            amqp::codec::auto_enter ae (data_);
 
-            auto fingerprint = proton::readAndNext<std::string>(data_);
+            [[maybe_unused]] auto fingerprint = amqp::codec::readAndNext<std::string_view>(data_);
 
-            proton::auto_list_enter ale (data_, true);
+            amqp::codec::auto_list_enter ale (data_, true);
 
-            return proton::readAndNext<std::string>(data_);
+            return amqp::codec::readAndNext<std::string_view>(data_);
 
             /*
              * After a string representation of the enumerated value
@@ -53,7 +44,7 @@ namespace {
              * just dumping things to a string but if I don't leave this
              * here I'll forget its even a thing
              */
-            // auto idx = proton::readAndNext<int>(data_);
+            // auto idx = amqp::codec::readAndNext<int>(data_);
 
         }
 
@@ -62,19 +53,31 @@ namespace {
 
 /******************************************************************************/
 
+std::string_view
+amqp::internal::reader::
+EnumReader::value (codec::Decoder * data_) {
+    codec::auto_next an (data_);
+
+    return getValue (data_);
+}
+
+/******************************************************************************/
+
 std::unique_ptr<amqp::reader::IValue>
 amqp::internal::reader::
 EnumReader::dump (
         const std::string & name_,
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_
 ) const {
-    proton::auto_next an (data_);
-    proton::is_described (data_);
+    AMQP_ALLOC_READER (stats::Enum);
+
+    codec::auto_next an (data_);
+    codec::is_described (data_);
 
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            getValue(data_));
+            std::string (getValue(data_)));
 }
 
 /******************************************************************************/
@@ -82,14 +85,45 @@ EnumReader::dump (
 std::unique_ptr<amqp::reader::IValue>
 amqp::internal::reader::
 EnumReader::dump(
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_
 ) const {
-    proton::auto_next an (data_);
-    proton::is_described (data_);
+    AMQP_ALLOC_READER (stats::Enum);
+
+    codec::auto_next an (data_);
+    codec::is_described (data_);
+
+    return std::make_unique<TypedSingle<std::string>> (
+            std::string (getValue(data_)));
+
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+EnumReader::visit (
+        codec::Decoder * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    AMQP_ALLOC_READER (stats::Enum);
+
+    codec::auto_next an (data_);
+    codec::is_described (data_);
 
-    return std::make_unique<TypedSingle<std::string>> (getValue(data_));
+    visitor_.onEnum (getValue (data_));
+}
+
+/******************************************************************************/
 
+void
+amqp::internal::reader::
+EnumReader::compile (
+        plan::Compiler & compiler_,
+        const SchemaType & schema_
+) const {
+    compiler_.emit (plan::Op::ENUM);
 }
 
 /******************************************************************************/
@@ -12,13 +12,28 @@ namespace amqp::internal::reader {
         public :
             EnumReader (std::string, std::vector<std::string>);
 
+            /**
+             * Read the name of the constant an enum value is, and
+             * move past it
+             */
+            static std::string_view value (codec::Decoder *);
+
             std::unique_ptr<amqp::reader::IValue> dump(
                 const std::string &,
-                pn_data_t *,
+                codec::Decoder *,
                 const SchemaType &) const override;
 
             std::unique_ptr<amqp::reader::IValue> dump(
-                pn_data_t *,
+                codec::Decoder *,
+                const SchemaType &) const override;
+
+            void visit (
+                codec::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            void compile (
+                plan::Compiler &,
                 const SchemaType &) const override;
     };
 
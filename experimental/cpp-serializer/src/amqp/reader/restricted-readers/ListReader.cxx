@@ -1,6 +1,8 @@
 #include "ListReader.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/plan/Compiler.h"
+#include "amqp/stats/Stats.h"
 
 /******************************************************************************
  *
@@ -20,10 +22,12 @@ std::unique_ptr<amqp::reader::IValue>
 amqp::internal::reader::
 ListReader::dump (
     const std::string & name_,
-    pn_data_t * data_,
+    codec::Decoder * data_,
     const SchemaType & schema_
 ) const {
-    proton::auto_next an (data_);
+    AMQP_ALLOC_READER (stats::List);
+
+    codec::auto_next an (data_);
 
     return std::make_unique<TypedPair<sList<uPtr<amqp::reader::IValue>>>>(
          name_,
@@ -35,10 +39,12 @@ ListReader::dump (
 std::unique_ptr<amqp::reader::IValue>
 amqp::internal::reader::
 ListReader::dump(
-    pn_data_t * data_,
+    codec::Decoder * data_,
     const SchemaType & schema_
 ) const {
-    proton::auto_next an (data_);
+    AMQP_ALLOC_READER (stats::List);
+
+    codec::auto_next an (data_);
 
     return std::make_unique<TypedSingle<sList<uPtr<amqp::reader::IValue>>>>(
          dump_ (data_, schema_));
@@ -49,22 +55,22 @@ ListReader::dump(
 std::list<std::unique_ptr<amqp::reader::IValue>>
 amqp::internal::reader::
 ListReader::dump_(
-        pn_data_t * data_,
+        codec::Decoder * data_,
         const SchemaType & schema_
 ) const {
-    proton::is_described (data_);
+    codec::is_described (data_);
 
     std::list<std::unique_ptr<amqp::reader::IValue>> read;
 
     {
-        proton::auto_enter ae (data_);
-        schema_.fromDescriptor (proton::readAndNext<std::string>(data_));
+        codec::auto_enter ae (data_);
+        data_->next();
 
         {
-            proton::auto_list_enter ale (data_, true);
+            codec::auto_list_enter ale (data_, true);
 
             for (size_t i { 0 } ; i < ale.elements() ; ++i) {
-                read.emplace_back (m_reader.lock()->dump (data_, schema_));
+                read.emplace_back (dumpObject (*m_reader, data_, schema_));
             }
         }
     }
@@ -73,3 +79,57 @@ ListReader::dump_(
 }
 
 /******************************************************************************/
+
+void
+amqp::internal::reader::
+ListReader::visit (
+    codec::Decoder * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    AMQP_ALLOC_READER (stats::List);
+
+    codec::auto_next an (data_);
+    codec::is_described (data_);
+
+    {
+        codec::auto_enter ae (data_);
+        data_->next();
+
+        {
+            codec::auto_list_enter ale (data_, true);
+            visitor_.beginList (type(), ale.elements());
+
+            for (size_t i { 0 } ; i < ale.elements() ; ++i) {
+                visitObject (*m_reader, data_, schema_, visitor_);
+            }
+
+            visitor_.endList();
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ListReader::compile (
+    plan::Compiler & compiler_,
+    const SchemaType & schema_
+) const {
+    compiler_.call (*this, [this, &schema_](plan::Compiler & c) {
+        auto begin = c.emit (plan::Op::BEGIN_LIST, c.intern (type()));
+        auto body = c.here();
+
+        c.object (*m_reader);
+        m_reader->compile (c, schema_);
+
+        c.emit (plan::Op::LOOP, 0, body);
+
+        // an empty list jumps straight to the end
+        c.patch (begin, c.here());
+        c.emit (plan::Op::END_LIST);
+    });
+}
+
+/******************************************************************************/
@@ -10,19 +10,19 @@ namespace amqp::internal::reader {
 
     class ListReader : public RestrictedReader {
         private :
-            // How to read the underlying types
-            std::weak_ptr<Reader> m_reader;
+            // How to read the underlying types, owned by the factory
+            const Reader * m_reader;
 
             std::list<uPtr<amqp::reader::IValue>> dump_(
-                pn_data_t *,
+                codec::Decoder *,
                 const SchemaType &) const;
 
         public :
             ListReader (
                 const std::string & type_,
-                std::weak_ptr<Reader> reader_
+                const Reader * reader_
             ) : RestrictedReader (type_)
-              , m_reader (std::move (reader_))
+              , m_reader (reader_)
             { }
 
             ~ListReader() final = default;
@@ -31,11 +31,20 @@ namespace amqp::internal::reader {
 
             std::unique_ptr<amqp::reader::IValue> dump(
                 const std::string &,
-                pn_data_t *,
+                codec::Decoder *,
                 const SchemaType &) const override;
 
             std::unique_ptr<amqp::reader::IValue> dump(
-                pn_data_t *,
+                codec::Decoder *,
+                const SchemaType &) const override;
+
+            void visit (
+                codec::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            void compile (
+                plan::Compiler &,
                 const SchemaType &) const override;
     };
 
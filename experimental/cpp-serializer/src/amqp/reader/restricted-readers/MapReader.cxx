@@ -0,0 +1,158 @@
+#include "MapReader.h"
+
+#include "amqp/codec/Decoder.h"
+#include "amqp/plan/Compiler.h"
+#include "amqp/stats/Stats.h"
+
+/******************************************************************************
+ *
+ * class MapReader
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::Restricted::RestrictedTypes
+amqp::internal::reader::
+MapReader::restrictedType() const {
+    return internal::schema::Restricted::RestrictedTypes::Map;
+}
+
+/******************************************************************************/
+
+std::unique_ptr<amqp::reader::IValue>
+amqp::internal::reader::
+MapReader::dump (
+    const std::string & name_,
+    codec::Decoder * data_,
+    const SchemaType & schema_
+) const {
+    AMQP_ALLOC_READER (stats::Map);
+
+    codec::auto_next an (data_);
+
+    return std::make_unique<TypedPair<MapEntries>>(
+         name_,
+         dump_ (data_, schema_));
+}
+
+/******************************************************************************/
+
+std::unique_ptr<amqp::reader::IValue>
+amqp::internal::reader::
+MapReader::dump(
+    codec::Decoder * data_,
+    const SchemaType & schema_
+) const {
+    AMQP_ALLOC_READER (stats::Map);
+
+    codec::auto_next an (data_);
+
+    return std::make_unique<TypedSingle<MapEntries>>(
+         dump_ (data_, schema_));
+}
+
+/******************************************************************************/
+
+/**
+ * A map is written as a described AMQP map, its keys and values
+ * alternating
+ */
+amqp::internal::reader::MapEntries
+amqp::internal::reader::
+MapReader::dump_(
+        codec::Decoder * data_,
+        const SchemaType & schema_
+) const {
+    codec::is_described (data_);
+
+    MapEntries read;
+
+    {
+        codec::auto_enter ae (data_);
+        data_->next();
+
+        codec::is_map (data_);
+        auto entries = data_->getMap() / 2;
+
+        read.reserve (entries);
+
+        {
+            codec::auto_enter ae2 (data_);
+
+            for (size_t i { 0 } ; i < entries ; ++i) {
+                auto key = dumpObject (*m_keyReader, data_, schema_);
+                read.emplace_back (
+                        std::move (key),
+                        dumpObject (*m_valueReader, data_, schema_));
+            }
+        }
+    }
+
+    return read;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+MapReader::visit (
+    codec::Decoder * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    AMQP_ALLOC_READER (stats::Map);
+
+    codec::auto_next an (data_);
+    codec::is_described (data_);
+
+    {
+        codec::auto_enter ae (data_);
+        data_->next();
+
+        codec::is_map (data_);
+        auto entries = data_->getMap() / 2;
+
+        {
+            codec::auto_enter ae2 (data_);
+            visitor_.beginMap (type(), entries);
+
+            for (size_t i { 0 } ; i < entries ; ++i) {
+                visitObject (*m_keyReader, data_, schema_, visitor_);
+                visitObject (*m_valueReader, data_, schema_, visitor_);
+            }
+
+            visitor_.endMap();
+        }
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * A projection applies to the values of a map, keys are always read whole
+ */
+void
+amqp::internal::reader::
+MapReader::compile (
+    plan::Compiler & compiler_,
+    const SchemaType & schema_
+) const {
+    static const plan::Projection everything;
+
+    compiler_.call (*this, [this, &schema_](plan::Compiler & c) {
+        auto begin = c.emit (plan::Op::BEGIN_MAP, c.intern (type()));
+        auto body = c.here();
+
+        c.object (*m_keyReader);
+        c.within (everything, [&]() { m_keyReader->compile (c, schema_); });
+        c.object (*m_valueReader);
+        m_valueReader->compile (c, schema_);
+
+        c.emit (plan::Op::LOOP, 0, body);
+
+        // an empty map jumps straight to the end
+        c.patch (begin, c.here());
+        c.emit (plan::Op::END_MAP);
+    });
+}
+
+/******************************************************************************/
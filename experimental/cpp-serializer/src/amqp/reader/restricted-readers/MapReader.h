@@ -0,0 +1,56 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "RestrictedReader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    class MapReader : public RestrictedReader {
+        private :
+            // How to read the keys and values, owned by the factory
+            const Reader * m_keyReader;
+            const Reader * m_valueReader;
+
+            MapEntries dump_(
+                codec::Decoder *,
+                const SchemaType &) const;
+
+        public :
+            MapReader (
+                const std::string & type_,
+                const Reader * keyReader_,
+                const Reader * valueReader_
+            ) : RestrictedReader (type_)
+              , m_keyReader (keyReader_)
+              , m_valueReader (valueReader_)
+            { }
+
+            ~MapReader() final = default;
+
+            internal::schema::Restricted::RestrictedTypes restrictedType() const;
+
+            std::unique_ptr<amqp::reader::IValue> dump(
+                const std::string &,
+                codec::Decoder *,
+                const SchemaType &) const override;
+
+            std::unique_ptr<amqp::reader::IValue> dump(
+                codec::Decoder *,
+                const SchemaType &) const override;
+
+            void visit (
+                codec::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            void compile (
+                plan::Compiler &,
+                const SchemaType &) const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -56,7 +56,23 @@ AMQPTypeNotation::descriptor() const {
 const std::string &
 amqp::internal::schema::
 AMQPTypeNotation::name() const {
+    return m_name.str();
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Symbol &
+amqp::internal::schema::
+AMQPTypeNotation::id() const {
     return m_name;
 }
 
 /******************************************************************************/
+
+const amqp::internal::schema::Symbol &
+amqp::internal::schema::
+AMQPTypeNotation::descriptorId() const {
+    return m_descriptor->id();
+}
+
+/******************************************************************************/
@@ -5,6 +5,7 @@
 #include <memory>
 #include <types.h>
 
+#include "Symbol.h"
 #include "Descriptor.h"
 #include "OrderedTypeNotations.h"
 
@@ -40,14 +41,14 @@ namespace amqp::internal::schema {
             enum Type { Composite, Restricted };
 
         private :
-            std::string                 m_name;
+            Symbol                      m_name;
             std::unique_ptr<Descriptor> m_descriptor;
 
         public :
             AMQPTypeNotation (
                 std::string name_,
                 std::unique_ptr<Descriptor> descriptor_
-            ) : m_name (std::move (name_))
+            ) : m_name (name_)
               , m_descriptor (std::move (descriptor_))
             { }
 
@@ -55,11 +56,16 @@ namespace amqp::internal::schema {
 
             const std::string & name() const;
 
+            /**
+             * Interned forms of the above, what anything looking types
+             * up or comparing them should be using
+             */
+            const Symbol & id() const override;
+            const Symbol & descriptorId() const;
+
             virtual Type type() const = 0;
 
-            int dependsOn (const OrderedTypeNotation &) const override = 0;
-            virtual int dependsOn (const class Restricted &) const = 0;
-            virtual int dependsOn (const class Composite &) const = 0;
+            void dependencies (std::vector<Symbol> &) const override = 0;
     };
 
 }
@@ -20,7 +20,7 @@ namespace amqp::internal::schema {
 
 amqp::internal::schema::
 Descriptor::Descriptor (std::string name_)
-    : m_name (std::move (name_))
+    : m_name (name_)
 { }
 
 /******************************************************************************/
@@ -28,6 +28,14 @@ Descriptor::Descriptor (std::string name_)
 const std::string &
 amqp::internal::schema::
 Descriptor::name() const {
+    return m_name.str();
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Symbol &
+amqp::internal::schema::
+Descriptor::id() const {
     return m_name;
 }
 
@@ -5,6 +5,8 @@
 #include <iosfwd>
 #include <string>
 
+#include "Symbol.h"
+
 #include "amqp/AMQPDescribed.h"
 
 /******************************************************************************/
@@ -16,7 +18,7 @@ namespace amqp::internal::schema {
             friend std::ostream & operator << (std::ostream &, const Descriptor&);
 
         private :
-            std::string m_name;
+            Symbol m_name;
 
         public :
             Descriptor() = default;
@@ -24,6 +26,7 @@ namespace amqp::internal::schema {
             explicit Descriptor (std::string);
 
             const std::string & name() const;
+            const Symbol & id() const;
     };
 
 }
@@ -36,13 +36,16 @@ Field::Field (
   , m_label (label_)
   , m_mandatory (mandatory_)
   , m_multiple (multiple_)
+  , m_resolved ((type_ == "*" && !requires_.empty()) ? requires_.front() : type_)
 {
-    if (typeIsPrimitive(type_)) {
-        m_type = std::make_pair(type_, FieldType::PrimitiveProperty);
+    Symbol type (type_);
+
+    if (typeIsPrimitive(type)) {
+        m_type = std::make_pair(type, FieldType::PrimitiveProperty);
     } else if (type_ == "*") {
-        m_type = std::make_pair(type_, FieldType::RestrictedProperty);
+        m_type = std::make_pair(type, FieldType::RestrictedProperty);
     } else {
-        m_type = std::make_pair(type_, FieldType::CompositeProperty);
+        m_type = std::make_pair(type, FieldType::CompositeProperty);
     }
 }
 
@@ -51,11 +54,15 @@ Field::Field (
 bool
 amqp::internal::schema::
 Field::typeIsPrimitive(const std::string & type_) {
-    return (type_ == "string" ||
-            type_ == "long" ||
-            type_ == "boolean" ||
-            type_ == "int" ||
-            type_ == "double");
+    return Symbol::find (type_).primitive();
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::schema::
+Field::typeIsPrimitive(const Symbol & type_) {
+    return type_.primitive();
 }
 
 /******************************************************************************/
@@ -71,7 +78,7 @@ Field::name() const {
 const std::string &
 amqp::internal::schema::
 Field::type() const {
-    return m_type.first;
+    return m_type.first.str();
 }
 
 /******************************************************************************/
@@ -79,7 +86,23 @@ Field::type() const {
 const std::string &
 amqp::internal::schema::
 Field::resolvedType() const {
-    return (type() == "*") ? requires().front() : type();
+    return m_resolved.str();
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Symbol &
+amqp::internal::schema::
+Field::typeId() const {
+    return m_type.first;
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Symbol &
+amqp::internal::schema::
+Field::resolvedTypeId() const {
+    return m_resolved;
 }
 
 /******************************************************************************/
@@ -100,6 +123,38 @@ Field::requires() const {
 
 /******************************************************************************/
 
+const std::string &
+amqp::internal::schema::
+Field::defaultValue() const {
+    return m_default;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+Field::label() const {
+    return m_label;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::schema::
+Field::mandatory() const {
+    return m_mandatory;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::schema::
+Field::multiple() const {
+    return m_multiple;
+}
+
+/******************************************************************************/
+
 bool
 amqp::internal::schema::
 Field::primitive() const {
@@ -1,6 +1,7 @@
 #pragma once
 /******************************************************************************/
 
+#include "Symbol.h"
 #include "Descriptor.h"
 #include "amqp/AMQPDescribed.h"
 
@@ -30,16 +31,22 @@ namespace amqp::internal::schema {
             friend std::ostream & operator << (std::ostream &, const Field &);
 
             static bool typeIsPrimitive(const std::string &);
+            static bool typeIsPrimitive(const Symbol &);
 
         private :
             std::string                       m_name;
-            std::pair<std::string, FieldType> m_type;
+            std::pair<Symbol, FieldType>      m_type;
             std::list<std::string>            m_requires;
             std::string                       m_default;
             std::string                       m_label;
             bool                              m_mandatory;
             bool                              m_multiple;
 
+            /**
+             * Our type, or for a restricted type the one it requires
+             */
+            Symbol                            m_resolved;
+
         public :
             Field (const std::string            & name_,
                    const std::string            & type_,
@@ -52,8 +59,14 @@ namespace amqp::internal::schema {
             const std::string            & name() const;
             const std::string            & type() const;
             const std::string            & resolvedType() const;
+            const Symbol                 & typeId() const;
+            const Symbol                 & resolvedTypeId() const;
             FieldType                      fieldType() const;
             const std::list<std::string> & requires() const;
+            const std::string            & defaultValue() const;
+            const std::string            & label() const;
+            bool                           mandatory() const;
+            bool                           multiple() const;
             bool primitive() const;
     };
 
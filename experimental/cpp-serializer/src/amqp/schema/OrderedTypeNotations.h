@@ -1,12 +1,19 @@
 #pragma once
 
 #include <list>
+#include <deque>
+#include <vector>
 #include <ostream>
 #include <iostream>
+#include <algorithm>
+#include <unordered_map>
 
 #include "types.h"
 #include "colours.h"
 
+#include "Symbol.h"
+#include "amqp/stats/Timer.h"
+
 /******************************************************************************
  *
  * Forward declarations
@@ -35,43 +42,74 @@ namespace amqp::internal::schema {
         public :
             virtual ~OrderedTypeNotation() = default;
 
-            virtual int dependsOn (const OrderedTypeNotation &) const = 0;
+            /**
+             * What other types refer to us as
+             */
+            virtual const Symbol & id() const = 0;
+
+            /**
+             * Append the ids of the types we need built before us. Ones
+             * that aren't in the set being ordered, primitives for
+             * instance, are ignored
+             */
+            virtual void dependencies (std::vector<Symbol> &) const = 0;
     };
 
 }
 
 /******************************************************************************/
 
+/**
+ * A set of types grouped into levels such that iterating over it yields
+ * every type after all of those it depends on. Types in the same level
+ * don't depend on each other and keep the order they were inserted in.
+ *
+ * Inserting only collects the types, they're ordered the first time the
+ * levels are looked at, and again if more are inserted after that. The
+ * ordering is Kahn's algorithm over dependency edges found by looking up
+ * each type's dependencies by id, so it's linear in the number of types
+ * and dependencies rather than comparing every type against every other.
+ * Types that are part of a dependency cycle can't be ordered and end up
+ * in a final level of their own.
+ *
+ * Since ordering happens on first use build these on one thread before
+ * sharing them.
+ */
 namespace amqp::internal::schema {
 
     template<class T>
     class OrderedTypeNotations {
         private:
-            std::list<std::list<uPtr<T>>> m_schemas;
+            /**
+             * Stored with the types that depend on others first, iterating
+             * runs backwards over it
+             */
+            mutable std::list<std::list<uPtr<T>>> m_schemas;
 
-        public :
-            typedef decltype(m_schemas.begin()) iterator;
+            /**
+             * Inserted since we last ordered
+             */
+            mutable std::vector<uPtr<T>> m_pending;
 
-        private:
-            void insert (uPtr<T> &&, iterator);
-            void insertNewList (uPtr<T> &&);
-            void insertNewList (
-                    uPtr<T> &&,
-                    typename std::list<std::list<uPtr<T>>>::iterator &);
+            void order() const;
 
         public :
+            typedef decltype(m_schemas.begin()) iterator;
+
             void insert(uPtr<T> && ptr);
 
+            const std::list<std::list<uPtr<T>>> & levels() const;
+
             friend std::ostream & ::operator << <> (
                     std::ostream &,
                     const amqp::internal::schema::OrderedTypeNotations<T> &);
 
             decltype (m_schemas.crbegin()) begin() const {
-                return m_schemas.crbegin();
+                return levels().crbegin();
             }
 
             decltype (m_schemas.crend()) end() const {
-                return m_schemas.crend();
+                return levels().crend();
             }
     };
 
@@ -86,7 +124,7 @@ operator << (
         const amqp::internal::schema::OrderedTypeNotations<T> &otn_
 ) {
     int idx1{0};
-    for (const auto &i : otn_.m_schemas) {
+    for (const auto &i : otn_.levels()) {
         stream_ << "level " << ++idx1 << std::endl;
         for (const auto &j : i) {
             stream_ << "    * " << j->name() << std::endl;
@@ -102,29 +140,21 @@ operator << (
 template<class T>
 void
 amqp::internal::schema::
-OrderedTypeNotations<T>::insertNewList(uPtr<T> && ptr) {
-    std::list<uPtr<T>> l;
-    l.emplace_back (std::move (ptr));
-    m_schemas.emplace_back(std::move (l));
+OrderedTypeNotations<T>::insert (uPtr<T> && ptr) {
+    m_pending.emplace_back (std::move (ptr));
 }
 
 /******************************************************************************/
 
-/**
- * This could be a bit more space efficient by checking the previous element
- * for dependendies again as its possible we are moving multiple elements "up"
- * but the extra checks probably don't make it worth it.
- */
 template<class T>
-void
+const std::list<std::list<uPtr<T>>> &
 amqp::internal::schema::
-OrderedTypeNotations<T>::insertNewList(
-        uPtr<T> && ptr,
-        typename std::list<std::list<uPtr<T>>>::iterator & here_)
-{
-    std::list<uPtr<T>> l;
-    l.emplace_back (std::move (ptr));
-    m_schemas.insert(here_, std::move (l));
+OrderedTypeNotations<T>::levels() const {
+    if (!m_pending.empty()) {
+        order();
+    }
+
+    return m_schemas;
 }
 
 /******************************************************************************/
@@ -132,75 +162,112 @@ OrderedTypeNotations<T>::insertNewList(
 template<class T>
 void
 amqp::internal::schema::
-OrderedTypeNotations<T>::insert (uPtr<T> && ptr) {
-    return insert (std::move (ptr), m_schemas.begin());
-}
+OrderedTypeNotations<T>::order() const {
+    stats::Timer timer (stats::Order);
 
-/******************************************************************************/
+    /*
+     * Anything we'd already ordered goes back in with the new types,
+     * taking the levels in order keeps types that were in the same
+     * one in the same order as before
+     */
+    std::vector<uPtr<T>> types;
+
+    for (auto & level : m_schemas) {
+        for (auto & type : level) {
+            types.emplace_back (std::move (type));
+        }
+    }
+
+    m_schemas.clear();
+
+    for (auto & type : m_pending) {
+        types.emplace_back (std::move (type));
+    }
+
+    m_pending.clear();
+
+    std::unordered_map<Symbol, size_t> index;
+    index.reserve (types.size());
+
+    for (size_t i { 0 } ; i < types.size() ; ++i) {
+        index.emplace (types[i]->id(), i);
+    }
 
-template<class T>
-void
-amqp::internal::schema::
-OrderedTypeNotations<T>::insert (
-        uPtr<T> && ptr,
-        amqp::internal::schema::OrderedTypeNotations<T>::iterator l_
-) {
     /*
-     * First we find where this element needs to be added
+     * An edge from each type to the types that depend on it, and how
+     * many dependencies each type is still waiting on
      */
-    amqp::internal::schema::OrderedTypeNotations<T>::iterator insertionPoint { l_ };
-
-    for (auto i = l_ ; i != m_schemas.end() ; ++i) {
-        for (const auto & j : *i) {
-            /*
-             * A score of 0 means no dependencies at all
-             * A score of 1 means "j" has a dependency on what's being inserted
-             * A score of 2 means what's being inserted depends on "j"
-             */
-            auto score = j->dependsOn(*ptr);
+    std::vector<std::vector<size_t>> dependents (types.size());
+    std::vector<size_t> waiting (types.size(), 0);
+    std::vector<Symbol> dependencies;
+
+    for (size_t i { 0 } ; i < types.size() ; ++i) {
+        dependencies.clear();
+        types[i]->dependencies (dependencies);
 
-            if (score == 1) {
-                insertionPoint = std::next(i);
-            } else if (score == 2) {
-                insertionPoint = i;
-                goto done;
+        for (const auto & dependency : dependencies) {
+            auto it = index.find (dependency);
+
+            if (it != index.end() && it->second != i) {
+                dependents[it->second].push_back (i);
+                ++waiting[i];
             }
         }
     }
-done:
 
     /*
-     * Now we insert it and work out if anything requires shuffling
+     * A type's level is one more than the deepest of its dependencies,
+     * working outwards from the types that don't have any
      */
-    if (insertionPoint == m_schemas.end()) {
-        insertNewList (std::move(ptr));
-    } else {
-        const auto & insertedPtr = insertionPoint->emplace_front (std::move(ptr));
-
-        for (auto j = std::next (insertionPoint->begin()) ; j != insertionPoint->end() ; ) {
-            auto toErase = j++;
-
-            auto score { insertedPtr->dependsOn (**toErase) };
-
-            if (score > 0) {
-                uPtr<T> tmpPtr{std::move(*toErase)};
-                insertionPoint->erase (toErase);
-                switch (score) {
-                    // Needs to go after the element we're adding
-                    case 1: {
-                        insert(std::move(tmpPtr), std::next(insertionPoint));
-                        break;
-                    }
-                    // Needs to go before the element we're adding
-                    case 2: {
-                        insertNewList (std::move(tmpPtr), insertionPoint);
-                        break;
-                    }
-                }
+    std::vector<size_t> level (types.size(), 0);
+    std::deque<size_t> ready;
+    size_t deepest { 0 };
+
+    for (size_t i { 0 } ; i < types.size() ; ++i) {
+        if (!waiting[i]) {
+            ready.push_back (i);
+        }
+    }
 
+    size_t ordered { 0 };
+
+    while (!ready.empty()) {
+        auto i = ready.front();
+        ready.pop_front();
+        ++ordered;
+
+        deepest = std::max (deepest, level[i]);
+
+        for (auto dependent : dependents[i]) {
+            level[dependent] = std::max (level[dependent], level[i] + 1);
+
+            if (!--waiting[dependent]) {
+                ready.push_back (dependent);
             }
         }
     }
+
+    if (ordered != types.size()) {
+        ++deepest;
+
+        for (size_t i { 0 } ; i < types.size() ; ++i) {
+            if (waiting[i]) {
+                level[i] = deepest;
+            }
+        }
+    }
+
+    std::vector<std::list<uPtr<T>>> levels (types.empty() ? 0 : deepest + 1);
+
+    for (size_t i { 0 } ; i < types.size() ; ++i) {
+        levels[deepest - level[i]].emplace_back (std::move (types[i]));
+    }
+
+    for (auto & l : levels) {
+        if (!l.empty()) {
+            m_schemas.emplace_back (std::move (l));
+        }
+    }
 }
 
 /******************************************************************************/
@@ -7,6 +7,9 @@
 
 #include "debug.h"
 
+#include "amqp/codec/Decoder.h"
+#include "amqp/descriptors/AMQPDescriptors.h"
+
 #include <memory>
 #include <iostream>
 
@@ -42,11 +45,39 @@ amqp::internal::schema::
 Schema::Schema (
     OrderedTypeNotations<AMQPTypeNotation> types_
 ) : m_types (std::move (types_)) {
+    index();
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::
+Schema::Schema (std::vector<Unparsed> types_) {
+    m_unparsed.reserve (types_.size());
+    m_unparsedDescriptors.reserve (types_.size());
+
+    for (auto & type : types_) {
+        m_unparsedDescriptors.emplace (type.m_descriptor, type.m_name);
+        m_unparsed.emplace (type.m_name, type);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * The maps point at the types where they sit in m_types, adding more can
+ * move them between levels so this is redone whenever we do
+ */
+void
+amqp::internal::schema::
+Schema::index() {
+    m_descriptorToType.clear();
+    m_typeToDescriptor.clear();
+
     for (auto i { m_types.begin() } ; i != m_types.end() ; ++i) {
         for (auto & j : *i) {
             DBG ("Schema: " << j->descriptor() << " " << j->name() << std::endl); // NOLINT
-            m_descriptorToType.emplace (j->descriptor(), std::ref (j));
-            m_typeToDescriptor.emplace (j->name(), std::ref (j));
+            m_descriptorToType.emplace (j->descriptorId(), std::ref (j));
+            m_typeToDescriptor.emplace (j->id(), std::ref (j));
         }
     }
 }
@@ -64,7 +95,7 @@ Schema::types() const {
 amqp::internal::schema::SchemaMap::const_iterator
 amqp::internal::schema::
 Schema::fromType (const std::string & type_) const {
-    return m_typeToDescriptor.find(type_);
+    return fromType (Symbol::find (type_));
 }
 
 /******************************************************************************/
@@ -72,8 +103,99 @@ Schema::fromType (const std::string & type_) const {
 amqp::internal::schema::SchemaMap::const_iterator
 amqp::internal::schema::
 Schema::fromDescriptor (const std::string & descriptor_) const {
+    return fromDescriptor (Symbol::find (descriptor_));
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::SchemaMap::const_iterator
+amqp::internal::schema::
+Schema::fromType (const Symbol & type_) const {
+    return m_typeToDescriptor.find (type_);
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::SchemaMap::const_iterator
+amqp::internal::schema::
+Schema::fromDescriptor (const Symbol & descriptor_) const {
     return m_descriptorToType.find (descriptor_);
 }
 
 /******************************************************************************/
 
+const amqp::internal::schema::AMQPTypeNotation *
+amqp::internal::schema::
+Schema::byType (const Symbol & type_) const {
+    auto it = m_typeToDescriptor.find (type_);
+
+    return (it == m_typeToDescriptor.end()) ? nullptr : it->second.get().get();
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::AMQPTypeNotation *
+amqp::internal::schema::
+Schema::byDescriptor (const Symbol & descriptor_) const {
+    auto it = m_descriptorToType.find (descriptor_);
+
+    return (it == m_descriptorToType.end()) ? nullptr : it->second.get().get();
+}
+
+/******************************************************************************/
+
+
+bool
+amqp::internal::schema::
+Schema::materialise (const Symbol & descriptor_) {
+    auto it = m_unparsedDescriptors.find (descriptor_);
+
+    if (it == m_unparsedDescriptors.end()) {
+        return false;
+    }
+
+    std::vector<Symbol> wanted { it->second };
+    std::vector<Symbol> dependencies;
+
+    while (!wanted.empty()) {
+        auto type = m_unparsed.find (wanted.back());
+        wanted.pop_back();
+
+        // primitives, and anything we've already done, won't be here
+        if (type == m_unparsed.end()) {
+            continue;
+        }
+
+        DBG ("Materialise: " << type->first << std::endl); // NOLINT
+
+        codec::Decoder decoder (
+                type->second.m_encoded.data(),
+                type->second.m_encoded.size());
+
+        auto notation = descriptors::dispatchDescribed<AMQPTypeNotation> (
+                &decoder);
+
+        m_unparsedDescriptors.erase (type->second.m_descriptor);
+        m_unparsed.erase (type);
+
+        dependencies.clear();
+        notation->dependencies (dependencies);
+        wanted.insert (wanted.end(), dependencies.begin(), dependencies.end());
+
+        m_types.insert (std::move (notation));
+    }
+
+    index();
+
+    return true;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::schema::
+Schema::unparsed() const {
+    return m_unparsed.size();
+}
+
+/******************************************************************************/
@@ -4,9 +4,13 @@
 
 #include <set>
 #include <map>
+#include <vector>
 #include <iosfwd>
+#include <string_view>
+#include <unordered_map>
 
 #include "types.h"
+#include "Symbol.h"
 #include "Composite.h"
 #include "Descriptor.h"
 #include "OrderedTypeNotations.h"
@@ -18,12 +22,22 @@
 
 namespace amqp::internal::schema {
 
-    using SchemaMap = std::map<
-            std::string,
+    using SchemaMap = std::unordered_map<
+            Symbol,
             const std::reference_wrapper<const uPtr<AMQPTypeNotation>>>;
 
     using ISchemaType = amqp::schema::ISchema<SchemaMap::const_iterator>;
 
+    /**
+     * A type notation we know the name and descriptor of but haven't
+     * decoded yet, [m_encoded] is the whole of its described encoding
+     */
+    struct Unparsed {
+        Symbol           m_name;
+        Symbol           m_descriptor;
+        std::string_view m_encoded;
+    };
+
     class Schema
             : public amqp::schema::ISchema<SchemaMap::const_iterator>
             , public amqp::AMQPDescribed
@@ -37,14 +51,51 @@ namespace amqp::internal::schema {
             SchemaMap m_descriptorToType;
             SchemaMap m_typeToDescriptor;
 
+            /**
+             * Types left encoded until something needs them, by name,
+             * with the descriptors of the same types pointing at them
+             */
+            std::unordered_map<Symbol, Unparsed> m_unparsed;
+            std::unordered_map<Symbol, Symbol>   m_unparsedDescriptors;
+
+            void index();
+
         public :
             explicit Schema (OrderedTypeNotations<AMQPTypeNotation>);
 
+            /**
+             * A schema with none of its types decoded, they're decoded
+             * by materialise as they're needed. The encodings are views
+             * into a buffer that has to outlive the schema
+             */
+            explicit Schema (std::vector<Unparsed>);
+
             const OrderedTypeNotations<AMQPTypeNotation> & types() const;
 
             SchemaMap::const_iterator fromType (const std::string &) const override;
             SchemaMap::const_iterator fromDescriptor (const std::string &) const override ;
 
+            SchemaMap::const_iterator fromType (const Symbol &) const;
+            SchemaMap::const_iterator fromDescriptor (const Symbol &) const;
+
+            /**
+             * As above but null if there's no such type
+             */
+            const AMQPTypeNotation * byType (const Symbol &) const;
+            const AMQPTypeNotation * byDescriptor (const Symbol &) const;
+
+            /**
+             * Decode the type with [descriptor_] and every type it
+             * depends on that hasn't been decoded already. Returns
+             * false if there was nothing to do.
+             *
+             * Until a type's been materialised the lookups above, and
+             * iterating over the schema, don't see it
+             */
+            bool materialise (const Symbol & descriptor_);
+
+            size_t unparsed() const;
+
             decltype (m_types.begin()) begin() const { return m_types.begin(); }
             decltype (m_types.end()) end() const { return m_types.end(); }
     };
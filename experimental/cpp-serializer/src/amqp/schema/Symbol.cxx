@@ -0,0 +1,153 @@
+#include "Symbol.h"
+
+#include <deque>
+#include <mutex>
+#include <iterator>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Interned in this order so the primitives get ids 1 to
+     * LAST_PRIMITIVE, see Symbol::primitive
+     */
+    const char * const PRIMITIVES[] = {
+        "string", "long", "boolean", "int", "double"
+    };
+
+    constexpr uint32_t LAST_PRIMITIVE = std::size (PRIMITIVES);
+
+    /**
+     * Strings live in a deque so adding more never moves the ones
+     * symbols already point at, the map's keys view into it
+     */
+    class SymbolTable {
+        private :
+            std::deque<std::string> m_strings;
+            std::unordered_map<std::string_view, uint32_t> m_ids;
+
+            mutable std::shared_mutex m_lock;
+
+            uint32_t add (std::string_view str_) {
+                auto id = static_cast<uint32_t> (m_strings.size());
+
+                m_strings.emplace_back (str_);
+                m_ids.emplace (m_strings.back(), id);
+
+                return id;
+            }
+
+        public :
+            /**
+             * The empty string is interned first and never moves so
+             * needs no locking
+             */
+            const std::string * empty() const {
+                return &m_strings.front();
+            }
+
+            SymbolTable() {
+                add ("");
+
+                for (const auto primitive : PRIMITIVES) {
+                    add (primitive);
+                }
+            }
+
+            std::pair<uint32_t, const std::string *>
+            find (std::string_view str_) const {
+                std::shared_lock<std::shared_mutex> lock (m_lock);
+
+                auto it = m_ids.find (str_);
+
+                return (it == m_ids.end())
+                    ? std::make_pair (0U, empty())
+                    : std::make_pair (it->second, &m_strings[it->second]);
+            }
+
+            std::pair<uint32_t, const std::string *>
+            intern (std::string_view str_) {
+                auto found = find (str_);
+
+                if (found.first || str_.empty()) {
+                    return found;
+                }
+
+                std::unique_lock<std::shared_mutex> lock (m_lock);
+
+                // someone may have beaten us to it since we looked
+                auto it = m_ids.find (str_);
+                auto id = (it == m_ids.end()) ? add (str_) : it->second;
+
+                return std::make_pair (id, &m_strings[id]);
+            }
+    };
+
+    SymbolTable &
+    table() {
+        static SymbolTable symbols;
+        return symbols;
+    }
+
+}
+
+/******************************************************************************/
+
+std::ostream &
+amqp::internal::schema::
+operator << (std::ostream & stream_, const Symbol & symbol_) {
+    return stream_ << symbol_.str();
+}
+
+/******************************************************************************
+ *
+ * class Symbol
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::
+Symbol::Symbol (uint32_t id_, const std::string * str_)
+    : m_id (id_)
+    , m_str (str_)
+{
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::
+Symbol::Symbol()
+    : m_id (0)
+    , m_str (table().empty())
+{
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::
+Symbol::Symbol (std::string_view str_) {
+    std::tie (m_id, m_str) = table().intern (str_);
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::Symbol
+amqp::internal::schema::
+Symbol::find (std::string_view str_) {
+    auto found = table().find (str_);
+
+    return { found.first, found.second };
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::schema::
+Symbol::primitive() const {
+    return m_id != 0 && m_id <= LAST_PRIMITIVE;
+}
+
+/******************************************************************************/
@@ -0,0 +1,70 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstdint>
+#include <iosfwd>
+#include <functional>
+#include <string_view>
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * An interned type name or descriptor.
+     *
+     * Each distinct string is stored once, process wide, and given a small
+     * integer id. Comparing and hashing symbols only looks at that id so
+     * the dependency checks we do while ordering a schema, and looking
+     * readers up by type, never have to compare the strings themselves.
+     *
+     * The primitive types are interned up front with the lowest ids, so
+     * checking for one is a range check. A default constructed symbol is
+     * the empty string, which is also what find returns for a string
+     * that's never been interned.
+     */
+    class Symbol {
+        private :
+            uint32_t            m_id;
+            const std::string * m_str;
+
+            Symbol (uint32_t, const std::string *);
+
+        public :
+            Symbol();
+
+            explicit Symbol (std::string_view);
+
+            /**
+             * The symbol for [str_] if it's been interned, otherwise the
+             * empty symbol, without adding it to the table
+             */
+            static Symbol find (std::string_view str_);
+
+            uint32_t id() const { return m_id; }
+            const std::string & str() const { return *m_str; }
+
+            bool empty() const { return m_id == 0; }
+            bool primitive() const;
+
+            bool operator == (const Symbol & rhs_) const { return m_id == rhs_.m_id; }
+            bool operator != (const Symbol & rhs_) const { return m_id != rhs_.m_id; }
+            bool operator <  (const Symbol & rhs_) const { return m_id <  rhs_.m_id; }
+    };
+
+    std::ostream & operator << (std::ostream &, const Symbol &);
+
+}
+
+/******************************************************************************/
+
+template<>
+struct std::hash<amqp::internal::schema::Symbol> {
+    size_t operator () (const amqp::internal::schema::Symbol & symbol_) const {
+        return symbol_.id();
+    }
+};
+
+/******************************************************************************/
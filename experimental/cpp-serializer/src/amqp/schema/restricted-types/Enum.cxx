@@ -22,7 +22,7 @@ Enum::Enum (
         std::move (label_),
         std::move (provides_),
         amqp::internal::schema::Restricted::RestrictedTypes::Enum)
-    , m_enum { name_ }
+    , m_enum { id() }
     , m_choices (std::move (choices_))
 {
 
@@ -30,7 +30,7 @@ Enum::Enum (
 
 /******************************************************************************/
 
-std::vector<std::string>::const_iterator
+std::vector<amqp::internal::schema::Symbol>::const_iterator
 amqp::internal::schema::
 Enum::begin() const {
     return m_enum.begin();
@@ -38,7 +38,7 @@ Enum::begin() const {
 
 /******************************************************************************/
 
-std::vector<std::string>::const_iterator
+std::vector<amqp::internal::schema::Symbol>::const_iterator
 amqp::internal::schema::
 Enum::end() const {
     return m_enum.end();
@@ -46,59 +46,12 @@ Enum::end() const {
 
 /******************************************************************************/
 
-int
+/**
+ * The constants are all we need, they're just strings
+ */
+void
 amqp::internal::schema::
-Enum::dependsOn (const amqp::internal::schema::Restricted & lhs_) const {
-    auto rtn { 0 };
-    switch (lhs_.restrictedType()) {
-        case RestrictedTypes::List : {
-            const auto & list { dynamic_cast<const class List &>(lhs_) };
-
-            // does the left hand side depend on us
-          //  DBG ("  L/L a) " << list.listOf() << " == " << name() << std::endl); // NOLINT
-            if (list.listOf() == name()) {
-                rtn = 1;
-            }
-
-            // do we depend on the lhs
-            //DBG ("  L/L b) " << name() << " == " << list.name() << std::endl); // NOLINT
-            if (name() == list.name()) {
-                rtn = 2;
-            }
-
-            break;
-        }
-        case RestrictedTypes::Enum : {
-            break;
-        }
-        case RestrictedTypes::Map : {
-
-        }
-
-    }
-
-    return rtn;
-}
-
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-Enum::dependsOn (const amqp::internal::schema::Composite & lhs_) const {
-    auto rtn { 0 };
-    for (const auto & field : lhs_.fields()) {
-//        DBG ("  L/C a) " << field->resolvedType() << " == " << name() << std::endl); // NOLINT
-        if (field->resolvedType() == name()) {
-            rtn = 1;
-        }
-    }
-
-  //  DBG ("  L/C b) " << name() << " == " << lhs_.name() << std::endl); // NOLINT
-    if (name() == lhs_.name()) {
-        rtn = 2;
-    }
-
-    return rtn;
+Enum::dependencies (std::vector<Symbol> &) const {
 }
 
 /*********************************************************o*********************/
@@ -116,4 +69,12 @@ Enum::makeChoices() const {
     return rtn;
 }
 
+/******************************************************************************/
+
+const std::vector<uPtr<amqp::internal::schema::Choice>> &
+amqp::internal::schema::
+Enum::choices() const {
+    return m_choices;
+}
+
 /*********************************************************o*********************/
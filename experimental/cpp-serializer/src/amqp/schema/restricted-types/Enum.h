@@ -6,7 +6,7 @@ namespace amqp::internal::schema {
 
     class Enum : public Restricted {
         private :
-            std::vector<std::string> m_enum;
+            std::vector<Symbol> m_enum;
             std::vector<uPtr<Choice>> m_choices;
 
         public :
@@ -18,13 +18,17 @@ namespace amqp::internal::schema {
                 std::string,
                 std::vector<uPtr<Choice>>);
 
-            std::vector<std::string>::const_iterator begin() const override;
-            std::vector<std::string>::const_iterator end() const override;
+            std::vector<Symbol>::const_iterator begin() const override;
+            std::vector<Symbol>::const_iterator end() const override;
 
-            int dependsOn (const Restricted &) const override;
-            int dependsOn (const class Composite &) const override;
+            void dependencies (std::vector<Symbol> &) const override;
 
             std::vector<std::string> makeChoices() const;
+
+            /**
+             * In ordinal order
+             */
+            const std::vector<uPtr<Choice>> & choices() const;
     };
 
 }
@@ -36,14 +36,14 @@ List::List (
         std::move (label_),
         std::move (provides_),
         amqp::internal::schema::Restricted::RestrictedTypes::List)
-  , m_listOf { listType(name_).second }
+  , m_listOf { Symbol (listType (name()).second) }
 {
 
 }
 
 /******************************************************************************/
 
-std::vector<std::string>::const_iterator
+std::vector<amqp::internal::schema::Symbol>::const_iterator
 amqp::internal::schema::
 List::begin() const {
     return m_listOf.begin();
@@ -51,7 +51,7 @@ List::begin() const {
 
 /******************************************************************************/
 
-std::vector<std::string>::const_iterator
+std::vector<amqp::internal::schema::Symbol>::const_iterator
 amqp::internal::schema::
 List::end() const {
     return m_listOf.end();
@@ -62,55 +62,23 @@ List::end() const {
 const std::string &
 amqp::internal::schema::
 List::listOf() const {
-    return m_listOf[0];
+    return m_listOf[0].str();
 }
 
 /******************************************************************************/
 
-int
+const amqp::internal::schema::Symbol &
 amqp::internal::schema::
-List::dependsOn (const amqp::internal::schema::Restricted & lhs_) const {
-    auto rtn { 0 };
-    switch (lhs_.restrictedType()) {
-        case RestrictedTypes::List : {
-            const auto & list { dynamic_cast<const List &>(lhs_) };
-
-            // does the left hand side depend on us
-            DBG ("  L/L a) " << list.listOf() << " == " << name() << std::endl); // NOLINT
-            if (list.listOf() == name()) {
-                rtn = 1;
-            }
-
-            // do we depend on the lhs
-            DBG ("  L/L b) " << listOf() << " == " << list.name() << std::endl); // NOLINT
-            if (listOf() == list.name()) {
-                rtn = 2;
-            }
-        }
-    }
-
-    return rtn;
+List::listOfId() const {
+    return m_listOf[0];
 }
 
 /******************************************************************************/
 
-int
+void
 amqp::internal::schema::
-List::dependsOn (const amqp::internal::schema::Composite & lhs_) const {
-    auto rtn { 0 };
-    for (const auto & field : lhs_.fields()) {
-        DBG ("  L/C a) " << field->resolvedType() << " == " << name() << std::endl); // NOLINT
-        if (field->resolvedType() == name()) {
-            rtn = 1;
-        }
-    }
-
-    DBG ("  L/C b) " << listOf() << " == " << lhs_.name() << std::endl); // NOLINT
-    if (listOf() == lhs_.name()) {
-        rtn = 2;
-    }
-
-    return rtn;
+List::dependencies (std::vector<Symbol> & dependencies_) const {
+    dependencies_.push_back (listOfId());
 }
 
 /*********************************************************o*********************/
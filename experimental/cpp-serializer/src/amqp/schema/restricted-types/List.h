@@ -8,7 +8,7 @@ namespace amqp::internal::schema {
 
     class List : public Restricted {
         private :
-            std::vector<std::string> m_listOf;
+            std::vector<Symbol> m_listOf;
 
         public :
             List (
@@ -18,13 +18,13 @@ namespace amqp::internal::schema {
                 std::vector<std::string>,
                 std::string);
 
-            std::vector<std::string>::const_iterator begin() const override;
-            std::vector<std::string>::const_iterator end() const override;
+            std::vector<Symbol>::const_iterator begin() const override;
+            std::vector<Symbol>::const_iterator end() const override;
 
             const std::string & listOf() const;
+            const Symbol & listOfId() const;
 
-            int dependsOn (const Restricted &) const override;
-            int dependsOn (const class Composite &) const override;
+            void dependencies (std::vector<Symbol> &) const override;
     };
 
 }
@@ -0,0 +1,139 @@
+#include "Map.h"
+
+#include <stdexcept>
+
+#include "debug.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    trim (const std::string & str_) {
+        auto first = str_.find_first_not_of (' ');
+        auto last = str_.find_last_not_of (' ');
+
+        return (first == std::string::npos)
+            ? std::string { }
+            : str_.substr (first, last - first + 1);
+    }
+
+    /**
+     * Split "java.util.Map<K, V>" into K and V, either of which could be
+     * generic themselves so it's the first comma not inside any further
+     * angle brackets we want
+     */
+    std::pair<std::string, std::string>
+    mapType (const std::string & map_) {
+        auto open = map_.find ('<');
+        auto close = map_.rfind ('>');
+
+        if (open == std::string::npos || close == std::string::npos || close < open) {
+            throw std::runtime_error ("Bad map type " + map_);
+        }
+
+        int depth { 0 };
+
+        for (auto i { open + 1 } ; i < close ; ++i) {
+            switch (map_[i]) {
+                case '<' : ++depth; break;
+                case '>' : --depth; break;
+                case ',' : {
+                    if (!depth) {
+                        return std::make_pair (
+                                trim (map_.substr (open + 1, i - open - 1)),
+                                trim (map_.substr (i + 1, close - i - 1)));
+                    }
+                    break;
+                }
+                default : break;
+            }
+        }
+
+        throw std::runtime_error ("Bad map type " + map_);
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::
+Map::Map (
+    uPtr<Descriptor> descriptor_,
+    std::string name_,
+    std::string label_,
+    std::vector<std::string> provides_,
+    std::string source_
+) : Restricted (
+        std::move (descriptor_),
+        std::move (name_),
+        std::move (label_),
+        std::move (provides_),
+        amqp::internal::schema::Restricted::RestrictedTypes::Map)
+{
+    auto types = mapType (name());
+
+    DBG ("Map: " << types.first << " -> " << types.second << std::endl); // NOLINT
+
+    m_mapOf.emplace_back (types.first);
+    m_mapOf.emplace_back (types.second);
+}
+
+/******************************************************************************/
+
+std::vector<amqp::internal::schema::Symbol>::const_iterator
+amqp::internal::schema::
+Map::begin() const {
+    return m_mapOf.begin();
+}
+
+/******************************************************************************/
+
+std::vector<amqp::internal::schema::Symbol>::const_iterator
+amqp::internal::schema::
+Map::end() const {
+    return m_mapOf.end();
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+Map::keyType() const {
+    return m_mapOf[0].str();
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Symbol &
+amqp::internal::schema::
+Map::keyTypeId() const {
+    return m_mapOf[0];
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+Map::valueType() const {
+    return m_mapOf[1].str();
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Symbol &
+amqp::internal::schema::
+Map::valueTypeId() const {
+    return m_mapOf[1];
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::schema::
+Map::dependencies (std::vector<Symbol> & dependencies_) const {
+    dependencies_.push_back (keyTypeId());
+    dependencies_.push_back (valueTypeId());
+}
+
+/******************************************************************************/
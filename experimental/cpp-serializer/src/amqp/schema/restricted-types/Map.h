@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Restricted.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    class Map : public Restricted {
+        private :
+            /**
+             * The key then the value type
+             */
+            std::vector<Symbol> m_mapOf;
+
+        public :
+            Map (
+                uPtr<Descriptor> descriptor_,
+                std::string,
+                std::string,
+                std::vector<std::string>,
+                std::string);
+
+            std::vector<Symbol>::const_iterator begin() const override;
+            std::vector<Symbol>::const_iterator end() const override;
+
+            const std::string & keyType() const;
+            const Symbol & keyTypeId() const;
+
+            const std::string & valueType() const;
+            const Symbol & valueTypeId() const;
+
+            void dependencies (std::vector<Symbol> &) const override;
+    };
+
+}
+
+/******************************************************************************/
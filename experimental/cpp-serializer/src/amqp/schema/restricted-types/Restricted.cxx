@@ -1,6 +1,7 @@
 #include "Restricted.h"
 #include "List.h"
 #include "Enum.h"
+#include "Map.h"
 
 #include <string>
 #include <vector>
@@ -111,8 +112,15 @@ Restricted::make(
                     std::move (choices_));
         }
     } else if (source_ == "map") {
-        throw std::runtime_error ("maps not supported");
+        return std::make_unique<amqp::internal::schema::Map>(
+                std::move (descriptor_),
+                std::move (name_),
+                std::move (label_),
+                std::move (provides_),
+                std::move (source_));
     }
+
+    throw std::runtime_error ("Unknown restricted type source " + source_);
 }
 
 /******************************************************************************/
@@ -151,11 +159,18 @@ Restricted::restrictedType() const {
 
 /******************************************************************************/
 
-int
+const std::string &
 amqp::internal::schema::
-Restricted::dependsOn (const OrderedTypeNotation & rhs_) const {
-    return dynamic_cast<const AMQPTypeNotation &>(rhs_).dependsOn(*this);
+Restricted::label() const {
+    return m_label;
 }
 
-/*********************************************************o*********************/
+/******************************************************************************/
+
+const std::vector<std::string> &
+amqp::internal::schema::
+Restricted::provides() const {
+    return m_provides;
+}
 
+/******************************************************************************/
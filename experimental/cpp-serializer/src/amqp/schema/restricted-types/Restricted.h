@@ -80,17 +80,18 @@ namespace amqp::internal::schema {
 
             RestrictedTypes restrictedType() const;
 
+            const std::string & label() const;
+            const std::vector<std::string> & provides() const;
+
             /**
              * @return an iterator over the types the restricted class represents.
              * In the case of a list, the element this is a list of, in the
              * case of a map the key and value types etc.
              */
-            virtual std::vector<std::string>::const_iterator begin() const = 0;
-            virtual std::vector<std::string>::const_iterator end() const = 0;
+            virtual std::vector<Symbol>::const_iterator begin() const = 0;
+            virtual std::vector<Symbol>::const_iterator end() const = 0;
 
-            int dependsOn (const OrderedTypeNotation &) const override;
-            int dependsOn (const Restricted &) const override = 0;
-            int dependsOn (const class Composite &) const override = 0;
+            void dependencies (std::vector<Symbol> &) const override = 0;
     };
 
 
@@ -0,0 +1,496 @@
+#include "Stats.h"
+
+#include <new>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::stats;
+
+    using Clock = std::chrono::steady_clock;
+
+    const char * const PHASES[] = {
+        "read", "inflate", "lookup", "schema", "order",
+        "factory", "compile", "decode", "dump"
+    };
+
+    const char * const COUNTERS[] = {
+        "blobs", "bytes", "objects", "fields", "elements", "entries", "values"
+    };
+
+    const char * const READERS[] = {
+        "composite", "list", "map", "enum", "int", "long", "double", "bool", "string"
+    };
+
+    static_assert (sizeof (PHASES) / sizeof (PHASES[0]) == Phases);
+    static_assert (sizeof (COUNTERS) / sizeof (COUNTERS[0]) == Counters);
+    static_assert (sizeof (READERS) / sizeof (READERS[0]) == ReaderTypes);
+
+    /**
+     * What's being recorded into on this thread and since when, Phases
+     * when no Timer is running and ReaderTypes when no reader is
+     */
+    struct Recording {
+        Stats *           m_stats { nullptr };
+        Phase             m_phase { Phases };
+        ReaderType        m_reader { ReaderTypes };
+        Clock::time_point m_since;
+    };
+
+    thread_local Recording recording;
+
+    /**
+     * Charge the time since the last change to the phase we've been in
+     */
+    void
+    charge (Clock::time_point now_) {
+        if (recording.m_phase != Phases) {
+            recording.m_stats->charge (
+                    recording.m_phase,
+                    std::chrono::duration_cast<std::chrono::nanoseconds> (
+                            now_ - recording.m_since).count());
+        }
+
+        recording.m_since = now_;
+    }
+
+    /**
+     * "name=count:bytesB" for each that allocated anything, the last
+     * being named [other_]
+     */
+    void
+    writeAllocations (
+        std::ostream & out_,
+        const char * what_,
+        const char * const * names_,
+        const Allocations * allocations_,
+        int size_
+    ) {
+        bool any { false };
+
+        for (int i { 0 } ; i <= size_ ; ++i) {
+            if (allocations_[i].m_count) {
+                out_ << (any ? " " : what_)
+                     << (i < size_ ? names_[i] : "other") << '='
+                     << allocations_[i].m_count << ':'
+                     << allocations_[i].m_bytes << 'B';
+                any = true;
+            }
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+const char *
+amqp::internal::stats::
+name (Phase phase_) {
+    return PHASES[phase_];
+}
+
+/******************************************************************************/
+
+const char *
+amqp::internal::stats::
+name (Counter counter_) {
+    return COUNTERS[counter_];
+}
+
+/******************************************************************************/
+
+const char *
+amqp::internal::stats::
+name (ReaderType type_) {
+    return READERS[type_];
+}
+
+/******************************************************************************/
+
+amqp::internal::stats::Stats *
+amqp::internal::stats::
+current() {
+    return recording.m_stats;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::stats::Stats
+ *
+ ******************************************************************************/
+
+amqp::internal::stats::
+Stats::Stats()
+    : m_nanos { }
+    , m_counts { }
+    , m_phaseAllocations { }
+    , m_readerAllocations { }
+{
+}
+
+/******************************************************************************/
+
+amqp::internal::stats::Stats &
+amqp::internal::stats::
+Stats::operator += (const Stats & other_) {
+    for (int i { 0 } ; i < Phases ; ++i) {
+        m_nanos[i] += other_.m_nanos[i];
+    }
+
+    for (int i { 0 } ; i < Counters ; ++i) {
+        m_counts[i] += other_.m_counts[i];
+    }
+
+    for (int i { 0 } ; i <= Phases ; ++i) {
+        m_phaseAllocations[i].m_count += other_.m_phaseAllocations[i].m_count;
+        m_phaseAllocations[i].m_bytes += other_.m_phaseAllocations[i].m_bytes;
+    }
+
+    for (int i { 0 } ; i <= ReaderTypes ; ++i) {
+        m_readerAllocations[i].m_count += other_.m_readerAllocations[i].m_count;
+        m_readerAllocations[i].m_bytes += other_.m_readerAllocations[i].m_bytes;
+    }
+
+    return *this;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+Stats::allocated (Phase phase_, ReaderType type_, size_t bytes_) {
+    ++m_phaseAllocations[phase_].m_count;
+    m_phaseAllocations[phase_].m_bytes += bytes_;
+
+    ++m_readerAllocations[type_].m_count;
+    m_readerAllocations[type_].m_bytes += bytes_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+Stats::write (std::ostream & out_, const std::string & name_) const {
+    uint64_t total { 0 };
+
+    out_ << "stats " << name_ << std::fixed << std::setprecision (1);
+
+    for (int i { 0 } ; i < Phases ; ++i) {
+        if (m_nanos[i]) {
+            out_ << ' ' << PHASES[i] << '=' << m_nanos[i] / 1000.0 << "us";
+            total += m_nanos[i];
+        }
+    }
+
+    out_ << " total=" << total / 1000.0 << "us";
+
+    for (int i { 0 } ; i < Counters ; ++i) {
+        if (m_counts[i]) {
+            out_ << ' ' << COUNTERS[i] << '=' << m_counts[i];
+        }
+    }
+
+    writeAllocations (out_, " | allocs ", PHASES, m_phaseAllocations, Phases);
+    writeAllocations (out_, " | readers ", READERS, m_readerAllocations, ReaderTypes);
+
+    out_ << std::defaultfloat << '\n';
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::stats::Scope
+ *
+ ******************************************************************************/
+
+amqp::internal::stats::
+Scope::Scope (Stats & stats_) : m_previous (recording.m_stats) {
+    charge (Clock::now());
+    recording.m_stats = &stats_;
+}
+
+/******************************************************************************/
+
+amqp::internal::stats::
+Scope::~Scope() {
+    charge (Clock::now());
+    recording.m_stats = m_previous;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::stats::Timer
+ *
+ ******************************************************************************/
+
+amqp::internal::stats::
+Timer::Timer (Phase phase_)
+    : m_active (recording.m_stats != nullptr)
+    , m_previous (recording.m_phase)
+{
+    if (m_active) {
+        charge (Clock::now());
+        recording.m_phase = phase_;
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::stats::
+Timer::~Timer() {
+    if (m_active) {
+        charge (Clock::now());
+        recording.m_phase = m_previous;
+    }
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::stats::ReaderScope
+ *
+ ******************************************************************************/
+
+amqp::internal::stats::
+ReaderScope::ReaderScope (ReaderType type_) : m_previous (recording.m_reader) {
+    recording.m_reader = type_;
+}
+
+/******************************************************************************/
+
+amqp::internal::stats::
+ReaderScope::~ReaderScope() {
+    recording.m_reader = m_previous;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::stats::CountingVisitor
+ *
+ ******************************************************************************/
+
+amqp::internal::stats::
+CountingVisitor::CountingVisitor (amqp::reader::IVisitor & visitor_, Stats & stats_)
+    : m_visitor (visitor_)
+    , m_stats (stats_)
+{
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+CountingVisitor::beginComposite (const std::string & type_) {
+    m_stats.add (Objects);
+    m_visitor.beginComposite (type_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+CountingVisitor::endComposite() {
+    m_visitor.endComposite();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+CountingVisitor::beginList (const std::string & type_, size_t size_) {
+    m_stats.add (Elements, size_);
+    m_visitor.beginList (type_, size_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+CountingVisitor::endList() {
+    m_visitor.endList();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+CountingVisitor::beginMap (const std::string & type_, size_t size_) {
+    m_stats.add (Entries, size_);
+    m_visitor.beginMap (type_, size_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+CountingVisitor::endMap() {
+    m_visitor.endMap();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+CountingVisitor::field (const std::string & name_) {
+    m_stats.add (Fields);
+    m_visitor.field (name_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+CountingVisitor::onInt (int32_t value_) {
+    m_stats.add (Values);
+    m_visitor.onInt (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+CountingVisitor::onLong (int64_t value_) {
+    m_stats.add (Values);
+    m_visitor.onLong (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+CountingVisitor::onDouble (double value_) {
+    m_stats.add (Values);
+    m_visitor.onDouble (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+CountingVisitor::onBool (bool value_) {
+    m_stats.add (Values);
+    m_visitor.onBool (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+CountingVisitor::onString (std::string_view value_) {
+    m_stats.add (Values);
+    m_visitor.onString (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stats::
+CountingVisitor::onEnum (std::string_view value_) {
+    m_stats.add (Values);
+    m_visitor.onEnum (value_);
+}
+
+/******************************************************************************/
+
+#ifdef AMQP_ALLOC_STATS
+
+/******************************************************************************
+ *
+ * The global allocator, counting on the way through when a Stats is
+ * installed. Every form is replaced, plain, array, nothrow and aligned,
+ * so nothing gets past the count and everything is freed the same way.
+ *
+ ******************************************************************************/
+
+namespace {
+
+    void *
+    allocate (std::size_t size_, std::size_t alignment_) noexcept {
+        if (recording.m_stats) {
+            recording.m_stats->allocated (recording.m_phase, recording.m_reader, size_);
+        }
+
+        if (!size_) {
+            size_ = 1;
+        }
+
+        if (alignment_ <= alignof (std::max_align_t)) {
+            return std::malloc (size_);
+        }
+
+        // aligned_alloc wants a multiple of the alignment
+        return std::aligned_alloc (alignment_, (size_ + alignment_ - 1) & ~(alignment_ - 1));
+    }
+
+    void *
+    allocateOrThrow (std::size_t size_, std::size_t alignment_) {
+        if (void * p = allocate (size_, alignment_)) {
+            return p;
+        }
+
+        throw std::bad_alloc();
+    }
+
+}
+
+/******************************************************************************/
+
+void * operator new (std::size_t size_) {
+    return allocateOrThrow (size_, 0);
+}
+
+void * operator new[] (std::size_t size_) {
+    return allocateOrThrow (size_, 0);
+}
+
+void * operator new (std::size_t size_, std::align_val_t al_) {
+    return allocateOrThrow (size_, static_cast<std::size_t> (al_));
+}
+
+void * operator new[] (std::size_t size_, std::align_val_t al_) {
+    return allocateOrThrow (size_, static_cast<std::size_t> (al_));
+}
+
+void * operator new (std::size_t size_, const std::nothrow_t &) noexcept {
+    return allocate (size_, 0);
+}
+
+void * operator new[] (std::size_t size_, const std::nothrow_t &) noexcept {
+    return allocate (size_, 0);
+}
+
+void * operator new (std::size_t size_, std::align_val_t al_, const std::nothrow_t &) noexcept {
+    return allocate (size_, static_cast<std::size_t> (al_));
+}
+
+void * operator new[] (std::size_t size_, std::align_val_t al_, const std::nothrow_t &) noexcept {
+    return allocate (size_, static_cast<std::size_t> (al_));
+}
+
+/******************************************************************************/
+
+void operator delete (void * p_) noexcept { std::free (p_); }
+void operator delete[] (void * p_) noexcept { std::free (p_); }
+
+void operator delete (void * p_, std::size_t) noexcept { std::free (p_); }
+void operator delete[] (void * p_, std::size_t) noexcept { std::free (p_); }
+
+void operator delete (void * p_, std::align_val_t) noexcept { std::free (p_); }
+void operator delete[] (void * p_, std::align_val_t) noexcept { std::free (p_); }
+
+void operator delete (void * p_, std::size_t, std::align_val_t) noexcept { std::free (p_); }
+void operator delete[] (void * p_, std::size_t, std::align_val_t) noexcept { std::free (p_); }
+
+void operator delete (void * p_, const std::nothrow_t &) noexcept { std::free (p_); }
+void operator delete[] (void * p_, const std::nothrow_t &) noexcept { std::free (p_); }
+
+void operator delete (void * p_, std::align_val_t, const std::nothrow_t &) noexcept { std::free (p_); }
+void operator delete[] (void * p_, std::align_val_t, const std::nothrow_t &) noexcept { std::free (p_); }
+
+/******************************************************************************/
+
+#endif
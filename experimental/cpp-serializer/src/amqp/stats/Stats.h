@@ -0,0 +1,178 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+#include "amqp/reader/IVisitor.h"
+#include "amqp/stats/Timer.h"
+
+/******************************************************************************/
+
+/**
+ * Where the time goes decoding a blob, and how much of it there was.
+ *
+ * Stats are gathered per thread. Nothing is recorded until a Scope
+ * installs a Stats for the thread to record into, and until then a
+ * Timer costs a thread local lookup and a branch, so they can be left
+ * around the phases of the decode path for good.
+ *
+ * Time is charged to whichever phase is innermost, a Timer for schema
+ * decoding that orders the types it's decoded stops being charged while
+ * the ordering runs, so the phases add up to the time they cover.
+ *
+ * Built with AMQP_ALLOC_STATS every allocation made while recording is
+ * counted too, against the phase it was made in and the innermost type
+ * of reader making it, see AMQP_ALLOC_READER. That replaces the global
+ * operator new so it's off unless asked for.
+ */
+namespace amqp::internal::stats {
+
+    enum Counter {
+        Blobs,
+        Bytes,      // decoded, after any inflating
+        Objects,    // composites
+        Fields,
+        Elements,   // of lists
+        Entries,    // of maps
+        Values,
+        Counters
+    };
+
+    /**
+     * The readers allocations are charged to
+     */
+    enum ReaderType {
+        Composite, List, Map, Enum, Int, Long, Double, Bool, String,
+        ReaderTypes
+    };
+
+    const char * name (Counter);
+    const char * name (ReaderType);
+
+    /**
+     * How many allocations and how many bytes they asked for
+     */
+    struct Allocations {
+        uint64_t m_count;
+        uint64_t m_bytes;
+    };
+
+    class Stats {
+        private :
+            uint64_t m_nanos[Phases];
+            uint64_t m_counts[Counters];
+
+            /**
+             * The last of each is for allocations made outside of any
+             * phase or reader
+             */
+            Allocations m_phaseAllocations[Phases + 1];
+            Allocations m_readerAllocations[ReaderTypes + 1];
+
+        public :
+            Stats();
+
+            void charge (Phase phase_, uint64_t nanos_) { m_nanos[phase_] += nanos_; }
+            void add (Counter counter_, uint64_t n_ = 1) { m_counts[counter_] += n_; }
+
+            uint64_t nanos (Phase phase_) const { return m_nanos[phase_]; }
+            uint64_t count (Counter counter_) const { return m_counts[counter_]; }
+
+            void allocated (Phase, ReaderType, size_t bytes_);
+
+            const Allocations & allocations (Phase phase_) const { return m_phaseAllocations[phase_]; }
+            const Allocations & allocations (ReaderType type_) const { return m_readerAllocations[type_]; }
+
+            Stats & operator += (const Stats &);
+
+            /**
+             * One line, the time spent in each phase we spent any in
+             * followed by the counters that aren't zero and then any
+             * allocations by phase and by reader
+             */
+            void write (std::ostream &, const std::string & name_) const;
+    };
+
+    /**
+     * Records whatever is decoded on this thread while it's alive into
+     * [stats_], putting back what was being recorded before
+     */
+    class Scope {
+        private :
+            Stats * m_previous;
+
+        public :
+            explicit Scope (Stats & stats_);
+            ~Scope();
+
+            Scope (const Scope &) = delete;
+            Scope & operator = (const Scope &) = delete;
+    };
+
+    /**
+     * Charges allocations made while it's alive to [type_], nested
+     * ReaderScopes taking over until they end
+     */
+    class ReaderScope {
+        private :
+            ReaderType m_previous;
+
+        public :
+            explicit ReaderScope (ReaderType type_);
+            ~ReaderScope();
+
+            ReaderScope (const ReaderScope &) = delete;
+            ReaderScope & operator = (const ReaderScope &) = delete;
+    };
+
+    /**
+     * What's being recorded into on this thread, if anything
+     */
+    Stats * current();
+
+    /**
+     * Counts what passes through it on the way to another visitor
+     */
+    class CountingVisitor : public amqp::reader::IVisitor {
+        private :
+            amqp::reader::IVisitor & m_visitor;
+            Stats &                  m_stats;
+
+        public :
+            CountingVisitor (amqp::reader::IVisitor &, Stats &);
+
+            void beginComposite (const std::string &) override;
+            void endComposite() override;
+            void beginList (const std::string &, size_t) override;
+            void endList() override;
+            void beginMap (const std::string &, size_t) override;
+            void endMap() override;
+            void field (const std::string &) override;
+
+            void onInt (int32_t) override;
+            void onLong (int64_t) override;
+            void onDouble (double) override;
+            void onBool (bool) override;
+            void onString (std::string_view) override;
+            void onEnum (std::string_view) override;
+    };
+
+}
+
+/******************************************************************************/
+
+/**
+ * Put at the top of a reader's dump and visit, costs nothing unless
+ * we're counting allocations
+ */
+#ifdef AMQP_ALLOC_STATS
+    #define AMQP_ALLOC_READER(X) amqp::internal::stats::ReaderScope allocReader (X)
+#else
+    #define AMQP_ALLOC_READER(X)
+#endif
+
+/******************************************************************************/
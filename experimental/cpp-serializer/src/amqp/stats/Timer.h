@@ -0,0 +1,46 @@
+#pragma once
+
+/******************************************************************************/
+
+/**
+ * The phases of decoding time is charged to and the Timer charging it,
+ * apart from the rest of stats::Stats so the schema layer can time
+ * itself without knowing about visitors, see Stats.h
+ */
+namespace amqp::internal::stats {
+
+    enum Phase {
+        Read,       // the blob's file
+        Inflate,    // undoing any compression
+        Lookup,     // finding the schema in the cache
+        Schema,     // decoding the schema's descriptors
+        Order,      // ordering the schema's types by their dependencies
+        Factory,    // building readers for the types
+        Compile,    // compiling readers into a decode plan
+        Decode,     // reading the object
+        Dump,       // the schema-dumper's walk
+        Phases
+    };
+
+    const char * name (Phase);
+
+    /**
+     * Charges the time it's alive to [phase_], nested Timers taking
+     * over until they end
+     */
+    class Timer {
+        private :
+            bool  m_active;
+            Phase m_previous;
+
+        public :
+            explicit Timer (Phase phase_);
+            ~Timer();
+
+            Timer (const Timer &) = delete;
+            Timer & operator = (const Timer &) = delete;
+    };
+
+}
+
+/******************************************************************************/
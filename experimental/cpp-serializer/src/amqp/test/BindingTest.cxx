@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "Fixture.h"
+#include "SchemaCache.h"
+
+#include "amqp/bind/Binding.h"
+#include "amqp/codec/Encoder.h"
+#include "amqp/descriptors/AMQPDescriptorRegistory.h"
+#include "serialiser/Serialiser.h"
+
+using namespace amqp::internal;
+
+using amqp::test::Fixture;
+
+/******************************************************************************/
+
+namespace {
+
+    struct Things { std::string things; };
+    struct Wibble { int64_t wibble; bool wibbled; };
+    struct Pair { Things a1; Things a2; int32_t aCount; };
+
+    struct ManyTypes {
+        Things a;
+        std::string b;
+        Wibble c;
+        Pair e;
+        double f;
+    };
+
+    // only some of the fields
+    struct Some { std::string d; double f; };
+
+    struct AB { int32_t a; int32_t b; };
+    struct ListOfComposites { std::vector<AB> a; };
+
+    struct Listy { std::vector<std::string> listy; };
+    struct StringLists { std::vector<std::vector<std::string>> a; };
+    struct IntToString { std::map<int32_t, std::string> a; };
+
+    // only a Pair, anything before it being skipped
+    struct Later { Pair e; };
+
+    struct Wrong { int32_t f; };
+    struct Missing { int32_t zz; };
+
+}
+
+AMQP_BIND (Things, AMQP_FIELD (Things, things));
+AMQP_BIND (Wibble, AMQP_FIELD (Wibble, wibble), AMQP_FIELD (Wibble, wibbled));
+AMQP_BIND (Pair, AMQP_FIELD (Pair, a1), AMQP_FIELD (Pair, a2), AMQP_FIELD (Pair, aCount));
+
+AMQP_BIND (ManyTypes,
+    AMQP_FIELD (ManyTypes, a),
+    AMQP_FIELD (ManyTypes, b),
+    AMQP_FIELD (ManyTypes, c),
+    AMQP_FIELD (ManyTypes, e),
+    AMQP_FIELD (ManyTypes, f));
+
+AMQP_BIND (Some, AMQP_FIELD (Some, f), AMQP_FIELD (Some, d));
+
+AMQP_BIND (AB, AMQP_FIELD (AB, a), AMQP_FIELD (AB, b));
+AMQP_BIND (ListOfComposites, AMQP_FIELD (ListOfComposites, a));
+
+AMQP_BIND (Listy, AMQP_FIELD (Listy, listy));
+AMQP_BIND (StringLists, AMQP_FIELD (StringLists, a));
+AMQP_BIND (IntToString, AMQP_FIELD (IntToString, a));
+
+AMQP_BIND (Later, AMQP_FIELD (Later, e));
+
+AMQP_BIND (Wrong, AMQP_FIELD (Wrong, f));
+AMQP_BIND (Missing, AMQP_FIELD (Missing, zz));
+
+/******************************************************************************/
+
+namespace {
+
+    template<typename T>
+    T
+    decode (Fixture & fixture_) {
+        SchemaCache cache (SchemaCache::Materialise::Reachable);
+
+        return fixture_.read (cache, [] (auto d_, const auto & entry_, const auto & descriptor_) {
+            return bind::Binding<T> (entry_, descriptor_).read (d_);
+        });
+    }
+
+    template<typename T>
+    T
+    decode (const char * blob_, size_t size_) {
+        Fixture fixture (blob_, size_);
+        return decode<T> (fixture);
+    }
+
+    template<typename T>
+    T
+    decode (const std::string & name_) {
+        Fixture fixture (name_);
+        return decode<T> (fixture);
+    }
+
+    void
+    things (amqp::codec::Encoder & encoder_, std::string_view things_) {
+        encoder_.described();
+        encoder_.putSymbol ("net.corda:whOur9MMEGxrXhJCcQDNGg==");
+        encoder_.beginList();
+        encoder_.putString (things_);
+        encoder_.endList();
+    }
+
+    /**
+     * manyTypes again but with e.a2 a reference back to a, the first
+     * object in the blob
+     */
+    std::vector<char>
+    referencing() {
+        SchemaCache cache;
+        std::string descriptor;
+        amqp::serialiser::Serialiser serialiser (Fixture ("manyTypes").lookup (cache, descriptor));
+
+        std::vector<char> rtn;
+        serialiser.write (descriptor, rtn, [&] (amqp::codec::Encoder & encoder_) {
+            encoder_.described();
+            encoder_.putSymbol (descriptor);
+            encoder_.beginList();
+
+            things (encoder_, "this");
+            encoder_.putString ("is");
+
+            encoder_.described();
+            encoder_.putSymbol ("net.corda:j51xhauFDZ37If6kCXjXng==");
+            encoder_.beginList();
+            encoder_.putLong (2);
+            encoder_.putBool (false);
+            encoder_.endList();
+
+            encoder_.putString ("a");
+
+            encoder_.described();
+            encoder_.putSymbol ("net.corda:wSjDsbBzX1tMy1MxP1rCbQ==");
+            encoder_.beginList();
+            things (encoder_, "test");
+
+            // a small uint of 0, the index of a
+            encoder_.described();
+            encoder_.putULong (DESCRIPTOR_TOP_32BITS | REFERENCED_OBJECT);
+            encoder_.putRaw (std::string_view ("\x52\x00", 2));
+
+            encoder_.putInt (2);
+            encoder_.endList();
+
+            encoder_.putDouble (100.0);
+            encoder_.endList();
+        });
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Binding, composites) { // NOLINT
+    auto many = decode<ManyTypes> ("manyTypes");
+
+    EXPECT_EQ ("this", many.a.things);
+    EXPECT_EQ ("is", many.b);
+    EXPECT_EQ (2, many.c.wibble);
+    EXPECT_FALSE (many.c.wibbled);
+    EXPECT_EQ ("test", many.e.a1.things);
+    EXPECT_EQ ("dude", many.e.a2.things);
+    EXPECT_EQ (2, many.e.aCount);
+    EXPECT_EQ (100.0, many.f);
+
+    // fields that aren't bound are skipped, the order they're bound in
+    // doesn't matter
+    auto some = decode<Some> ("manyTypes");
+
+    EXPECT_EQ ("a", some.d);
+    EXPECT_EQ (100.0, some.f);
+}
+
+/******************************************************************************/
+
+TEST (Binding, collections) { // NOLINT
+    auto composites = decode<ListOfComposites> ("ListOfComposite");
+
+    ASSERT_EQ (3UL, composites.a.size());
+    EXPECT_EQ (5, composites.a[2].a);
+    EXPECT_EQ (6, composites.a[2].b);
+
+    auto map = decode<IntToString> ("_Mis_");
+
+    EXPECT_EQ ((std::map<int32_t, std::string> {
+            { 1, "two" }, { 3, "four" }, { 5, "six" } }), map.a);
+}
+
+/******************************************************************************/
+
+TEST (Binding, references) { // NOLINT
+    EXPECT_EQ (
+        (std::vector<std::string> { "A", "B", "C", "B", "A" }),
+        decode<Listy> ("_Le_2").listy);
+
+    EXPECT_EQ (
+        (std::vector<std::vector<std::string>> {
+            { "this", "is", "the", "first", "list" },
+            { "second", "list", "this", "be" } }),
+        decode<StringLists> ("ListOfStringList").a);
+}
+
+/**
+ * Skipping a and c loses count of the objects in them, the reference
+ * can't be followed rather than being followed to e.a1
+ */
+TEST (Binding, referencesAfterSkipped) { // NOLINT
+    auto blob = referencing();
+
+    auto many = decode<ManyTypes> (blob.data(), blob.size());
+
+    EXPECT_EQ ("test", many.e.a1.things);
+    EXPECT_EQ ("this", many.e.a2.things);
+
+    EXPECT_THROW (decode<Later> (blob.data(), blob.size()), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Binding, checked) { // NOLINT
+    EXPECT_THROW (decode<Wrong> ("manyTypes"), std::runtime_error);
+    EXPECT_THROW (decode<Missing> ("manyTypes"), std::runtime_error);
+    EXPECT_THROW (decode<ManyTypes> ("OneInt"), std::runtime_error);
+}
+
+/******************************************************************************/
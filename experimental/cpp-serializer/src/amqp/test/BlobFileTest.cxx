@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "amqp/codec/BlobFile.h"
+
+using namespace amqp::codec;
+
+/******************************************************************************/
+
+namespace {
+
+    const std::string FIXTURE { std::string (FIXTURE_DIR) + "/manyTypes" };
+
+    std::string
+    contents (const std::string & path_) {
+        std::ifstream in (path_, std::ios::binary);
+        return { std::istreambuf_iterator<char> (in), std::istreambuf_iterator<char>() };
+    }
+
+    std::string
+    str (const BlobFile & blob_) {
+        return std::string (blob_.data(), blob_.size());
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (BlobFile, regular) { // NOLINT
+    BlobFile blob (FIXTURE);
+
+    EXPECT_TRUE (blob.mapped());
+    EXPECT_EQ (contents (FIXTURE), str (blob));
+
+    // moving hands over the mapping
+    BlobFile moved (std::move (blob));
+
+    EXPECT_TRUE (moved.mapped());
+    EXPECT_EQ (contents (FIXTURE), str (moved));
+
+    EXPECT_THROW (BlobFile ("/no/such/blob"), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * A pipe can't be mapped so it's read into a buffer, bigger than the
+ * first one we try so it has to grow
+ */
+TEST (BlobFile, pipe) { // NOLINT
+    char dir[] = "/tmp/blobfile.XXXXXX";
+    ASSERT_NE (nullptr, ::mkdtemp (dir));
+
+    std::string fifo = std::string (dir) + "/fifo";
+    ASSERT_EQ (0, ::mkfifo (fifo.c_str(), 0600));
+
+    std::string written (200 * 1024, '\0');
+    for (size_t i { 0 } ; i < written.size() ; ++i) {
+        written[i] = static_cast<char> (i * 7);
+    }
+
+    std::thread writer ([&]() {
+        std::ofstream out (fifo, std::ios::binary);
+        out.write (written.data(), static_cast<std::streamsize> (written.size()));
+    });
+
+    {
+        BlobFile blob (fifo);
+        writer.join();
+
+        EXPECT_FALSE (blob.mapped());
+        EXPECT_EQ (written, str (blob));
+    }
+
+    ::unlink (fifo.c_str());
+    ::rmdir (dir);
+}
+
+/******************************************************************************/
+
+/**
+ * With stdin closed open hands back 0, that's still ours to close
+ */
+TEST (BlobFile, closesLowDescriptors) { // NOLINT
+    int saved = ::dup (STDIN_FILENO);
+    ASSERT_LE (0, saved);
+    ::close (STDIN_FILENO);
+
+    {
+        BlobFile blob (FIXTURE);
+        EXPECT_EQ (contents (FIXTURE), str (blob));
+    }
+
+    // nothing should be left on 0 for us to find
+    int left = ::fcntl (STDIN_FILENO, F_GETFD);
+
+    ::dup2 (saved, STDIN_FILENO);
+    ::close (saved);
+
+    EXPECT_EQ (-1, left);
+}
+
+/******************************************************************************/
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <memory>
+#include <sstream>
+#include <cstring>
+
+#include "Fixture.h"
+#include "SchemaCache.h"
+
+#include "amqp/columns/Columns.h"
+
+using namespace amqp::internal;
+using namespace amqp::internal::columns;
+
+using amqp::test::Fixture;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Appends fixture [name_] to [columns_], laying them out first if
+     * they haven't been
+     */
+    void
+    append (SchemaCache & cache_, const std::string & name_, std::unique_ptr<Columns> & columns_) {
+        Fixture (name_).read (cache_, [&] (auto d_, const auto & entry_, const auto & type_) {
+            if (!columns_) {
+                columns_ = std::make_unique<Columns> (entry_.schema(), type_);
+            }
+
+            entry_.reader (type_).visit (d_, entry_.schema(), *columns_);
+        });
+    }
+
+    std::string
+    str (const Column & column_, size_t i_) {
+        return std::string (
+                column_.m_bytes.data() + column_.m_offsets[i_],
+                column_.m_offsets[i_ + 1] - column_.m_offsets[i_]);
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Each list is an offsets column with its elements' fields in columns
+ * of their own
+ */
+TEST (Columns, lists) { // NOLINT
+    SchemaCache cache;
+    std::unique_ptr<Columns> columns;
+
+    append (cache, "ListOfComposites", columns);
+    append (cache, "ListOfComposites", columns);
+
+    const auto & c = columns->columns();
+    ASSERT_EQ (5UL, c.size());
+
+    EXPECT_EQ ("a", c[0].m_name);
+    EXPECT_EQ (ColumnType::Offsets, c[0].m_type);
+    EXPECT_EQ (Columns::NONE, c[0].m_table);
+    EXPECT_EQ ((std::vector<uint64_t> { 0, 3, 6 }), c[0].m_offsets);
+
+    EXPECT_EQ ("a[].a", c[1].m_name);
+    EXPECT_EQ (0UL, c[1].m_table);
+    EXPECT_EQ ((std::vector<int32_t> { 1, 3, 5, 1, 3, 5 }), c[1].m_ints);
+    EXPECT_EQ ((std::vector<int32_t> { 2, 4, 6, 2, 4, 6 }), c[2].m_ints);
+
+    EXPECT_EQ ("b[].a.a", c[4].m_name);
+    EXPECT_EQ (3UL, c[4].m_table);
+    EXPECT_EQ ((std::vector<int32_t> { 1, 2, 3, 4, 1, 2, 3, 4 }), c[4].m_ints);
+
+    EXPECT_EQ (2UL, columns->rows());
+    EXPECT_EQ (6UL, columns->rows (0));
+    EXPECT_EQ (8UL, columns->rows (3));
+}
+
+/******************************************************************************/
+
+/**
+ * Map entries are a list of keys and values, enums are their names
+ */
+TEST (Columns, mapsAndEnums) { // NOLINT
+    SchemaCache cache;
+    std::unique_ptr<Columns> map, list;
+
+    append (cache, "_Mis_", map);
+    append (cache, "_Le_", list);
+
+    const auto & m = map->columns();
+    ASSERT_EQ (3UL, m.size());
+    EXPECT_EQ ("a[].key", m[1].m_name);
+    EXPECT_EQ ((std::vector<int32_t> { 1, 3, 5 }), m[1].m_ints);
+    EXPECT_EQ ("a[].value", m[2].m_name);
+    EXPECT_EQ ("four", str (m[2], 1));
+
+    const auto & l = list->columns();
+    ASSERT_EQ (2UL, l.size());
+    EXPECT_EQ (ColumnType::String, l[1].m_type);
+    EXPECT_EQ ("C", str (l[1], 2));
+}
+
+/******************************************************************************/
+
+/**
+ * Nested composites flatten into the top table
+ */
+TEST (Columns, csv) { // NOLINT
+    SchemaCache cache;
+    std::unique_ptr<Columns> columns;
+
+    append (cache, "manyTypes", columns);
+    append (cache, "manyTypes", columns);
+
+    std::stringstream top;
+    columns->csv (top);
+
+    EXPECT_EQ (
+        "a.things,b,c.wibble,c.wibbled,d,e.a1.things,e.a2.things,e.aCount,f\n"
+        "this,is,2,false,a,test,dude,2,100\n"
+        "this,is,2,false,a,test,dude,2,100\n",
+        top.str());
+
+    std::unique_ptr<Columns> lists;
+    append (cache, "IntListStringList", lists);
+
+    std::stringstream strings;
+    lists->csv (strings, 2);
+
+    EXPECT_EQ ("parent,b[]\n0,aaa\n0,bbb\n0,ccc\n", strings.str());
+}
+
+/******************************************************************************/
+
+TEST (Columns, binary) { // NOLINT
+    SchemaCache cache;
+    std::unique_ptr<Columns> columns;
+
+    append (cache, "IntListStringList", columns);
+    append (cache, "IntListStringList", columns);
+
+    std::stringstream ss;
+    columns->write (ss);
+    auto out = ss.str();
+
+    ASSERT_LT (20UL, out.size());
+    EXPECT_EQ ("AMQPCOL1", out.substr (0, 8));
+
+    uint64_t rows;
+    uint32_t count;
+    std::memcpy (&rows, out.data() + 8, sizeof (rows));
+    std::memcpy (&count, out.data() + 16, sizeof (count));
+
+    EXPECT_EQ (2UL, rows);
+    EXPECT_EQ (4U, count);
+
+    // the last thing written is the bytes of the strings
+    EXPECT_EQ ("aaabbbcccaaabbbccc", out.substr (out.size() - 18));
+}
+
+/******************************************************************************/
+
+/**
+ * A blob that fails part way leaves nothing of itself behind
+ */
+TEST (Columns, rollback) { // NOLINT
+    SchemaCache cache;
+    std::unique_ptr<Columns> columns;
+
+    append (cache, "IntListStringList", columns);
+
+    columns->beginComposite ("");
+    columns->field ("a");
+    columns->beginList ("", 2);
+
+    EXPECT_THROW (columns->onString ("1"), std::runtime_error); // NOLINT
+
+    columns->rollback();
+
+    const auto & c = columns->columns();
+    EXPECT_EQ (1UL, columns->rows());
+    EXPECT_EQ ((std::vector<uint64_t> { 0, 7 }), c[0].m_offsets);
+    EXPECT_EQ (7UL, c[1].size());
+
+    append (cache, "IntListStringList", columns);
+    EXPECT_EQ (2UL, columns->rows());
+    EXPECT_EQ (14UL, c[1].size());
+}
+
+/******************************************************************************/
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <sstream>
+
+#include "Fixture.h"
+#include "SchemaCache.h"
+#include "JsonVisitor.h"
+
+#include "amqp/plan/DecodePlan.h"
+
+using namespace amqp::internal;
+
+using amqp::test::Fixture;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Decode a fixture blob either by walking the reader graph or by
+     * running the plan compiled from it
+     */
+    std::string
+    decode (const std::string & name_, bool compiled_) {
+        SchemaCache cache;
+        Fixture fixture (name_);
+
+        std::stringstream ss;
+        fixture.read (cache, [&] (auto d_, const auto & entry_, const auto & type_) {
+            reader::JsonVisitor visitor (ss);
+
+            if (compiled_) {
+                entry_.plan (type_).run (d_, visitor);
+            } else {
+                dynamic_cast<const reader::Reader *> (
+                        entry_.factory().byDescriptor (type_))->visit (
+                                d_, entry_.schema(), visitor);
+            }
+        });
+
+        return ss.str();
+    }
+
+    /**
+     * Decode just [fields_] from a fixture blob
+     */
+    std::string
+    project (const std::string & name_, const std::vector<std::string> & fields_) {
+        SchemaCache cache;
+        Fixture fixture (name_);
+
+        std::stringstream ss;
+        fixture.read (cache, [&] (auto d_, const auto & entry_, const auto & type_) {
+            reader::JsonVisitor visitor (ss);
+
+            entry_.plan (type_, plan::Projection (fields_)).run (d_, visitor);
+        });
+
+        return ss.str();
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (DecodePlan, matchesReaders) { // NOLINT
+    for (const auto & blob : {
+            "OneInt", "_i_is__", "IntListStringList", "ListOfComposites",
+            "ListOfListOfComposites", "ListOfListOfListOfInt", "_Le_",
+            "_Le_2", "_Mis_", "ListOfStringList", "manyTypes" })
+    {
+        EXPECT_EQ (decode (blob, false), decode (blob, true)) << blob;
+    }
+}
+
+/******************************************************************************/
+
+TEST (DecodePlan, references) { // NOLINT
+    // the last two elements are references to the second and first
+    EXPECT_EQ (R"({"listy":["A","B","C","B","A"]})", decode ("_Le_2", true));
+
+    // the second list's "this" is a reference to the first's
+    EXPECT_EQ (
+        R"({"a":[["this","is","the","first","list"],["second","list","this","be"]]})",
+        decode ("ListOfStringList", true));
+}
+
+/******************************************************************************/
+
+TEST (DecodePlan, routinesAreShared) { // NOLINT
+    SchemaCache cache;
+    std::string type;
+    const auto & plan = Fixture ("ListOfComposites").lookup (cache, type).plan (type);
+
+    size_t composites { 0 };
+    for (const auto & i : plan.code()) {
+        if (i.m_op == plan::Op::BEGIN_COMPOSITE) ++composites;
+    }
+
+    // one routine each for ListOfComposites, TwoInts, OneComposite and
+    // OneInt however many times they're referenced
+    EXPECT_EQ (4UL, composites);
+}
+
+/******************************************************************************/
+
+TEST (DecodePlan, projection) { // NOLINT
+    EXPECT_EQ (
+        R"({"b":"is","e":{"a2":{"things":"dude"}},"f":100})",
+        project ("manyTypes", { "f", "e.a2.things", "b" }));
+
+    // asking for something and then part of it still gets all of it
+    EXPECT_EQ (
+        R"({"e":{"a1":{"things":"test"},"a2":{"things":"dude"},"aCount":2}})",
+        project ("manyTypes", { "e", "e.a1" }));
+
+    // paths carry on into the elements of lists
+    EXPECT_EQ (
+        R"({"a":[{"b":2},{"b":4},{"b":6}]})",
+        project ("ListOfComposites", { "a.b" }));
+
+    EXPECT_EQ (decode ("manyTypes", true), project ("manyTypes", { }));
+
+    EXPECT_THROW (project ("manyTypes", { "e.a3" }), std::runtime_error);
+    EXPECT_THROW (project ("manyTypes", { "b.length" }), std::runtime_error);
+    EXPECT_THROW (project ("manyTypes", { "e..a1" }), std::runtime_error);
+}
+
+/******************************************************************************/
+
+TEST (DecodePlan, projectionSkips) { // NOLINT
+    SchemaCache cache;
+    std::string type;
+    const auto & plan = Fixture ("manyTypes").lookup (cache, type).plan (
+            type, plan::Projection ({ "b", "d" }));
+
+    std::vector<plan::Op> ops;
+    for (const auto & i : plan.code()) {
+        ops.push_back (i.m_op);
+    }
+
+    // a and c are stepped over and nothing after d is looked at
+    EXPECT_EQ ((std::vector<plan::Op> {
+            plan::Op::CALL,
+            plan::Op::RET,
+            plan::Op::BEGIN_COMPOSITE,
+            plan::Op::SKIP,
+            plan::Op::FIELD, plan::Op::STRING,
+            plan::Op::SKIP,
+            plan::Op::FIELD, plan::Op::STRING,
+            plan::Op::END_COMPOSITE,
+            plan::Op::RET }), ops);
+}
+
+/******************************************************************************/
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <sstream>
+
+#include "Fixture.h"
+#include "SchemaCache.h"
+#include "JsonVisitor.h"
+
+#include "amqp/codec/Decoder.h"
+#include "amqp/codec/BlobFile.h"
+
+using namespace amqp::codec;
+
+/******************************************************************************/
+
+TEST (Decoder, primitives) { // NOLINT
+    // smallint 7, str8 "hi", ulong 0x0102030405060708
+    const char buf[] = {
+        '\x54', '\x07',
+        '\xa1', '\x02', 'h', 'i',
+        '\x80', '\x01', '\x02', '\x03', '\x04', '\x05', '\x06', '\x07', '\x08'
+    };
+
+    Decoder d (buf, sizeof (buf));
+
+    EXPECT_EQ (AMQP_INT, d.type());
+    EXPECT_EQ (7, d.getInt());
+    EXPECT_TRUE (d.next());
+
+    EXPECT_EQ (AMQP_STRING, d.type());
+    EXPECT_EQ ("hi", d.getString());
+    EXPECT_EQ (0UL, d.getULong());
+    EXPECT_TRUE (d.next());
+
+    EXPECT_EQ (0x0102030405060708UL, d.getULong());
+    EXPECT_FALSE (d.next());
+}
+
+/******************************************************************************/
+
+TEST (Decoder, skipsSubtrees) { // NOLINT
+    // described (ulong 1) list8 [ list8 [ 1, 2 ], "a" ], then a trailing true
+    const char buf[] = {
+        '\x00', '\x53', '\x01',
+        '\xc0', '\x0b', '\x02',
+            '\xc0', '\x05', '\x02', '\x54', '\x01', '\x54', '\x02',
+            '\xa1', '\x01', 'a',
+        '\x41'
+    };
+
+    Decoder d (buf, sizeof (buf));
+
+    EXPECT_TRUE (d.isDescribed());
+    EXPECT_TRUE (d.next());
+    EXPECT_EQ (AMQP_BOOL, d.type());
+    EXPECT_TRUE (d.getBool());
+
+    Decoder d2 (buf, sizeof (buf));
+    {
+        auto_enter ae (&d2);
+        EXPECT_EQ (1UL, d2.getULong());
+        d2.next();
+        {
+            auto_list_enter ale (&d2, true);
+            EXPECT_EQ (2UL, ale.elements());
+            EXPECT_EQ (AMQP_LIST, d2.type());
+            d2.next();
+            EXPECT_EQ ("a", get_string (&d2));
+        }
+    }
+
+    // exiting leaves us back on the described node itself
+    EXPECT_TRUE (d2.isDescribed());
+    EXPECT_TRUE (d2.next());
+    EXPECT_EQ (AMQP_BOOL, d2.type());
+}
+
+/******************************************************************************/
+
+TEST (Decoder, arrays) { // NOLINT
+    // array8 of three smallints sharing one constructor
+    const char buf[] = { '\xe0', '\x05', '\x03', '\x54', '\x0a', '\x0b', '\x0c' };
+
+    Decoder d (buf, sizeof (buf));
+
+    EXPECT_EQ (AMQP_ARRAY, d.type());
+    EXPECT_EQ (3UL, d.getArray());
+
+    EXPECT_TRUE (enter (&d));
+    EXPECT_EQ (10, readAndNext<int32_t> (&d));
+    EXPECT_EQ (11, readAndNext<int32_t> (&d));
+    EXPECT_EQ (12, d.getInt());
+    EXPECT_FALSE (d.next());
+}
+
+/******************************************************************************/
+
+TEST (Decoder, truncated) { // NOLINT
+    const char buf[] = { '\xa1', '\x05', 'h', 'i' };
+
+    EXPECT_ANY_THROW (Decoder (buf, sizeof (buf)).next());
+}
+
+/******************************************************************************/
+
+/**
+ * Corrupting any byte of a blob's object, by hand or by a bad disk,
+ * gets an error out of the reader rather than taking the process down
+ */
+TEST (Decoder, malformedBlob) { // NOLINT
+    amqp::codec::BlobFile blob (std::string (FIXTURE_DIR) + "/ListOfListOfComposites");
+    std::string bytes (blob.data(), blob.size());
+
+    amqp::internal::SchemaCache cache;
+
+    // where the object sits in the envelope, ahead of the schema
+    size_t from, to;
+    amqp::test::Fixture (bytes.data(), bytes.size()).read (
+            cache,
+            [&] (auto d_, const auto &, const auto &) {
+                auto raw = d_->raw();
+                from = raw.data() - bytes.data();
+                to = from + raw.size();
+            });
+
+    size_t failed { 0 };
+
+    for (size_t i { from } ; i < to ; ++i) {
+        for (auto corrupt : { '\x00', '\x41', '\xc0', '\xff' }) {
+            std::string copy (bytes);
+            copy[i] = corrupt;
+
+            try {
+                amqp::test::Fixture (copy.data(), copy.size()).read (
+                        cache,
+                        [] (auto d_, const auto & entry_, const auto & type_) {
+                            std::stringstream ss;
+                            amqp::internal::reader::JsonVisitor visitor (ss);
+
+                            entry_.reader (type_).visit (d_, entry_.schema(), visitor);
+                        });
+            } catch (const std::exception &) {
+                ++failed;
+            }
+        }
+    }
+
+    EXPECT_LT (0UL, failed);
+}
+
+/******************************************************************************/
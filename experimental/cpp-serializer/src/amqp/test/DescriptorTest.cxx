@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+#include "amqp/descriptors/AMQPDescriptorRegistory.h"
+
+/******************************************************************************/
+
+TEST (Descriptors, known) { // NOLINT
+    for (uint64_t i { 1 } ; i <= 11 ; ++i) {
+        auto id = i | amqp::internal::DESCRIPTOR_TOP_32BITS;
+
+        ASSERT_NE (nullptr, amqp::findDescriptor (id)) << i;
+        EXPECT_EQ (amqp::describedToString (id),
+                amqp::descriptorFor (id).symbol()) << i;
+    }
+
+    EXPECT_EQ ("ENVELOPE", amqp::describedToString (
+            1UL | amqp::internal::DESCRIPTOR_TOP_32BITS));
+    EXPECT_EQ ("REFERENCED_OBJECT", amqp::describedToString (8U));
+}
+
+/******************************************************************************/
+
+TEST (Descriptors, unknown) { // NOLINT
+    // not ours, out of range, and in range but missing the Corda prefix
+    for (uint64_t id : {
+            0UL | amqp::internal::DESCRIPTOR_TOP_32BITS,
+            12UL | amqp::internal::DESCRIPTOR_TOP_32BITS,
+            1UL,
+            22UL })
+    {
+        EXPECT_EQ (nullptr, amqp::findDescriptor (id)) << id;
+        EXPECT_EQ ("UNKNOWN", amqp::describedToString (id)) << id;
+        EXPECT_THROW (amqp::descriptorFor (id), std::runtime_error); // NOLINT
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,42 @@
+#include "Fixture.h"
+
+/******************************************************************************
+ *
+ * amqp::test::Fixture
+ *
+ ******************************************************************************/
+
+amqp::test::
+Fixture::Fixture (const std::string & name_)
+    : m_file (std::in_place, std::string (FIXTURE_DIR) + "/" + name_)
+    , m_payload (m_file->data(), m_file->size())
+    , m_decoder (m_payload.data(), m_payload.size())
+{
+}
+
+/******************************************************************************/
+
+amqp::test::
+Fixture::Fixture (const char * blob_, size_t size_)
+    : m_payload (blob_, size_)
+    , m_decoder (m_payload.data(), m_payload.size())
+{
+}
+
+/******************************************************************************/
+
+amqp::codec::Decoder *
+amqp::test::
+Fixture::decoder() {
+    return &m_decoder;
+}
+
+/******************************************************************************/
+
+const amqp::internal::SchemaCache::Entry &
+amqp::test::
+Fixture::lookup (internal::SchemaCache & cache_, std::string & type_) {
+    return cache_.lookup (&m_decoder, type_);
+}
+
+/******************************************************************************/
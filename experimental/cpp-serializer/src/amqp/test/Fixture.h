@@ -0,0 +1,78 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+#include <optional>
+
+#include "SchemaCache.h"
+
+#include "amqp/codec/Decoder.h"
+#include "amqp/codec/Payload.h"
+#include "amqp/codec/BlobFile.h"
+
+/******************************************************************************/
+
+namespace amqp::test {
+
+    /**
+     * A blob the tests read, one of the blob-inspector's fixtures or one
+     * they've written themselves, with a decoder over its payload left on
+     * the envelope.
+     *
+     * An in memory blob must outlive the fixture.
+     */
+    class Fixture {
+        private :
+            std::optional<codec::BlobFile> m_file;
+            codec::Payload                 m_payload;
+            codec::Decoder                 m_decoder;
+
+        public :
+            /**
+             * The fixture named [name_]
+             */
+            explicit Fixture (const std::string & name_);
+
+            Fixture (const char * blob_, size_t size_);
+
+            Fixture (const Fixture &) = delete;
+            Fixture & operator = (const Fixture &) = delete;
+
+            codec::Decoder * decoder();
+
+            const internal::SchemaCache::Entry & lookup (
+                    internal::SchemaCache &,
+                    std::string & type_);
+
+            /**
+             * Look the blob's schema up in [cache_] and run [with_] with
+             * the decoder on the object it holds, the cache entry and the
+             * object's type
+             */
+            template<typename With>
+            auto read (internal::SchemaCache & cache_, With && with_);
+    };
+
+}
+
+/******************************************************************************/
+
+template<typename With>
+auto
+amqp::test::
+Fixture::read (internal::SchemaCache & cache_, With && with_) {
+    std::string type;
+    const auto & entry = lookup (cache_, type);
+
+    codec::Decoder * d = &m_decoder;
+
+    codec::auto_enter ae (d);
+    d->next();
+    codec::auto_enter ae2 (d);
+
+    return with_ (d, entry, type);
+}
+
+/******************************************************************************/
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <limits>
+
+#include "JsonVisitor.h"
+
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+TEST (JsonVisitor, structure) { // NOLINT
+    std::stringstream ss;
+    {
+        JsonVisitor v (ss);
+
+        v.beginComposite ("A");
+        v.field ("a");
+        v.onInt (-1);
+        v.field ("b");
+        v.beginList ("list", 3);
+        v.onDouble (1.5);
+        v.onDouble (std::numeric_limits<double>::infinity());
+        v.onLong (9007199254740993L);
+        v.endList();
+        v.field ("c");
+        v.beginComposite ("B");
+        v.field ("d");
+        v.onEnum ("E");
+        v.field ("e");
+        v.onBool (false);
+        v.endComposite();
+        v.field ("f");
+        v.beginList ("list", 0);
+        v.endList();
+        v.endComposite();
+    }
+
+    EXPECT_EQ (
+        R"({"a":-1,"b":[1.5,null,9007199254740993],"c":{"d":"E","e":false},"f":[]})",
+        ss.str());
+}
+
+/******************************************************************************/
+
+TEST (JsonVisitor, escaping) { // NOLINT
+    std::stringstream ss;
+    {
+        JsonVisitor v (ss);
+
+        // long enough that the interesting bits land in both the vector
+        // and scalar parts of the scan
+        v.onString (
+            "0123456789abcdef\"quoted\" back\\slash\ttab\nline\x01\x1f\x7f\xc3\xa9");
+    }
+
+    EXPECT_EQ (
+        R"("0123456789abcdef\"quoted\" back\\slash\ttab\nline\u0001\u001f)"
+        "\x7f\xc3\xa9\"",
+        ss.str());
+}
+
+/******************************************************************************/
+
+TEST (JsonVisitor, smallBuffer) { // NOLINT
+    std::stringstream ss;
+    std::string big (1000, 'x');
+    {
+        JsonVisitor v (ss, 64);
+
+        v.beginList ("list", 3);
+        v.onString ("a");
+        v.onString (big);
+        v.onString ("b");
+        v.endList();
+    }
+
+    EXPECT_EQ ("[\"a\",\"" + big + "\",\"b\"]", ss.str());
+}
+
+/******************************************************************************/
+
+TEST (JsonVisitor, maps) { // NOLINT
+    std::stringstream ss;
+    {
+        JsonVisitor v (ss);
+
+        v.beginComposite ("A");
+        v.field ("a");
+        v.beginMap ("map", 2);
+        v.onInt (1);
+        v.beginList ("list", 1);
+        v.onString ("x");
+        v.endList();
+        v.onString ("k\"2");
+        v.beginMap ("map", 0);
+        v.endMap();
+        v.endMap();
+        v.field ("b");
+        v.beginMap ("map", 1);
+        v.onBool (true);
+        v.onEnum ("E");
+        v.endMap();
+        v.endComposite();
+    }
+
+    EXPECT_EQ (
+        R"({"a":{"1":["x"],"k\"2":{}},"b":{"true":"E"}})",
+        ss.str());
+
+    JsonVisitor v (ss);
+    v.beginMap ("map", 1);
+    EXPECT_THROW (v.beginComposite ("A"), std::runtime_error);
+}
+
+/******************************************************************************/
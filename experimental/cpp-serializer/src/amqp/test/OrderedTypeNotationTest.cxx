@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <sstream>
 
 #include "OrderedTypeNotations.h"
 
@@ -8,54 +11,39 @@ namespace {
 
     class OTN : public amqp::internal::schema::OrderedTypeNotation {
         private :
-            std::string m_name;
+            amqp::internal::schema::Symbol m_id;
             std::vector<std::string> m_dependsOn;
+
         public :
+            /**
+             * How many times we've been asked for our dependencies, across
+             * every instance
+             */
+            static size_t asked;
+
             OTN(std::string name_, std::vector<std::string> dependsOn_)
-                : m_name (std::move (name_))
+                : m_id (name_)
                 , m_dependsOn (std::move (dependsOn_))
             { }
 
+            const amqp::internal::schema::Symbol & id() const override {
+                return m_id;
+            }
 
-            int dependsOn (const OrderedTypeNotation & otn_) const override {
-                const auto & otn = dynamic_cast<const OTN &>(otn_);
-
-                // does the "left hand side" depend on us (in this case
-                // the lhs is us as we're not inverting
-                if (std::find (
-                        m_dependsOn.begin(),
-                        m_dependsOn.end(),
-                        otn.name()) != m_dependsOn.end())
-                {
-                    return 1;
-                }
-
-                // do we depend on the left hand side
+            void dependencies (
+                std::vector<amqp::internal::schema::Symbol> & dependencies_
+            ) const override {
+                ++asked;
 
-                if (std::find (
-                        otn.begin(),
-                        otn.end(),
-                        name()) != otn.end())
-                {
-                    return 2;
+                for (const auto & dependency : m_dependsOn) {
+                    dependencies_.emplace_back (dependency);
                 }
-
-                return 0;
             }
 
-            const std::string & name() const { return m_name; }
-
-            decltype(m_dependsOn.cbegin()) begin() const { return m_dependsOn.cbegin(); }
-            decltype(m_dependsOn.cend()) end() const { return m_dependsOn.cend(); }
+            const std::string & name() const { return m_id.str(); }
     };
 
-    inline
-    std::string
-    str (const amqp::internal::schema::OrderedTypeNotations<OTN> & list_) {
-        std::stringstream ss;
-        ss << list_;
-        return ss.str();
-    }
+    size_t OTN::asked { 0 };
 
 }
 
@@ -72,7 +60,7 @@ operator << (
         const amqp::internal::schema::OrderedTypeNotations<OTN> &otn_
 ) {
     auto first { true };
-    for (const auto & i : otn_.m_schemas) {
+    for (const auto & i : otn_.levels()) {
         for (const auto & j : i) {
             if (first) {
                 first = false;
@@ -88,6 +76,20 @@ operator << (
 
 /******************************************************************************/
 
+namespace {
+
+    inline
+    std::string
+    str (const amqp::internal::schema::OrderedTypeNotations<OTN> & list_) {
+        std::stringstream ss;
+        ss << list_;
+        return ss.str();
+    }
+
+}
+
+/******************************************************************************/
+
 TEST (OTNTest, singleInsert) { // NOLINT
     amqp::internal::schema::OrderedTypeNotations<OTN> list;
 
@@ -219,3 +221,97 @@ TEST (OTNTest, three_5) { // NOLINT
 }
 
 /******************************************************************************/
+
+TEST (OTNTest, levels) { // NOLINT
+    amqp::internal::schema::OrderedTypeNotations<OTN> list;
+
+    // D needs B and C, which both need A
+    list.insert(std::make_unique<OTN>("D", std::vector<std::string> { "B", "C" }));
+    list.insert(std::make_unique<OTN>("C", std::vector<std::string> { "A" }));
+    list.insert(std::make_unique<OTN>("B", std::vector<std::string> { "A" }));
+    list.insert(std::make_unique<OTN>("A", std::vector<std::string>()));
+
+    ASSERT_EQ (3UL, list.levels().size());
+    EXPECT_EQ ("D C B A", str (list));
+
+    // iterating yields dependencies first
+    std::string built;
+    for (const auto & level : list) {
+        for (const auto & type : level) {
+            built += type->name();
+        }
+    }
+
+    EXPECT_EQ ("ACBD", built);
+}
+
+/******************************************************************************/
+
+TEST (OTNTest, insertAfterOrdering) { // NOLINT
+    amqp::internal::schema::OrderedTypeNotations<OTN> list;
+
+    list.insert(std::make_unique<OTN>("A", std::vector<std::string> { "B" }));
+    EXPECT_EQ ("A", str (list));
+
+    list.insert(std::make_unique<OTN>("B", std::vector<std::string>()));
+    EXPECT_EQ ("A B", str (list));
+}
+
+/******************************************************************************/
+
+TEST (OTNTest, cycle) { // NOLINT
+    amqp::internal::schema::OrderedTypeNotations<OTN> list;
+
+    list.insert(std::make_unique<OTN>("A", std::vector<std::string> { "B" }));
+    list.insert(std::make_unique<OTN>("B", std::vector<std::string> { "A" }));
+    list.insert(std::make_unique<OTN>("C", std::vector<std::string>()));
+
+    // nothing is lost, what can't be ordered comes last
+    EXPECT_EQ ("A B C", str (list));
+}
+
+/******************************************************************************/
+
+/**
+ * Ordering asks each type for its dependencies once and looks them up by
+ * id, never comparing types pairwise, so a schema of thousands of types
+ * is as quick to order as it is to read. A long chain inserted back to
+ * front was the worst case for the old insertion sort, every insert had
+ * to shuffle everything already in place
+ */
+TEST (OTNTest, scalesLinearly) { // NOLINT
+    const size_t types { 20000 };
+
+    amqp::internal::schema::OrderedTypeNotations<OTN> list;
+
+    for (size_t i { 0 } ; i < types ; ++i) {
+        std::vector<std::string> deps;
+
+        // each type needs the next, and every tenth also needs the last
+        if (i + 1 < types) {
+            deps.push_back ("T" + std::to_string (i + 1));
+        }
+        if (i % 10 == 0 && i + 1 < types) {
+            deps.push_back ("T" + std::to_string (types - 1));
+        }
+
+        list.insert (std::make_unique<OTN> ("T" + std::to_string (i), deps));
+    }
+
+    OTN::asked = 0;
+
+    EXPECT_EQ (types, list.levels().size());
+    EXPECT_EQ (types, OTN::asked);
+
+    size_t expected { types };
+    for (const auto & level : list) {
+        ASSERT_EQ (1UL, level.size());
+        EXPECT_EQ ("T" + std::to_string (--expected), level.front()->name());
+    }
+
+    // already ordered, iterating again does no more work
+    for (const auto & level : list) { (void)level; }
+    EXPECT_EQ (types, OTN::asked);
+}
+
+/******************************************************************************/
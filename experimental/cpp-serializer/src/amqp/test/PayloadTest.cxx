@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <zlib.h>
+
+#include <string>
+#include <stdexcept>
+
+#include "amqp/codec/Payload.h"
+#include "amqp/codec/BlobFile.h"
+
+using namespace amqp::codec;
+
+/******************************************************************************/
+
+namespace {
+
+    const std::string HEADER { 'c', 'o', 'r', 'd', 'a', '\x01', '\x00' };
+
+    /**
+     * What the JVM writes for [data_] with DEFLATE encoding
+     */
+    std::string
+    deflated (const std::string & data_) {
+        std::string sections = '\x00' + data_;
+
+        uLongf size = compressBound (sections.size());
+        std::string compressed (size, '\0');
+
+        compress (
+            reinterpret_cast<Bytef *> (&compressed[0]), &size,
+            reinterpret_cast<const Bytef *> (sections.data()), sections.size());
+
+        compressed.resize (size);
+
+        return HEADER + '\x02' + '\x00' + compressed;
+    }
+
+    std::string
+    contents (const Payload & payload_) {
+        return std::string (payload_.data(), payload_.size());
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Payload, uncompressed) { // NOLINT
+    BlobFile blob (std::string (FIXTURE_DIR) + "/manyTypes");
+    Payload payload (blob.data(), blob.size());
+
+    EXPECT_FALSE (payload.compressed());
+    EXPECT_EQ (blob.data() + HEADER.size() + 1, payload.data());
+    EXPECT_EQ (blob.size() - HEADER.size() - 1, payload.size());
+
+    auto alt = HEADER + '\x01' + "data";
+    EXPECT_EQ ("data", contents (Payload (alt.data(), alt.size())));
+}
+
+/******************************************************************************/
+
+TEST (Payload, deflate) { // NOLINT
+    BlobFile blob (std::string (FIXTURE_DIR) + "/manyTypes");
+    std::string data (blob.data() + HEADER.size() + 1, blob.size() - HEADER.size() - 1);
+
+    auto encoded = deflated (data);
+    Payload payload (encoded.data(), encoded.size());
+
+    EXPECT_TRUE (payload.compressed());
+    EXPECT_EQ (data, contents (payload));
+
+    // bigger than the first guess at the output, so it has to grow
+    std::string big (1024 * 1024, 'x');
+    auto bigEncoded = deflated (big);
+    EXPECT_EQ (big, contents (Payload (bigEncoded.data(), bigEncoded.size())));
+}
+
+/******************************************************************************/
+
+TEST (Payload, errors) { // NOLINT
+    auto bad = std::string ("corba") + '\x01' + '\x00' + '\x00';
+    EXPECT_THROW (Payload (bad.data(), bad.size()), std::runtime_error);
+
+    auto section = HEADER + '\x07';
+    EXPECT_THROW (Payload (section.data(), section.size()), std::runtime_error);
+
+    auto snappy = HEADER + '\x02' + '\x01';
+    EXPECT_THROW (Payload (snappy.data(), snappy.size()), std::runtime_error);
+
+    auto truncated = deflated (std::string (1000, 'y'));
+    truncated.resize (truncated.size() - 10);
+    EXPECT_THROW (Payload (truncated.data(), truncated.size()), std::runtime_error);
+}
+
+/******************************************************************************/
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "Fixture.h"
+#include "SchemaCache.h"
+
+using namespace amqp::internal;
+
+using amqp::test::Fixture;
+
+/******************************************************************************/
+
+namespace {
+
+    const SchemaCache::Entry &
+    lookup (SchemaCache & cache_, const std::string & name_, std::string & type_) {
+        return Fixture (name_).lookup (cache_, type_);
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (SchemaCache, reuse) { // NOLINT
+    SchemaCache cache;
+    std::string type;
+
+    const auto & first = lookup (cache, "OneInt", type);
+
+    EXPECT_EQ (1UL, cache.misses());
+    EXPECT_EQ (0UL, cache.hits());
+    EXPECT_NE (nullptr, first.factory().byDescriptor (type));
+
+    const auto & second = lookup (cache, "OneInt", type);
+
+    EXPECT_EQ (1UL, cache.misses());
+    EXPECT_EQ (1UL, cache.hits());
+    EXPECT_EQ (&first, &second);
+
+    const auto & third = lookup (cache, "TwoInts", type);
+
+    EXPECT_EQ (2UL, cache.misses());
+    EXPECT_EQ (2UL, cache.size());
+    EXPECT_NE (&first, &third);
+    EXPECT_NE (nullptr, third.factory().byDescriptor (type));
+}
+
+/******************************************************************************/
+
+TEST (SchemaCache, reachable) { // NOLINT
+    SchemaCache eager;
+    SchemaCache lazy (SchemaCache::Materialise::Reachable);
+    std::string type;
+
+    const auto & all = lookup (eager, "ListOfComposites", type);
+    const auto & some = lookup (lazy, "ListOfComposites", type);
+
+    size_t types { 0 };
+    for (const auto & level : all.schema()) {
+        types += level.size();
+    }
+
+    ASSERT_LT (1UL, types);
+    EXPECT_EQ (types, some.schema().unparsed());
+    EXPECT_EQ (nullptr, some.factory().byDescriptor (type));
+
+    // a type nothing else is needed for comes on its own
+    const auto & leaf = all.schema().begin()->front()->descriptor();
+
+    some.reader (leaf);
+
+    EXPECT_EQ (types - 1, some.schema().unparsed());
+    EXPECT_EQ (nullptr, some.factory().byDescriptor (type));
+
+    some.reader (type);
+
+    EXPECT_EQ (0UL, some.schema().unparsed());
+    EXPECT_NE (nullptr, some.factory().byDescriptor (type));
+}
+
+/******************************************************************************/
+
+/**
+ * A field whose type the schema doesn't hold, or that holds the type
+ * it's a field of, is an error naming the type rather than a null reader
+ */
+TEST (SchemaCache, unbuildableTypes) { // NOLINT
+    amqp::codec::BlobFile file (std::string (FIXTURE_DIR) + "/manyTypes");
+    const std::string original (file.data(), file.size());
+
+    // DD's first field, "a", is an AA
+    const std::string field ("\xa1\x01" "a\xa1(net.corda.serialization.internal.amqp.AA");
+    auto at = original.find (field);
+    ASSERT_NE (std::string::npos, at);
+    at += field.size() - 2;
+
+    for (const auto & [ to, named ] : {
+            std::make_pair ("AZ", "amqp.AZ"),
+            std::make_pair ("DD", "amqp.DD") })
+    {
+        auto blob = original;
+        blob.replace (at, 2, to);
+
+        for (auto materialise : {
+                SchemaCache::Materialise::All,
+                SchemaCache::Materialise::Reachable })
+        {
+            SchemaCache cache (materialise);
+            std::string type;
+
+            try {
+                Fixture (blob.data(), blob.size()).lookup (cache, type).reader (type);
+                FAIL() << to;
+            } catch (const std::runtime_error & e) {
+                EXPECT_NE (std::string::npos, std::string (e.what()).find (named)) << e.what();
+            }
+        }
+    }
+}
+
+/******************************************************************************/
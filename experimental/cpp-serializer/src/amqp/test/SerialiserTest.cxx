@@ -0,0 +1,359 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <thread>
+
+#include "Fixture.h"
+#include "SchemaCache.h"
+#include "JsonVisitor.h"
+
+#include "amqp/bind/Binding.h"
+#include "amqp/codec/Decoder.h"
+#include "amqp/codec/Encoder.h"
+#include "amqp/codec/BlobFile.h"
+#include "serialiser/Serialiser.h"
+#include "serialiser/EncodingVisitor.h"
+
+using namespace amqp::internal;
+
+using amqp::test::Fixture;
+
+/******************************************************************************/
+
+namespace {
+
+    struct Things { std::string things; };
+    struct Wibble { int64_t wibble; bool wibbled; };
+    struct Pair { Things a1; Things a2; int32_t aCount; };
+
+    struct ManyTypes {
+        Things a;
+        std::string b;
+        Wibble c;
+        std::string d;
+        Pair e;
+        double f;
+    };
+
+    struct Enumerated { std::string e; };
+
+    struct IntToString { std::map<int32_t, std::string> a; };
+
+}
+
+AMQP_BIND (Things, AMQP_FIELD (Things, things));
+AMQP_BIND (Wibble, AMQP_FIELD (Wibble, wibble), AMQP_FIELD (Wibble, wibbled));
+AMQP_BIND (Pair, AMQP_FIELD (Pair, a1), AMQP_FIELD (Pair, a2), AMQP_FIELD (Pair, aCount));
+
+AMQP_BIND (ManyTypes,
+    AMQP_FIELD (ManyTypes, a),
+    AMQP_FIELD (ManyTypes, b),
+    AMQP_FIELD (ManyTypes, c),
+    AMQP_FIELD (ManyTypes, d),
+    AMQP_FIELD (ManyTypes, e),
+    AMQP_FIELD (ManyTypes, f));
+
+AMQP_BIND (Enumerated, AMQP_FIELD (Enumerated, e));
+AMQP_BIND (IntToString, AMQP_FIELD (IntToString, a));
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Decode a whole blob, header and all, to json
+     */
+    std::string
+    json (const char * blob_, size_t size_) {
+        SchemaCache cache;
+
+        std::stringstream ss;
+        Fixture (blob_, size_).read (cache, [&] (auto d_, const auto & entry_, const auto & type_) {
+            reader::JsonVisitor visitor (ss);
+            entry_.reader (type_).visit (d_, entry_.schema(), visitor);
+        });
+
+        return ss.str();
+    }
+
+    std::string
+    json (const std::vector<char> & blob_) {
+        return json (blob_.data(), blob_.size());
+    }
+
+    std::string
+    json (const std::string & name_) {
+        amqp::codec::BlobFile blob (std::string (FIXTURE_DIR) + "/" + name_);
+        return json (blob.data(), blob.size());
+    }
+
+    /**
+     * Read a fixture blob into a visitor that writes it out again
+     */
+    std::vector<char>
+    rewrite (const std::string & name_) {
+        Fixture fixture (name_);
+
+        SchemaCache cache (SchemaCache::Materialise::Reachable);
+        std::string type;
+        amqp::serialiser::Serialiser serialiser (fixture.lookup (cache, type));
+
+        std::vector<char> rewritten;
+        serialiser.write (type, rewritten, [&] (amqp::codec::Encoder & encoder_) {
+            serialiser::EncodingVisitor visitor (serialiser.schema(), encoder_);
+
+            fixture.read (cache, [&] (auto d_, const auto & entry_, const auto & type_) {
+                entry_.reader (type_).visit (d_, entry_.schema(), visitor);
+            });
+        });
+
+        return rewritten;
+    }
+
+    /**
+     * Read a fixture blob into a bound struct and write that out again
+     */
+    template<typename T>
+    std::vector<char>
+    rebind (const std::string & name_) {
+        Fixture fixture (name_);
+
+        SchemaCache cache;
+        std::string descriptor;
+        const auto & entry = fixture.lookup (cache, descriptor);
+
+        bind::Binding<T> binding (entry, descriptor);
+
+        auto value = fixture.read (cache, [&] (auto d_, const auto &, const auto &) {
+            return binding.read (d_);
+        });
+
+        amqp::serialiser::Serialiser serialiser (entry);
+
+        std::vector<char> rewritten;
+        serialiser.write (binding, value, rewritten);
+
+        return rewritten;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Encoder, compacts) { // NOLINT
+    std::vector<char> buffer;
+    {
+        amqp::codec::Encoder encoder (buffer);
+
+        encoder.beginList();
+        encoder.putInt (1);
+        encoder.putInt (1000);
+        encoder.putString (std::string (300, 'x'));
+        encoder.beginList();
+        encoder.endList();
+        encoder.beginMap();
+        encoder.putLong (2);
+        encoder.putBool (true);
+        encoder.endMap();
+        encoder.endList();
+
+        EXPECT_EQ (0UL, encoder.depth());
+    }
+
+    amqp::codec::Decoder decoder (buffer.data(), buffer.size());
+    amqp::codec::Decoder * d = &decoder;
+
+    // too big for a list8 because of the string
+    EXPECT_EQ (amqp::codec::FC_LIST32, d->formatCode());
+    EXPECT_EQ (5UL, d->getList());
+
+    amqp::codec::auto_enter ae (d);
+
+    EXPECT_EQ (amqp::codec::FC_SMALLINT, d->formatCode());
+    EXPECT_EQ (1, amqp::codec::readAndNext<int32_t> (d));
+    EXPECT_EQ (amqp::codec::FC_INT, d->formatCode());
+    EXPECT_EQ (1000, amqp::codec::readAndNext<int32_t> (d));
+    EXPECT_EQ (amqp::codec::FC_STR32, d->formatCode());
+    EXPECT_EQ (300UL, amqp::codec::readAndNext<std::string_view> (d).size());
+    EXPECT_EQ (amqp::codec::FC_LIST0, d->formatCode());
+    d->next();
+    EXPECT_EQ (amqp::codec::FC_MAP8, d->formatCode());
+    EXPECT_EQ (2UL, d->getMap());
+    EXPECT_FALSE (d->next());
+}
+
+/******************************************************************************/
+
+/**
+ * Everything the readers see written back out reads back the same
+ */
+TEST (Serialiser, rewritesWhatItsVisited) { // NOLINT
+    for (const auto * name : {
+            "OneInt", "TwoInts", "OneComposite", "OneCompositeOneString",
+            "IntList", "TwoIntLists", "IntListStringList", "ListOfComposite",
+            "ListOfComposites", "ListOfListOfComposites", "ListOfListOfListOfInt",
+            "ListOfStringList", "_Le_", "_Le_2", "_Li_", "_Mis_", "_e_",
+            "_i_is__", "manyTypes" })
+    {
+        EXPECT_EQ (json (name), json (rewrite (name))) << name;
+    }
+}
+
+/******************************************************************************/
+
+TEST (Serialiser, writesBoundStructs) { // NOLINT
+    EXPECT_EQ (json ("manyTypes"), json (rebind<ManyTypes> ("manyTypes")));
+    EXPECT_EQ (json ("_e_"), json (rebind<Enumerated> ("_e_")));
+    EXPECT_EQ (json ("_Mis_"), json (rebind<IntToString> ("_Mis_")));
+}
+
+/******************************************************************************/
+
+/**
+ * The schema written is only what the object needs and is only encoded
+ * once, the buffer is reused blob after blob
+ */
+TEST (Serialiser, reusesBuffers) { // NOLINT
+    SchemaCache cache;
+    std::string descriptor;
+    const auto & entry = Fixture ("manyTypes").lookup (cache, descriptor);
+
+    bind::Binding<Wibble> binding (entry, entry.schema().byType (
+            schema::Symbol::find ("net.corda.serialization.internal.amqp.BB"))->descriptor());
+
+    amqp::serialiser::Serialiser serialiser (entry);
+
+    std::vector<char> buffer;
+    serialiser.write (binding, Wibble { 1234567, true }, buffer);
+
+    auto first = buffer;
+    auto capacity = buffer.capacity();
+
+    serialiser.write (binding, Wibble { 1234567, true }, buffer);
+
+    EXPECT_EQ (first, buffer);
+    EXPECT_EQ (capacity, buffer.capacity());
+
+    EXPECT_EQ (R"({"wibble":1234567,"wibbled":true})", json (buffer));
+
+    SchemaCache cache2;
+    std::string type;
+    const auto & schema = Fixture (buffer.data(), buffer.size()).lookup (cache2, type).schema();
+
+    size_t types { 0 };
+    for (const auto & level : schema) {
+        types += level.size();
+    }
+
+    EXPECT_EQ (1UL, types);
+}
+
+/******************************************************************************/
+
+/**
+ * Serialisers sharing a lazily materialising entry write their schemas
+ * while other threads are still materialising types into it
+ */
+TEST (Serialiser, sharesAnEntryAcrossThreads) { // NOLINT
+    for (int round { 0 } ; round < 20 ; ++round) {
+        SchemaCache cache (SchemaCache::Materialise::Reachable);
+        std::string descriptor;
+        const auto & entry = Fixture ("manyTypes").lookup (cache, descriptor);
+
+        std::vector<std::string> written (4);
+        std::vector<std::thread> threads;
+
+        threads.emplace_back ([&] {
+            amqp::serialiser::Serialiser serialiser (entry);
+            bind::Binding<ManyTypes> binding (entry, descriptor);
+
+            std::vector<char> buffer;
+            serialiser.write (binding, ManyTypes {
+                    { "this" }, "is", { 2, false }, "a", { { "test" }, { "dude" }, 2 }, 100.0 },
+                    buffer);
+            written[0] = json (buffer);
+        });
+
+        threads.emplace_back ([&] {
+            amqp::serialiser::Serialiser serialiser (entry);
+            bind::Binding<Wibble> binding (entry, "net.corda:j51xhauFDZ37If6kCXjXng==");
+
+            std::vector<char> buffer;
+            serialiser.write (binding, Wibble { 1234567, true }, buffer);
+            written[1] = json (buffer);
+        });
+
+        threads.emplace_back ([&] {
+            amqp::serialiser::Serialiser serialiser (entry);
+            bind::Binding<Pair> binding (entry, "net.corda:wSjDsbBzX1tMy1MxP1rCbQ==");
+
+            std::vector<char> buffer;
+            serialiser.write (binding, Pair { { "x" }, { "y" }, 3 }, buffer);
+            written[2] = json (buffer);
+        });
+
+        threads.emplace_back ([&] {
+            amqp::serialiser::Serialiser serialiser (entry);
+            bind::Binding<Things> binding (entry, "net.corda:whOur9MMEGxrXhJCcQDNGg==");
+
+            std::vector<char> buffer;
+            serialiser.write (binding, Things { "z" }, buffer);
+            written[3] = json (buffer);
+        });
+
+        for (auto & thread : threads) {
+            thread.join();
+        }
+
+        EXPECT_EQ (json ("manyTypes"), written[0]);
+        EXPECT_EQ (R"({"wibble":1234567,"wibbled":true})", written[1]);
+        EXPECT_EQ (R"({"a1":{"things":"x"},"a2":{"things":"y"},"aCount":3})", written[2]);
+        EXPECT_EQ (R"({"things":"z"})", written[3]);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Scalars of some other type than the schema has for where they're
+ * written are refused, rather than written for the JVM to trip over
+ */
+TEST (EncodingVisitor, checksScalarTypes) { // NOLINT
+    SchemaCache cache;
+    std::string descriptor;
+    const auto & schema = Fixture ("manyTypes").lookup (cache, descriptor).schema();
+
+    // write a value for [field_] of [type_], fields we skip are null
+    auto write = [&] (const char * type_, const char * field_, auto && value_) {
+        std::vector<char> buffer;
+        amqp::codec::Encoder encoder (buffer);
+        serialiser::EncodingVisitor visitor (schema, encoder);
+
+        visitor.beginComposite (std::string ("net.corda.serialization.internal.amqp.") + type_);
+        visitor.field (field_);
+        value_ (visitor);
+        visitor.endComposite();
+    };
+
+    auto onInt = [] (auto & v_) { v_.onInt (1); };
+    auto onLong = [] (auto & v_) { v_.onLong (1); };
+    auto onDouble = [] (auto & v_) { v_.onDouble (1); };
+    auto onBool = [] (auto & v_) { v_.onBool (true); };
+    auto onString = [] (auto & v_) { v_.onString ("1"); };
+
+    EXPECT_NO_THROW (write ("CC", "aCount", onInt));
+    EXPECT_NO_THROW (write ("BB", "wibble", onLong));
+    EXPECT_NO_THROW (write ("DD", "f", onDouble));
+    EXPECT_NO_THROW (write ("BB", "wibbled", onBool));
+    EXPECT_NO_THROW (write ("DD", "b", onString));
+
+    EXPECT_THROW (write ("CC", "aCount", onLong), std::runtime_error);
+    EXPECT_THROW (write ("BB", "wibble", onInt), std::runtime_error);
+    EXPECT_THROW (write ("DD", "f", onString), std::runtime_error);
+    EXPECT_THROW (write ("BB", "wibbled", onInt), std::runtime_error);
+    EXPECT_THROW (write ("DD", "b", onDouble), std::runtime_error);
+    EXPECT_THROW (write ("DD", "a", onString), std::runtime_error);
+}
+
+/******************************************************************************/
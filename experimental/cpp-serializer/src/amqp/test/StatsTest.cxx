@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <memory>
+#include <sstream>
+
+#include "Fixture.h"
+#include "SchemaCache.h"
+#include "JsonVisitor.h"
+
+#include "amqp/stats/Stats.h"
+
+using namespace amqp::internal;
+
+using amqp::test::Fixture;
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    decode (SchemaCache & cache_, const std::string & name_, stats::Stats & stats_) {
+        std::stringstream ss;
+        reader::JsonVisitor json (ss);
+        stats::CountingVisitor visitor (json, stats_);
+
+        Fixture (name_).read (cache_, [&] (auto d_, const auto & entry_, const auto & type_) {
+            stats::Timer timer (stats::Decode);
+            entry_.reader (type_).visit (d_, entry_.schema(), visitor);
+        });
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * A schema is only decoded, ordered and built into readers the first
+ * time it's seen
+ */
+TEST (Stats, chargesPhases) { // NOLINT
+    SchemaCache cache;
+    stats::Stats first, second;
+
+    {
+        stats::Scope scope (first);
+        decode (cache, "ListOfComposites", first);
+    }
+
+    {
+        stats::Scope scope (second);
+        decode (cache, "ListOfComposites", second);
+    }
+
+    for (auto phase : { stats::Lookup, stats::Schema, stats::Order, stats::Factory, stats::Decode }) {
+        EXPECT_LT (0UL, first.nanos (phase)) << stats::name (phase);
+    }
+
+    EXPECT_LT (0UL, second.nanos (stats::Lookup));
+    EXPECT_LT (0UL, second.nanos (stats::Decode));
+    // just checking there's nothing to materialise
+    EXPECT_GT (first.nanos (stats::Schema), second.nanos (stats::Schema));
+    EXPECT_EQ (0UL, second.nanos (stats::Order));
+    EXPECT_EQ (0UL, second.nanos (stats::Factory));
+
+    EXPECT_EQ (first.count (stats::Objects), second.count (stats::Objects));
+    EXPECT_LT (0UL, first.count (stats::Elements));
+    EXPECT_LT (0UL, first.count (stats::Fields));
+
+    stats::Stats map;
+    decode (cache, "_Mis_", map);
+
+    EXPECT_EQ (3UL, map.count (stats::Entries));
+    EXPECT_EQ (0UL, map.count (stats::Elements));
+}
+
+/******************************************************************************/
+
+/**
+ * Nothing is recorded outside of a scope
+ */
+TEST (Stats, onlyInScope) { // NOLINT
+    SchemaCache cache;
+    stats::Stats stats;
+
+    decode (cache, "OneInt", stats);
+
+    EXPECT_EQ (nullptr, stats::current());
+    EXPECT_EQ (0UL, stats.nanos (stats::Lookup));
+    EXPECT_EQ (0UL, stats.nanos (stats::Decode));
+    EXPECT_EQ (1UL, stats.count (stats::Objects));
+}
+
+/******************************************************************************/
+
+#ifdef AMQP_ALLOC_STATS
+
+/**
+ * Allocations land in the phase and the reader making them, dumping a
+ * blob allocates the values each reader builds
+ */
+TEST (Stats, countsAllocations) { // NOLINT
+    Fixture fixture ("manyTypes");
+
+    SchemaCache cache;
+    stats::Stats stats;
+
+    std::string type;
+    const schema::Schema * types;
+    const reader::Reader * reader;
+    {
+        stats::Scope scope (stats);
+        const auto & entry = fixture.lookup (cache, type);
+        types = &entry.schema();
+        reader = &entry.reader (type);
+    }
+
+    EXPECT_LT (0UL, stats.allocations (stats::Schema).m_count);
+    EXPECT_LT (0UL, stats.allocations (stats::Factory).m_count);
+
+    stats::Stats dumped;
+    fixture.read (cache, [&] (auto d_, const auto &, const auto &) {
+        stats::Scope scope (dumped);
+        stats::Timer timer (stats::Decode);
+        reader->dump (d_, *types);
+    });
+
+    EXPECT_LT (0UL, dumped.allocations (stats::Decode).m_count);
+    EXPECT_LT (0UL, dumped.allocations (stats::Composite).m_count);
+    EXPECT_LT (0UL, dumped.allocations (stats::String).m_bytes);
+    EXPECT_EQ (0UL, dumped.allocations (stats::Schema).m_count);
+
+    // over aligned allocations go through operator new's aligned forms
+    struct alignas (64) Wide { char m_bytes[64]; };
+
+    stats::Stats aligned;
+    {
+        stats::Scope scope (aligned);
+        stats::Timer timer (stats::Decode);
+
+        auto wide = std::make_unique<Wide>();
+        auto wides = std::make_unique<Wide[]> (2);
+
+        EXPECT_EQ (0UL, reinterpret_cast<uintptr_t> (wide.get()) % 64);
+        EXPECT_EQ (0UL, reinterpret_cast<uintptr_t> (wides.get()) % 64);
+    }
+
+    EXPECT_EQ (2UL, aligned.allocations (stats::Decode).m_count);
+}
+
+/******************************************************************************/
+
+#endif
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "schema/Symbol.h"
+#include "schema/Field.h"
+
+using namespace amqp::internal::schema;
+
+/******************************************************************************/
+
+TEST (Symbol, interning) { // NOLINT
+    Symbol a ("net.corda.A");
+    Symbol b (std::string ("net.corda.") + "A");
+    Symbol c ("net.corda.C");
+
+    EXPECT_EQ (a, b);
+    EXPECT_EQ (a.id(), b.id());
+    EXPECT_EQ (&a.str(), &b.str());
+    EXPECT_NE (a, c);
+    EXPECT_EQ ("net.corda.C", c.str());
+}
+
+/******************************************************************************/
+
+TEST (Symbol, find) { // NOLINT
+    EXPECT_TRUE (Symbol::find ("never.interned.anywhere").empty());
+    EXPECT_TRUE (Symbol().empty());
+    EXPECT_EQ ("", Symbol().str());
+
+    Symbol d ("net.corda.D");
+    EXPECT_EQ (d, Symbol::find ("net.corda.D"));
+}
+
+/******************************************************************************/
+
+TEST (Symbol, primitives) { // NOLINT
+    for (const auto type : { "string", "long", "boolean", "int", "double" }) {
+        EXPECT_TRUE (Symbol (type).primitive()) << type;
+        EXPECT_TRUE (Field::typeIsPrimitive (type)) << type;
+    }
+
+    EXPECT_FALSE (Symbol().primitive());
+    EXPECT_FALSE (Symbol ("net.corda.E").primitive());
+    EXPECT_FALSE (Field::typeIsPrimitive ("*"));
+}
+
+/******************************************************************************/
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <sstream>
+
+#include "Fixture.h"
+#include "SchemaCache.h"
+#include "TextVisitor.h"
+
+using namespace amqp::internal;
+using namespace amqp::internal::reader;
+
+using amqp::test::Fixture;
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    dump (const std::string & name_) {
+        SchemaCache cache;
+        Fixture fixture (name_);
+
+        return fixture.read (cache, [] (auto d_, const auto & entry_, const auto & type_) {
+            return entry_.reader (type_).dump (d_, entry_.schema())->dump();
+        });
+    }
+
+    std::string
+    visit (const std::string & name_) {
+        SchemaCache cache;
+        Fixture fixture (name_);
+
+        return fixture.read (cache, [] (auto d_, const auto & entry_, const auto & type_) {
+            std::stringstream ss;
+            TextVisitor v (ss);
+            entry_.reader (type_).visit (d_, entry_.schema(), v);
+            return ss.str();
+        });
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Visiting a blob writes exactly what dumping it would have
+ */
+TEST (TextVisitor, matchesDump) { // NOLINT
+    for (const auto * name : {
+            "OneInt", "TwoInts", "OneComposite", "ListOfComposites",
+            "ListOfListOfListOfInt", "IntListStringList", "ListOfStringList",
+            "_Le_", "_Le_2", "_Mis_", "_e_", "_i_is__", "manyTypes" })
+    {
+        EXPECT_EQ (dump (name), visit (name)) << name;
+    }
+}
+
+/******************************************************************************/
+
+TEST (TextVisitor, maps) { // NOLINT
+    std::stringstream ss;
+    TextVisitor v (ss);
+
+    v.beginMap ("map", 2);
+    v.onInt (1);
+    v.onString ("x");
+    v.beginComposite ("K");
+    v.field ("k");
+    v.onInt (2);
+    v.endComposite();
+    v.beginList ("list", 0);
+    v.endList();
+    v.endMap();
+
+    EXPECT_EQ (R"({ 1 : "x", { k : 2 } : [  ] })", ss.str());
+}
+
+/******************************************************************************/
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <sstream>
+
+#include "Fixture.h"
+#include "SchemaCache.h"
+#include "JsonVisitor.h"
+
+#include "amqp/value/ValueTree.h"
+
+using namespace amqp::internal;
+
+using amqp::test::Fixture;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Run the plan for a fixture blob into [visitor_]
+     */
+    void
+    decode (
+        const std::string & name_,
+        SchemaCache & cache_,
+        amqp::reader::IVisitor & visitor_
+    ) {
+        Fixture (name_).read (cache_, [&] (auto d_, const auto & entry_, const auto & type_) {
+            entry_.plan (type_).run (d_, visitor_);
+        });
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (ValueTree, replaysWhatItWasGiven) { // NOLINT
+    SchemaCache cache;
+    value::ValueTree tree;
+
+    for (const auto & blob : {
+            "OneInt", "_i_is__", "IntListStringList", "ListOfComposites",
+            "ListOfListOfListOfInt", "_Le_", "_Le_2", "_Mis_",
+            "ListOfStringList", "manyTypes" })
+    {
+        std::stringstream direct;
+        {
+            reader::JsonVisitor visitor (direct);
+            decode (blob, cache, visitor);
+        }
+
+        tree.reset();
+        decode (blob, cache, tree);
+
+        std::stringstream replayed;
+        {
+            reader::JsonVisitor visitor (replayed);
+            ASSERT_NE (nullptr, tree.root());
+            value::accept (*tree.root(), visitor);
+        }
+
+        EXPECT_EQ (direct.str(), replayed.str()) << blob;
+    }
+}
+
+/******************************************************************************/
+
+TEST (ValueTree, shape) { // NOLINT
+    value::ValueTree tree;
+
+    tree.beginComposite ("A");
+    tree.field ("a");
+    tree.onLong (1);
+    tree.field ("b");
+    tree.beginList ("list", 2);
+    tree.onString ("x");
+    tree.onString ("y");
+    tree.endList();
+    tree.endComposite();
+
+    auto root = tree.root();
+    ASSERT_NE (nullptr, root);
+    EXPECT_EQ (value::Value::Kind::COMPOSITE, root->m_kind);
+    EXPECT_EQ ("A", root->m_string);
+    EXPECT_EQ (2UL, root->m_size);
+
+    auto a = root->m_first;
+    EXPECT_EQ ("a", a->m_name);
+    EXPECT_EQ (1, a->m_long);
+
+    auto b = a->m_next;
+    EXPECT_EQ ("b", b->m_name);
+    EXPECT_EQ (value::Value::Kind::LIST, b->m_kind);
+    EXPECT_EQ (2UL, b->m_size);
+    EXPECT_EQ ("x", b->m_first->m_string);
+    EXPECT_EQ ("y", b->m_first->m_next->m_string);
+    EXPECT_EQ (nullptr, b->m_first->m_next->m_next);
+    EXPECT_EQ (nullptr, b->m_next);
+}
+
+/******************************************************************************/
+
+TEST (ValueTree, mapsAreContiguous) { // NOLINT
+    value::ValueTree tree;
+
+    tree.beginMap ("map", 2);
+    tree.onInt (1);
+    tree.onString ("a");
+    tree.onInt (2);
+    tree.onString ("b");
+    tree.endMap();
+
+    auto map = tree.root();
+    ASSERT_NE (nullptr, map);
+    EXPECT_EQ (value::Value::Kind::MAP, map->m_kind);
+    EXPECT_EQ (4UL, map->m_size);
+    EXPECT_EQ (2, map->m_first[2].m_int);
+    EXPECT_EQ ("b", map->m_first[3].m_string);
+    EXPECT_EQ (&map->m_first[1], map->m_first[0].m_next);
+    EXPECT_EQ (nullptr, map->m_first[3].m_next);
+
+    tree.reset();
+    tree.beginMap ("map", 0);
+    EXPECT_THROW (tree.onInt (1), std::runtime_error);
+}
+
+/******************************************************************************/
+
+TEST (Arena, resetReusesBlocks) { // NOLINT
+    value::Arena arena (256);
+
+    for (int round { 0 } ; round < 3 ; ++round) {
+        arena.reset();
+
+        for (int i { 0 } ; i < 100 ; ++i) {
+            auto p = arena.make<int64_t> (i);
+            EXPECT_EQ (0UL, reinterpret_cast<uintptr_t> (p) % alignof (int64_t));
+            EXPECT_EQ (i, *p);
+        }
+
+        // bigger than a block gets one of its own
+        EXPECT_EQ (1000UL, arena.copy (std::string (1000, 'x')).size());
+    }
+
+    EXPECT_EQ (5UL, arena.blocks());
+}
+
+/******************************************************************************/
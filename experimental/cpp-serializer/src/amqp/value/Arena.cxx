@@ -0,0 +1,101 @@
+#include "Arena.h"
+
+#include <cstring>
+#include <algorithm>
+
+/******************************************************************************
+ *
+ * class Arena
+ *
+ ******************************************************************************/
+
+amqp::internal::value::
+Arena::Arena (size_t blockSize_)
+    : m_blockSize (blockSize_)
+    , m_current (0)
+    , m_next (nullptr)
+    , m_end (nullptr)
+{
+}
+
+/******************************************************************************/
+
+/**
+ * The current block is full, move on to the next one we already have
+ * if there is one big enough, otherwise add a new one after it. Anything
+ * bigger than a block gets a block of its own
+ */
+void *
+amqp::internal::value::
+Arena::overflow (size_t size_, size_t align_) {
+    size_t next = m_blocks.empty() ? 0 : m_current + 1;
+    size_t needed = size_ + align_;
+
+    if (next == m_blocks.size() || m_blocks[next].m_size < needed) {
+        size_t size = std::max (m_blockSize, needed);
+
+        m_blocks.insert (
+                m_blocks.begin() + next,
+                Block { std::make_unique<char[]> (size), size });
+    }
+
+    m_current = next;
+    m_next = m_blocks[next].m_data.get();
+    m_end = m_next + m_blocks[next].m_size;
+
+    return allocate (size_, align_);
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::value::
+Arena::copy (std::string_view str_) {
+    if (str_.empty()) {
+        return { };
+    }
+
+    auto p = static_cast<char *> (allocate (str_.size(), 1));
+    std::memcpy (p, str_.data(), str_.size());
+
+    return { p, str_.size() };
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+Arena::reset() {
+    m_current = 0;
+
+    if (m_blocks.empty()) {
+        m_next = m_end = nullptr;
+    } else {
+        m_next = m_blocks.front().m_data.get();
+        m_end = m_next + m_blocks.front().m_size;
+    }
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::value::
+Arena::blocks() const {
+    return m_blocks.size();
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::value::
+Arena::capacity() const {
+    size_t total { 0 };
+
+    for (const auto & block : m_blocks) {
+        total += block.m_size;
+    }
+
+    return total;
+}
+
+/******************************************************************************/
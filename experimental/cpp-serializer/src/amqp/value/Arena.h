@@ -0,0 +1,108 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <new>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <string_view>
+#include <type_traits>
+
+/******************************************************************************/
+
+/**
+ * A bump allocator handing out memory from a few large blocks.
+ *
+ * Nothing allocated from an arena is ever freed on its own, everything
+ * goes at once when it's reset or destroyed. Reset keeps the blocks so
+ * decoding blob after blob into the same arena stops touching the heap
+ * once it's grown large enough for the biggest of them.
+ *
+ * Only trivially destructible things can live here as nothing's
+ * destructor is ever run.
+ */
+namespace amqp::internal::value {
+
+    class Arena {
+        public :
+            static constexpr size_t DEFAULT_BLOCK = 64 * 1024;
+
+        private :
+            struct Block {
+                std::unique_ptr<char[]> m_data;
+                size_t                  m_size;
+            };
+
+            std::vector<Block> m_blocks;
+
+            const size_t m_blockSize;
+
+            /**
+             * The block we're allocating from and the free space left in it
+             */
+            size_t m_current;
+            char * m_next;
+            char * m_end;
+
+            void * overflow (size_t, size_t);
+
+        public :
+            explicit Arena (size_t blockSize_ = DEFAULT_BLOCK);
+
+            Arena (const Arena &) = delete;
+            Arena & operator = (const Arena &) = delete;
+
+            void * allocate (size_t size_, size_t align_);
+
+            template<typename T, typename ... Args>
+            T * make (Args && ... args_);
+
+            /**
+             * Take a copy of [str_] that lives as long as the arena
+             */
+            std::string_view copy (std::string_view str_);
+
+            /**
+             * Forget everything allocated so far, keeping the blocks
+             */
+            void reset();
+
+            size_t blocks() const;
+            size_t capacity() const;
+    };
+
+}
+
+/******************************************************************************/
+
+inline void *
+amqp::internal::value::
+Arena::allocate (size_t size_, size_t align_) {
+    auto space = static_cast<size_t> (m_end - m_next);
+    void * p = m_next;
+
+    if (std::align (align_, size_, p, space)) {
+        m_next = static_cast<char *> (p) + size_;
+        return p;
+    }
+
+    return overflow (size_, align_);
+}
+
+/******************************************************************************/
+
+template<typename T, typename ... Args>
+inline T *
+amqp::internal::value::
+Arena::make (Args && ... args_) {
+    static_assert (
+        std::is_trivially_destructible<T>::value,
+        "Arena allocated types are never destroyed");
+
+    return new (allocate (sizeof (T), alignof (T))) T (
+            std::forward<Args> (args_)...);
+}
+
+/******************************************************************************/
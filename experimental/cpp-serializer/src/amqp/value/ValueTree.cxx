@@ -0,0 +1,262 @@
+#include "ValueTree.h"
+
+#include <string>
+#include <stdexcept>
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+accept (const Value & value_, amqp::reader::IVisitor & visitor_) {
+    switch (value_.m_kind) {
+        case Value::Kind::INT    : visitor_.onInt (value_.m_int); break;
+        case Value::Kind::LONG   : visitor_.onLong (value_.m_long); break;
+        case Value::Kind::DOUBLE : visitor_.onDouble (value_.m_double); break;
+        case Value::Kind::BOOL   : visitor_.onBool (value_.m_bool); break;
+        case Value::Kind::STRING : visitor_.onString (value_.m_string); break;
+        case Value::Kind::ENUM   : visitor_.onEnum (value_.m_string); break;
+        case Value::Kind::COMPOSITE : {
+            visitor_.beginComposite (std::string (value_.m_string));
+
+            for (auto v = value_.m_first ; v ; v = v->m_next) {
+                visitor_.field (std::string (v->m_name));
+                accept (*v, visitor_);
+            }
+
+            visitor_.endComposite();
+            break;
+        }
+        case Value::Kind::LIST : {
+            visitor_.beginList (std::string (value_.m_string), value_.m_size);
+
+            for (auto v = value_.m_first ; v ; v = v->m_next) {
+                accept (*v, visitor_);
+            }
+
+            visitor_.endList();
+            break;
+        }
+        case Value::Kind::MAP : {
+            visitor_.beginMap (std::string (value_.m_string), value_.m_size / 2);
+
+            for (auto v = value_.m_first ; v ; v = v->m_next) {
+                accept (*v, visitor_);
+            }
+
+            visitor_.endMap();
+            break;
+        }
+    }
+}
+
+/******************************************************************************
+ *
+ * class ValueTree
+ *
+ ******************************************************************************/
+
+amqp::internal::value::
+ValueTree::ValueTree (size_t blockSize_)
+    : m_arena (blockSize_)
+    , m_root (nullptr)
+{
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::reset() {
+    m_arena.reset();
+    m_root = nullptr;
+    m_open.clear();
+    m_field = { };
+}
+
+/******************************************************************************/
+
+const amqp::internal::value::Value *
+amqp::internal::value::
+ValueTree::root() const {
+    return m_root;
+}
+
+/******************************************************************************/
+
+const amqp::internal::value::Arena &
+amqp::internal::value::
+ValueTree::arena() const {
+    return m_arena;
+}
+
+/******************************************************************************/
+
+/**
+ * Allocate a node and hang it off whatever we're currently inside, or
+ * make it the root if we aren't inside anything
+ */
+amqp::internal::value::Value *
+amqp::internal::value::
+ValueTree::add (Value::Kind kind_) {
+    Value * value;
+
+    if (!m_open.empty() && m_open.back().m_parent->m_kind == Value::Kind::MAP) {
+        auto & open = m_open.back();
+
+        if (open.m_parent->m_size == open.m_capacity) {
+            throw std::runtime_error ("More entries in map than expected");
+        }
+
+        value = open.m_slots + open.m_parent->m_size;
+    } else {
+        value = m_arena.make<Value>();
+    }
+
+    value->m_kind = kind_;
+    value->m_name = m_field;
+    value->m_first = nullptr;
+    value->m_next = nullptr;
+    value->m_size = 0;
+
+    m_field = { };
+
+    if (m_open.empty()) {
+        if (m_root) {
+            throw std::runtime_error ("Value tree already has a root");
+        }
+        m_root = value;
+    } else {
+        auto & open = m_open.back();
+
+        if (open.m_last) {
+            open.m_last->m_next = value;
+        } else {
+            open.m_parent->m_first = value;
+        }
+
+        open.m_last = value;
+        ++open.m_parent->m_size;
+    }
+
+    return value;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::beginComposite (const std::string & type_) {
+    auto value = add (Value::Kind::COMPOSITE);
+    value->m_string = m_arena.copy (type_);
+
+    m_open.push_back ({ value, nullptr, nullptr, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::endComposite() {
+    m_open.pop_back();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::beginList (const std::string & type_, size_t) {
+    auto value = add (Value::Kind::LIST);
+    value->m_string = m_arena.copy (type_);
+
+    m_open.push_back ({ value, nullptr, nullptr, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::endList() {
+    m_open.pop_back();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::beginMap (const std::string & type_, size_t size_) {
+    auto value = add (Value::Kind::MAP);
+    value->m_string = m_arena.copy (type_);
+
+    auto slots = static_cast<Value *> (
+            m_arena.allocate (2 * size_ * sizeof (Value), alignof (Value)));
+
+    m_open.push_back ({ value, nullptr, slots, 2 * size_ });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::endMap() {
+    m_open.pop_back();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::field (const std::string & name_) {
+    m_field = m_arena.copy (name_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::onInt (int32_t value_) {
+    add (Value::Kind::INT)->m_int = value_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::onLong (int64_t value_) {
+    add (Value::Kind::LONG)->m_long = value_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::onDouble (double value_) {
+    add (Value::Kind::DOUBLE)->m_double = value_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::onBool (bool value_) {
+    add (Value::Kind::BOOL)->m_bool = value_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::onString (std::string_view value_) {
+    auto value = add (Value::Kind::STRING);
+    value->m_string = m_arena.copy (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::value::
+ValueTree::onEnum (std::string_view value_) {
+    auto value = add (Value::Kind::ENUM);
+    value->m_string = m_arena.copy (value_);
+}
+
+/******************************************************************************/
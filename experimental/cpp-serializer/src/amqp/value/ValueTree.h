@@ -0,0 +1,126 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include "Arena.h"
+
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::value {
+
+    /**
+     * One decoded value. Scalars keep their native type rather than being
+     * turned into a string, composites and lists link their elements in
+     * the order they were read. A map's keys and values alternate, held
+     * in a single array so entry i's key is m_first[2 * i] and its value
+     * the one after. Every node and every string it refers to lives in
+     * the arena of the ValueTree that built it
+     */
+    struct Value {
+        enum class Kind : uint8_t {
+            INT, LONG, DOUBLE, BOOL, STRING, ENUM, COMPOSITE, LIST, MAP
+        };
+
+        Kind m_kind;
+
+        /**
+         * The property this is the value of, empty for list elements
+         * and the top level value
+         */
+        std::string_view m_name;
+
+        /**
+         * The string or enum constant, or for composites, lists and
+         * maps their type
+         */
+        std::string_view m_string;
+
+        union {
+            int32_t m_int;
+            int64_t m_long;
+            double  m_double;
+            bool    m_bool;
+        };
+
+        const Value * m_first;
+        const Value * m_next;
+        size_t        m_size;
+    };
+
+    /**
+     * Replay [value_] into a visitor as though it were being read
+     */
+    void accept (const Value &, amqp::reader::IVisitor &);
+
+    /**
+     * Builds the values a reader or plan visits into a tree held in an
+     * arena, the in memory alternative to dumping an IValue tree without
+     * a heap allocation per value.
+     *
+     * Reset between blobs, the tree from the last one is gone but the
+     * arena's blocks are reused for the next.
+     */
+    class ValueTree : public amqp::reader::IVisitor {
+        private :
+            Arena m_arena;
+
+            Value * m_root;
+
+            /**
+             * The composites, lists and maps we're inside, and the last
+             * element added to each so far. Maps know their size up front
+             * so their elements go in an array allocated when they start
+             */
+            struct Open {
+                Value * m_parent;
+                Value * m_last;
+                Value * m_slots;
+                size_t  m_capacity;
+            };
+
+            std::vector<Open> m_open;
+
+            std::string_view m_field;
+
+            Value * add (Value::Kind);
+
+        public :
+            explicit ValueTree (size_t blockSize_ = Arena::DEFAULT_BLOCK);
+
+            void reset();
+
+            /**
+             * The top level value, null until one's been visited
+             */
+            const Value * root() const;
+
+            const Arena & arena() const;
+
+            void beginComposite (const std::string &) override;
+            void endComposite() override;
+
+            void beginList (const std::string &, size_t) override;
+            void endList() override;
+
+            void beginMap (const std::string &, size_t) override;
+            void endMap() override;
+
+            void field (const std::string &) override;
+
+            void onInt (int32_t) override;
+            void onLong (int64_t) override;
+            void onDouble (double) override;
+            void onBool (bool) override;
+            void onString (std::string_view) override;
+            void onEnum (std::string_view) override;
+    };
+
+}
+
+/******************************************************************************/
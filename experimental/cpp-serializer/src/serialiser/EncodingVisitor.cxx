@@ -0,0 +1,315 @@
+#include "EncodingVisitor.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "EnumWriter.h"
+
+#include "amqp/bind/Binding.h"
+#include "amqp/schema/Field.h"
+#include "amqp/schema/Composite.h"
+#include "amqp/schema/restricted-types/Map.h"
+#include "amqp/schema/restricted-types/List.h"
+#include "amqp/schema/restricted-types/Enum.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::serialiser::EncodingVisitor
+ *
+ ******************************************************************************/
+
+amqp::internal::serialiser::
+EncodingVisitor::EncodingVisitor (
+    const schema::Schema & schema_,
+    codec::Encoder & data_
+) : m_schema (schema_)
+  , m_data (data_)
+{
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::AMQPTypeNotation &
+amqp::internal::serialiser::
+EncodingVisitor::notation (const std::string & type_) const {
+    auto type = m_schema.byType (schema::Symbol::find (type_));
+
+    if (!type) {
+        throw std::runtime_error ("No type " + type_ + " in the schema");
+    }
+
+    return *type;
+}
+
+/******************************************************************************/
+
+/**
+ * The type of the value about to be written, as far as the schema says
+ */
+const amqp::internal::schema::Symbol &
+amqp::internal::serialiser::
+EncodingVisitor::expected() const {
+    if (m_stack.empty()) {
+        throw std::runtime_error ("Only a composite can be written on its own");
+    }
+
+    const auto & frame = m_stack.back();
+
+    if (frame.m_composite) {
+        if (!frame.m_field) {
+            throw std::runtime_error (
+                    "Value written to " + frame.m_composite->name()
+                    + " before saying which field it's for");
+        }
+
+        return bind::fieldType (*frame.m_field);
+    }
+
+    return *frame.m_types[frame.m_types[1] ? frame.m_values % 2 : 0];
+}
+
+/******************************************************************************/
+
+/**
+ * A scalar is only written where the schema expects one of [type_]
+ */
+void
+amqp::internal::serialiser::
+EncodingVisitor::check (const schema::Symbol & type_) const {
+    const auto & type = expected();
+
+    if (type != type_) {
+        bind::mismatch (type_.str(), type);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Composites, lists and maps are all described by their descriptor
+ */
+const amqp::internal::schema::AMQPTypeNotation &
+amqp::internal::serialiser::
+EncodingVisitor::begin (const std::string & type_) {
+    const auto & type = notation (type_);
+
+    m_data.described();
+    m_data.putSymbol (type.descriptor());
+
+    return type;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+EncodingVisitor::written() {
+    if (!m_stack.empty()) {
+        ++m_stack.back().m_values;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+EncodingVisitor::beginComposite (const std::string & type_) {
+    const auto & type = begin (type_);
+
+    if (type.type() != schema::AMQPTypeNotation::Composite) {
+        bind::mismatch ("a composite", type.id());
+    }
+
+    m_data.beginList();
+
+    m_stack.push_back (Frame {
+        &dynamic_cast<const schema::Composite &> (type),
+        0, nullptr, { nullptr, nullptr }, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+EncodingVisitor::endComposite() {
+    const auto & frame = m_stack.back();
+
+    for (auto i { frame.m_next } ; i < frame.m_composite->fields().size() ; ++i) {
+        m_data.putNull();
+    }
+
+    m_data.endList();
+    m_stack.pop_back();
+    written();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+EncodingVisitor::beginList (const std::string & type_, size_t) {
+    const auto & list = bind::asList (m_schema, begin (type_).id());
+
+    m_data.beginList();
+
+    m_stack.push_back (Frame {
+        nullptr, 0, nullptr, { &list.listOfId(), nullptr }, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+EncodingVisitor::endList() {
+    m_data.endList();
+    m_stack.pop_back();
+    written();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+EncodingVisitor::beginMap (const std::string & type_, size_t) {
+    const auto & map = bind::asMap (m_schema, begin (type_).id());
+
+    m_data.beginMap();
+
+    m_stack.push_back (Frame {
+        nullptr, 0, nullptr, { &map.keyTypeId(), &map.valueTypeId() }, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+EncodingVisitor::endMap() {
+    m_data.endMap();
+    m_stack.pop_back();
+    written();
+}
+
+/******************************************************************************/
+
+/**
+ * Fields we've been moved past without being given are null
+ */
+void
+amqp::internal::serialiser::
+EncodingVisitor::field (const std::string & name_) {
+    if (m_stack.empty() || !m_stack.back().m_composite) {
+        throw std::runtime_error ("Field " + name_ + " given outside of a composite");
+    }
+
+    auto & frame = m_stack.back();
+    const auto & fields = frame.m_composite->fields();
+
+    auto i = frame.m_next;
+    while (i < fields.size() && fields[i]->name() != name_) {
+        ++i;
+    }
+
+    if (i == fields.size()) {
+        throw std::runtime_error (
+                "No field " + name_ + " in " + frame.m_composite->name()
+                + " after those already written");
+    }
+
+    for ( ; frame.m_next < i ; ++frame.m_next) {
+        m_data.putNull();
+    }
+
+    frame.m_field = fields[i].get();
+    frame.m_next = i + 1;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+EncodingVisitor::onInt (int32_t value_) {
+    static const schema::Symbol type ("int");
+    check (type);
+
+    m_data.putInt (value_);
+    written();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+EncodingVisitor::onLong (int64_t value_) {
+    static const schema::Symbol type ("long");
+    check (type);
+
+    m_data.putLong (value_);
+    written();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+EncodingVisitor::onDouble (double value_) {
+    static const schema::Symbol type ("double");
+    check (type);
+
+    m_data.putDouble (value_);
+    written();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+EncodingVisitor::onBool (bool value_) {
+    static const schema::Symbol type ("boolean");
+    check (type);
+
+    m_data.putBool (value_);
+    written();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+EncodingVisitor::onString (std::string_view value_) {
+    static const schema::Symbol type ("string");
+    check (type);
+
+    m_data.putString (value_);
+    written();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+EncodingVisitor::onEnum (std::string_view value_) {
+    const auto & type = expected();
+
+    if (!bind::isEnum (m_schema, type)) {
+        bind::mismatch ("an enum", type);
+    }
+
+    const auto & enumeration = dynamic_cast<const schema::Enum &> (*m_schema.byType (type));
+    const auto & choices = enumeration.choices();
+
+    auto choice = std::find_if (
+            choices.begin(),
+            choices.end(),
+            [value_](const uPtr<schema::Choice> & c) { return c->choice() == value_; });
+
+    if (choice == choices.end()) {
+        throw std::runtime_error (
+                std::string (value_) + " is not a constant of " + enumeration.name());
+    }
+
+    writeEnum (m_data, enumeration.descriptor(), value_, choice - choices.begin());
+
+    written();
+}
+
+/******************************************************************************/
@@ -0,0 +1,86 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+
+#include "amqp/reader/IVisitor.h"
+#include "amqp/codec/Encoder.h"
+#include "amqp/schema/Schema.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+    class Field;
+}
+
+/******************************************************************************/
+
+/**
+ * Writes whatever it's told about as the JVM would encode it against a
+ * schema, so the callbacks a reader makes reading a blob write it back
+ * out again, and a producer with no struct to bind can write a value by
+ * making them itself.
+ *
+ * Composites, lists and maps are looked up in the schema by the type
+ * they're begun with. The fields of a composite must be given in the
+ * order the schema has them, any that are left out are written as null,
+ * and the type of each value is followed from there so an enum is
+ * written as a constant of the right one. A value of some other type
+ * than the schema has for it is an error.
+ */
+namespace amqp::internal::serialiser {
+
+    class EncodingVisitor : public amqp::reader::IVisitor {
+        private :
+            /**
+             * For a composite the next of its fields to write and the
+             * one we're writing, for a list the type of its elements and
+             * for a map that of its keys and values along with how many
+             * of them we've had
+             */
+            struct Frame {
+                const schema::Composite * m_composite;
+                size_t                    m_next;
+                const schema::Field *     m_field;
+                const schema::Symbol *    m_types[2];
+                size_t                    m_values;
+            };
+
+            const schema::Schema & m_schema;
+            codec::Encoder &       m_data;
+
+            std::vector<Frame> m_stack;
+
+            const schema::AMQPTypeNotation & notation (const std::string &) const;
+            const schema::Symbol & expected() const;
+            void check (const schema::Symbol &) const;
+
+            const schema::AMQPTypeNotation & begin (const std::string &);
+            void written();
+
+        public :
+            EncodingVisitor (const schema::Schema &, codec::Encoder &);
+
+            void beginComposite (const std::string & type_) override;
+            void endComposite() override;
+
+            void beginList (const std::string & type_, size_t size_) override;
+            void endList() override;
+
+            void beginMap (const std::string & type_, size_t size_) override;
+            void endMap() override;
+
+            void field (const std::string & name_) override;
+
+            void onInt (int32_t) override;
+            void onLong (int64_t) override;
+            void onDouble (double) override;
+            void onBool (bool) override;
+            void onString (std::string_view) override;
+            void onEnum (std::string_view) override;
+    };
+
+}
+
+/******************************************************************************/
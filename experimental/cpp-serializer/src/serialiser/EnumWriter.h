@@ -0,0 +1,38 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "amqp/codec/Encoder.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::serialiser {
+
+    /**
+     * An enum is written as its constant's name and ordinal, described by
+     * the enum's descriptor. Inline as the bindings, built into the amqp
+     * library, write enums too and that doesn't link against us
+     */
+    inline void
+    writeEnum (
+        codec::Encoder & data_,
+        std::string_view descriptor_,
+        std::string_view constant_,
+        size_t ordinal_
+    ) {
+        data_.described();
+        data_.putSymbol (descriptor_);
+        data_.beginList();
+        data_.putString (constant_);
+        data_.putInt (static_cast<int32_t> (ordinal_));
+        data_.endList();
+    }
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,310 @@
+#include "Generator.h"
+
+#include <cstdio>
+#include <stdexcept>
+
+#include "EnumWriter.h"
+
+#include "amqp/schema/Field.h"
+#include "amqp/schema/Choice.h"
+#include "amqp/schema/Composite.h"
+#include "amqp/schema/Descriptor.h"
+#include "amqp/schema/restricted-types/List.h"
+#include "amqp/schema/restricted-types/Enum.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    const std::string PACKAGE { "net.corda.generated." };
+
+    const char * const TYPES[] = { "int", "long", "double", "boolean", "string" };
+
+    /**
+     * The JVM's descriptors are a hash of the type, FNV-1a keeps ours
+     * the same wherever we're built
+     */
+    std::string
+    descriptorOf (const std::string & name_) {
+        uint64_t hash { 14695981039346656037ULL };
+
+        for (auto c : name_) {
+            hash = (hash ^ static_cast<unsigned char> (c)) * 1099511628211ULL;
+        }
+
+        char hex[17];
+        snprintf (hex, sizeof (hex), "%016llx", static_cast<unsigned long long> (hash));
+
+        return std::string ("net.corda:") + hex;
+    }
+
+    uPtr<schema::Field>
+    field (const std::string & name_, const std::string & type_) {
+        return std::make_unique<schema::Field> (
+                name_, type_, std::list<std::string> { }, "", "", true, false);
+    }
+
+    uPtr<schema::Field>
+    listField (const std::string & name_, const std::string & list_) {
+        return std::make_unique<schema::Field> (
+                name_, "*", std::list<std::string> { list_ }, "", "", true, false);
+    }
+
+    uPtr<schema::Composite>
+    composite (
+        const std::string & name_,
+        std::vector<uPtr<schema::Field>> fields_
+    ) {
+        return std::make_unique<schema::Composite> (
+                name_, "", std::list<std::string> { },
+                std::make_unique<schema::Descriptor> (descriptorOf (name_)),
+                std::move (fields_));
+    }
+
+    std::string
+    levelName (size_t depth_) {
+        return PACKAGE + "Level" + std::to_string (depth_);
+    }
+
+    std::string
+    paddingName (size_t i_) {
+        return PACKAGE + "Padding" + std::to_string (i_);
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::serialiser::Generator
+ *
+ ******************************************************************************/
+
+amqp::internal::serialiser::
+Generator::Generator (const Shape & shape_)
+    : m_shape (shape_)
+    , m_random (shape_.m_seed)
+{
+    if (m_shape.m_depth == 0) {
+        throw std::runtime_error ("Generated blobs need to be at least one level deep");
+    }
+
+    if (m_shape.m_strings + m_shape.m_enums > 100) {
+        throw std::runtime_error ("More than 100% of fields are strings and enums");
+    }
+
+    if (m_shape.m_enums && !m_shape.m_constants) {
+        throw std::runtime_error ("Enum fields need at least one constant");
+    }
+
+    /*
+     * Decide what each field of each level is first, then we know
+     * whether we need the enum
+     */
+    std::uniform_int_distribution<unsigned int> percent (0, 99);
+    std::uniform_int_distribution<unsigned int> primitive (Int, Bool);
+
+    bool enums { false };
+
+    for (size_t d { 0 } ; d < m_shape.m_depth ; ++d) {
+        Level level { descriptorOf (levelName (d)), { } };
+
+        for (size_t f { 0 } ; f < m_shape.m_fields ; ++f) {
+            auto p = percent (m_random);
+
+            if (p < m_shape.m_strings) {
+                level.m_fields.push_back (String);
+            } else if (p < m_shape.m_strings + m_shape.m_enums) {
+                level.m_fields.push_back (Enum);
+                enums = true;
+            } else {
+                level.m_fields.push_back (static_cast<Kind> (primitive (m_random)));
+            }
+        }
+
+        m_levels.emplace_back (std::move (level));
+    }
+
+    schema::OrderedTypeNotations<schema::AMQPTypeNotation> types;
+    size_t count { 0 };
+
+    auto insert = [&types, &count] (auto type_) {
+        types.insert (std::move (type_));
+        ++count;
+    };
+
+    const std::string list { "java.util.List<" + levelName (0) + ">" };
+
+    std::vector<uPtr<schema::Field>> rootFields;
+    rootFields.emplace_back (listField ("items", list));
+    insert (composite (PACKAGE + "Root", std::move (rootFields)));
+
+    insert (std::make_unique<schema::List> (
+            std::make_unique<schema::Descriptor> (descriptorOf (list)),
+            list, "", std::vector<std::string> { }, "list"));
+
+    const std::string constant { PACKAGE + "Constant" };
+
+    for (size_t d { 0 } ; d < m_levels.size() ; ++d) {
+        std::vector<uPtr<schema::Field>> fields;
+
+        for (size_t f { 0 } ; f < m_levels[d].m_fields.size() ; ++f) {
+            auto kind = m_levels[d].m_fields[f];
+
+            fields.emplace_back (field (
+                    "f" + std::to_string (f),
+                    kind == Enum ? constant : TYPES[kind]));
+        }
+
+        if (d + 1 < m_levels.size()) {
+            fields.emplace_back (field ("next", levelName (d + 1)));
+        }
+
+        insert (composite (levelName (d), std::move (fields)));
+    }
+
+    if (enums) {
+        std::vector<uPtr<schema::Choice>> choices;
+
+        for (size_t c { 0 } ; c < m_shape.m_constants ; ++c) {
+            m_constants.emplace_back ("C" + std::to_string (c));
+            choices.emplace_back (std::make_unique<schema::Choice> (m_constants.back()));
+        }
+
+        insert (std::make_unique<schema::Enum> (
+                std::make_unique<schema::Descriptor> (descriptorOf (constant)),
+                constant, "", std::vector<std::string> { }, "list",
+                std::move (choices)));
+
+        m_enum = descriptorOf (constant);
+    }
+
+    /*
+     * Padding refers to the padding before it as a binary tree does its
+     * parent, so there's some depth to order without a chain thousands
+     * of types long
+     */
+    for (size_t i { 0 } ; count < m_shape.m_types ; ++i) {
+        std::vector<uPtr<schema::Field>> fields;
+
+        for (size_t f { 0 } ; f < m_shape.m_fields ; ++f) {
+            fields.emplace_back (field ("p" + std::to_string (f), TYPES[f % 5]));
+        }
+
+        if (i > 0) {
+            fields.emplace_back (field ("parent", paddingName ((i - 1) / 2)));
+        }
+
+        insert (composite (paddingName (i), std::move (fields)));
+    }
+
+    m_root = descriptorOf (PACKAGE + "Root");
+    m_list = descriptorOf (list);
+
+    m_schema = std::make_unique<schema::Schema> (std::move (types));
+    m_serialiser = std::make_unique<amqp::serialiser::Serialiser> (
+            *m_schema, amqp::serialiser::Serialiser::Types::All);
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Schema &
+amqp::internal::serialiser::
+Generator::schema() const {
+    return *m_schema;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::serialiser::
+Generator::descriptor() const {
+    return m_root;
+}
+
+/******************************************************************************/
+
+/**
+ * The values are written straight to the encoder rather than through an
+ * EncodingVisitor, we know the types we made up and with millions of
+ * elements looking each one up again soon adds up
+ */
+void
+amqp::internal::serialiser::
+Generator::level (codec::Encoder & data_, size_t depth_) {
+    const auto & current = m_levels[depth_];
+
+    data_.described();
+    data_.putSymbol (current.m_descriptor);
+    data_.beginList();
+
+    for (auto kind : current.m_fields) {
+        switch (kind) {
+            case Int : {
+                data_.putInt (static_cast<int32_t> (m_random()));
+                break;
+            }
+            case Long : {
+                data_.putLong (
+                        static_cast<int64_t> ((uint64_t { m_random() } << 32) | m_random()));
+                break;
+            }
+            case Double : {
+                data_.putDouble (std::generate_canonical<double, 32> (m_random) * 1e6);
+                break;
+            }
+            case Bool : {
+                data_.putBool (m_random() & 1);
+                break;
+            }
+            case String : {
+                m_string.resize (m_shape.m_stringLength);
+
+                for (auto & c : m_string) {
+                    c = static_cast<char> ('a' + m_random() % 26);
+                }
+
+                data_.putString (m_string);
+                break;
+            }
+            case Enum : {
+                auto ordinal = m_random() % m_constants.size();
+
+                writeEnum (data_, m_enum, m_constants[ordinal], ordinal);
+                break;
+            }
+        }
+    }
+
+    if (depth_ + 1 < m_levels.size()) {
+        level (data_, depth_ + 1);
+    }
+
+    data_.endList();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Generator::write (std::vector<char> & blob_) {
+    m_serialiser->write (m_root, blob_, [this] (codec::Encoder & encoder_) {
+        encoder_.described();
+        encoder_.putSymbol (m_root);
+        encoder_.beginList();
+
+        encoder_.described();
+        encoder_.putSymbol (m_list);
+        encoder_.beginList();
+
+        for (size_t i { 0 } ; i < m_shape.m_length ; ++i) {
+            level (encoder_, 0);
+        }
+
+        encoder_.endList();
+        encoder_.endList();
+    });
+}
+
+/******************************************************************************/
@@ -0,0 +1,126 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "types.h"
+#include "amqp/codec/Encoder.h"
+#include "amqp/schema/Schema.h"
+#include "serialiser/Serialiser.h"
+
+/******************************************************************************/
+
+/**
+ * Makes up blobs of whatever shape we want to test or benchmark against
+ * without needing a JVM to write them.
+ *
+ * Each blob holds a Root with a single list of Level0s, each of which
+ * has a number of primitive, string and enum fields and, until we're
+ * as deep as we were asked for, a Level1 and so on. The schema can be
+ * padded out with types nothing uses, and those refer to each other so
+ * ordering them is work.
+ *
+ *  Root { items : List<Level0> }
+ *  Level0 { f0 ... fn, next : Level1 }
+ *  ...
+ *  LevelD { f0 ... fn }
+ *
+ * Which type each field is comes from the seed, so the same shape and
+ * seed always make the same schema and the same run of blobs.
+ */
+namespace amqp::internal::serialiser {
+
+    struct Shape {
+        /**
+         * Fields per composite, not counting the one nesting the next
+         */
+        size_t m_fields { 8 };
+
+        /**
+         * How many composites deep each list element is
+         */
+        size_t m_depth { 1 };
+
+        /**
+         * Elements in the list at the top
+         */
+        size_t m_length { 1000 };
+
+        /**
+         * Percentage of fields that are strings and enums, the rest
+         * are split between ints, longs, doubles and booleans
+         */
+        unsigned int m_strings { 25 };
+        unsigned int m_enums { 10 };
+
+        size_t m_stringLength { 16 };
+
+        /**
+         * Constants in the enum
+         */
+        size_t m_constants { 8 };
+
+        /**
+         * Pad the schema out with unused types until it holds this many
+         */
+        size_t m_types { 0 };
+
+        unsigned int m_seed { 1 };
+    };
+
+    class Generator {
+        public :
+            enum Kind { Int, Long, Double, Bool, String, Enum };
+
+        private :
+            struct Level {
+                std::string       m_descriptor;
+                std::vector<Kind> m_fields;
+            };
+
+            const Shape m_shape;
+
+            std::mt19937 m_random;
+
+            std::vector<Level>       m_levels;
+            std::vector<std::string> m_constants;
+
+            std::string m_root;
+            std::string m_list;
+            std::string m_enum;
+
+            uPtr<schema::Schema>                  m_schema;
+            uPtr<amqp::serialiser::Serialiser>    m_serialiser;
+
+            /**
+             * Reused for each string so making one up doesn't allocate
+             */
+            std::string m_string;
+
+            void level (codec::Encoder &, size_t depth_);
+
+        public :
+            explicit Generator (const Shape &);
+
+            Generator (const Generator &) = delete;
+            Generator & operator = (const Generator &) = delete;
+
+            const schema::Schema & schema() const;
+
+            /**
+             * Of the Root each blob holds
+             */
+            const std::string & descriptor() const;
+
+            /**
+             * Write the next blob into [blob_], clearing it first
+             */
+            void write (std::vector<char> & blob_);
+    };
+
+}
+
+/******************************************************************************/
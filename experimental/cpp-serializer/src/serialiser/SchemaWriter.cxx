@@ -0,0 +1,219 @@
+#include "SchemaWriter.h"
+
+#include <vector>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "amqp/bind/Binding.h"
+#include "amqp/schema/Field.h"
+#include "amqp/schema/Composite.h"
+#include "amqp/schema/restricted-types/Enum.h"
+#include "amqp/schema/restricted-types/Restricted.h"
+#include "amqp/descriptors/AMQPDescriptorRegistory.h"
+
+/******************************************************************************/
+
+/**
+ * Each of these writes the same fields the matching descriptor's build
+ * reads back, in the same order
+ */
+namespace {
+
+    using namespace amqp::internal;
+
+    void
+    describe (amqp::codec::Encoder & data_, int id_) {
+        data_.described();
+        data_.putULong (DESCRIPTOR_TOP_32BITS | static_cast<uint64_t> (id_));
+    }
+
+    /**
+     * Empty labels and defaults were null to begin with
+     */
+    void
+    nullable (amqp::codec::Encoder & data_, const std::string & value_) {
+        if (value_.empty()) {
+            data_.putNull();
+        } else {
+            data_.putString (value_);
+        }
+    }
+
+    template<typename C>
+    void
+    strings (amqp::codec::Encoder & data_, const C & strings_) {
+        data_.beginList();
+
+        for (const auto & string : strings_) {
+            data_.putString (string);
+        }
+
+        data_.endList();
+    }
+
+    void
+    descriptor (amqp::codec::Encoder & data_, const std::string & descriptor_) {
+        describe (data_, OBJECT_DESCRIPTOR);
+        data_.beginList();
+        data_.putSymbol (descriptor_);
+        data_.putNull();
+        data_.endList();
+    }
+
+    void
+    field (amqp::codec::Encoder & data_, const schema::Field & field_) {
+        describe (data_, FIELD);
+        data_.beginList();
+        data_.putString (field_.name());
+        data_.putString (field_.type());
+        strings (data_, field_.requires());
+        nullable (data_, field_.defaultValue());
+        nullable (data_, field_.label());
+        data_.putBool (field_.mandatory());
+        data_.putBool (field_.multiple());
+        data_.endList();
+    }
+
+    void
+    composite (amqp::codec::Encoder & data_, const schema::Composite & composite_) {
+        describe (data_, COMPOSITE_TYPE);
+        data_.beginList();
+        data_.putString (composite_.name());
+        nullable (data_, composite_.label());
+        strings (data_, composite_.provides());
+        descriptor (data_, composite_.descriptor());
+
+        data_.beginList();
+        for (const auto & f : composite_.fields()) {
+            field (data_, *f);
+        }
+        data_.endList();
+
+        data_.endList();
+    }
+
+    /**
+     * Enums are lists with choices, each choice being the name of a
+     * constant and its ordinal
+     */
+    void
+    restricted (amqp::codec::Encoder & data_, const schema::Restricted & restricted_) {
+        describe (data_, RESTRICTED_TYPE);
+        data_.beginList();
+        data_.putString (restricted_.name());
+        nullable (data_, restricted_.label());
+        strings (data_, restricted_.provides());
+        data_.putString (
+                restricted_.restrictedType() == schema::Restricted::Map ? "map" : "list");
+        descriptor (data_, restricted_.descriptor());
+
+        data_.beginList();
+        if (restricted_.restrictedType() == schema::Restricted::Enum) {
+            const auto & choices = dynamic_cast<const schema::Enum &> (restricted_).choices();
+
+            for (size_t i { 0 } ; i < choices.size() ; ++i) {
+                describe (data_, CHOICE);
+                data_.beginList();
+                data_.putString (choices[i]->choice());
+                data_.putString (std::to_string (i));
+                data_.endList();
+            }
+        }
+        data_.endList();
+
+        data_.endList();
+    }
+
+    /**
+     * The type with [descriptor_] and everything it refers to
+     */
+    std::unordered_set<schema::Symbol>
+    reachable (const schema::Schema & schema_, const std::string & descriptor_) {
+        std::unordered_set<schema::Symbol> reached;
+        std::vector<schema::Symbol> wanted { bind::typeOf (schema_, descriptor_) };
+
+        while (!wanted.empty()) {
+            auto type = wanted.back();
+            wanted.pop_back();
+
+            if (type.primitive() || reached.count (type)) {
+                continue;
+            }
+
+            const auto * notation = schema_.byType (type);
+
+            if (!notation) {
+                throw std::runtime_error ("No type " + type.str() + " in the schema");
+            }
+
+            reached.insert (type);
+            notation->dependencies (wanted);
+        }
+
+        return reached;
+    }
+
+    /**
+     * Everything in [schema_], or just [types_] if we're given them
+     */
+    void
+    types (
+        const schema::Schema & schema_,
+        const std::unordered_set<schema::Symbol> * types_,
+        amqp::codec::Encoder & data_
+    ) {
+        /*
+         * Like the JVM we write the types as a single list inside the
+         * list of the schema's fields
+         */
+        describe (data_, SCHEMA);
+        data_.beginList();
+        data_.beginList();
+
+        for (auto i { schema_.begin() } ; i != schema_.end() ; ++i) {
+            for (const auto & type : *i) {
+                if (types_ && !types_->count (type->id())) {
+                    continue;
+                }
+
+                if (type->type() == schema::AMQPTypeNotation::Composite) {
+                    composite (data_, dynamic_cast<const schema::Composite &> (*type));
+                } else {
+                    restricted (data_, dynamic_cast<const schema::Restricted &> (*type));
+                }
+            }
+        }
+
+        data_.endList();
+        data_.endList();
+
+        describe (data_, TRANSFORM_SCHEMA);
+        data_.beginMap();
+        data_.endMap();
+    }
+
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+writeSchema (
+    const schema::Schema & schema_,
+    const std::string & descriptor_,
+    codec::Encoder & data_
+) {
+    auto reached = reachable (schema_, descriptor_);
+
+    types (schema_, &reached, data_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+writeSchema (const schema::Schema & schema_, codec::Encoder & data_) {
+    types (schema_, nullptr, data_);
+}
+
+/******************************************************************************/
@@ -0,0 +1,35 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+
+#include "amqp/codec/Encoder.h"
+#include "amqp/schema/Schema.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::serialiser {
+
+    /**
+     * Write what follows the object in a blob's envelope, the schema,
+     * holding just the type with [descriptor_] and the types it refers
+     * to, and then an empty transforms schema. That's two values.
+     *
+     * Every type the object refers to must be in [schema_], a lazily
+     * materialising one needs to have been asked for it first.
+     */
+    void writeSchema (
+        const schema::Schema & schema_,
+        const std::string & descriptor_,
+        codec::Encoder & data_);
+
+    /**
+     * As above but with every type in [schema_], whether the object
+     * uses it or not
+     */
+    void writeSchema (const schema::Schema & schema_, codec::Encoder & data_);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,77 @@
+#include "serialiser/Serialiser.h"
+
+#include "SchemaWriter.h"
+
+/******************************************************************************
+ *
+ * amqp::serialiser::Serialiser
+ *
+ ******************************************************************************/
+
+amqp::serialiser::
+Serialiser::Serialiser (
+    const internal::schema::Schema & schema_,
+    Types types_
+) : m_schema (schema_)
+  , m_types (types_)
+  , m_entry (nullptr)
+{
+}
+
+/******************************************************************************/
+
+amqp::serialiser::
+Serialiser::Serialiser (const internal::SchemaCache::Entry & entry_)
+    : m_schema (entry_.schema())
+    , m_types (Types::Reachable)
+    , m_entry (&entry_)
+{
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Schema &
+amqp::serialiser::
+Serialiser::schema() const {
+    return m_schema;
+}
+
+/******************************************************************************/
+
+/**
+ * Sections are never removed so the reference stays good once we've
+ * let go of the lock. A cache entry's schema is walked under the
+ * entry's own lock, other threads may be materialising types into it
+ */
+const std::string &
+amqp::serialiser::
+Serialiser::section (const std::string & descriptor_) const {
+    std::lock_guard<std::mutex> lock (m_lock);
+
+    auto it = m_sections.find (descriptor_);
+
+    if (it != m_sections.end()) {
+        return it->second;
+    }
+
+    auto encode = [&] (const internal::schema::Schema & schema_) {
+        std::vector<char> encoded;
+        codec::Encoder encoder (encoded);
+
+        if (m_types == Types::All) {
+            internal::serialiser::writeSchema (schema_, encoder);
+        } else {
+            internal::serialiser::writeSchema (schema_, descriptor_, encoder);
+        }
+
+        return std::string (encoded.begin(), encoded.end());
+    };
+
+    return m_sections.emplace (
+            descriptor_,
+            m_entry
+                ? m_entry->locked (descriptor_, encode)
+                : encode (m_schema)).first->second;
+}
+
+/******************************************************************************/